@@ -15,6 +15,9 @@ void writeCacheData(FILE* fp, LOGMALLOCLIST* logmalloclist, USERDEFINEDTYPELIST*
     DATA_BLOCK_LIST data_block_list;
     data_block_list.count = 1;
     data_block_list.data = (DATA_BLOCK*)data_block;
+    data_block_list.native_data = 0;
+    data_block_list.stream_data = 0;
+    data_block_list.compress_data = 0;
     protocol2(&xdrs, UDA_PROTOCOL_DATA_BLOCK_LIST, XDR_SEND, &token, logmalloclist, userdefinedtypelist,
               &data_block_list, protocolVersion, log_struct_list, private_flags, malloc_source);
 
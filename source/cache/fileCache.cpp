@@ -5,23 +5,30 @@ Contents of DATA_BLOCK structures written to a local cache
 Date/Time Stamp used to build in automatic obsolescence.
 Unique hash key used to identify cached data using signal/source arguments
 Cache located in directory given by environment variables UDA_CACHE_DIR, UDA_CACHE_TABLE
-Maximum number of cached files prevents ...
-Maximum size ...
-Cache is communal: shared database table
+Maximum number of cached files set when the index is created: UDA_CACHE_MAXRECORDS
+Cache is communal: shared between all client processes on the node
 
-Database table: 7 columns separated by a delimiting character ';'
-Record 1 has table statistics: Record count, dead record count and eof offset.
-The first record has a fixed length of 30 characters with a termination line feed
+Index: a binary hash table, memory mapped by every client process
 
-Columns: (each string is of arbitrary length)
+A fixed length header followed by a power of two number of fixed length slots, addressed by open addressing (linear
+probing within a bounded window) from the SHA1 digest of the signal and source. Slots are never returned to the empty
+state, so a probe stops at the first empty slot. When the window is full the oldest entry is evicted.
 
-unsigned int status
-unsigned int Hash key
-unsigned long long timestamp
-char Filename[]
+Each slot is guarded by a sequence lock held in the slot itself: a writer claims the slot by moving its sequence
+number from even to odd with a compare and swap and releases it with the next even value; readers copy the slot
+without locking and retry if the sequence number changed. Cached data files are written under a temporary name and
+renamed into place, so readers never see a partially written file.
+
+Slot contents:
+
+unsigned int sequence
+unsigned int state      - empty, live or dead
+unsigned char digest[]  - SHA1 of the signal and source
+unsigned long long timestamp (expiry, 0 = never)
+unsigned long long created
 unsigned long long properties
-char signal[]    - cannot contain a ';' character
-char source[]
+
+The cached data file name is derived from the digest.
 */
 
 #include "fileCache.h"
@@ -45,23 +52,29 @@ int udaFileCacheWrite(const DATA_BLOCK* data_block, const REQUEST_BLOCK* request
 #include "cache.h"
 
 #include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <cerrno>
+#include <mutex>
 #include <string>
-#include <vector>
-#include <boost/algorithm/string.hpp>
+#include <thread>
 #include <boost/optional.hpp>
+#include <openssl/sha.h>
 
 #include <clientserver/errorLog.h>
-#include <clientserver/stringUtils.h>
-#include <sstream>
 
-constexpr int CACHE_MAXCOUNT            = 100; // Max Attempts at obtaining a database table lock
+constexpr int CACHE_MAXCOUNT            = 100;      // Max Attempts at obtaining a consistent slot or the index lock
 constexpr int CACHE_HOURSVALID          = 0;
-constexpr int CACHE_MAXDEADRECORDS      = 10;
-constexpr int CACHE_MAXRECORDS          = 1000; // Including comment records
-constexpr int CACHE_STATSLENGTH         = 30;
-constexpr int CACHE_MAXLOCKTIME         = 100;  // Maximum Grace period after time expiry when a file record is locked
+constexpr uint64_t CACHE_MAXRECORDS     = 65536;    // Default number of index slots (rounded up to a power of 2)
+constexpr uint64_t CACHE_PROBEWINDOW    = 32;       // Slots searched for an entry before evicting the oldest
+
+constexpr uint32_t CACHE_INDEXVERSION   = 1;
+constexpr const char CACHE_INDEXMAGIC[] = "UDACIDX";
 
 namespace {
 
@@ -72,49 +85,69 @@ enum class LockActionType : short
     UNLOCK  = F_UNLCK
 };
 
-struct CacheStats
+enum class EntryState : uint32_t {
+    EMPTY = 0,
+    LIVE = 1,
+    DEAD = 2,
+};
+
+struct IndexHeader
 {
-    unsigned long recordCount;
-    unsigned long deadCount;
-    long endOffset;
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_size;
+    uint64_t capacity;
+    char reserved[40];
 };
 
-enum class EntryState {
-    DEAD = 0,
-    LIVE = 1,
-    LOCKED = 2,
+struct IndexSlot
+{
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> state;
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    char reserved[12];
+    uint64_t timestamp;
+    uint64_t created;
+    uint64_t properties;
+};
+
+static_assert(sizeof(IndexHeader) == 64, "cache index header must be 64 bytes");
+static_assert(sizeof(IndexSlot) == 64, "cache index slot must be 64 bytes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "cache index requires lock free atomics");
+
+struct CacheIndex
+{
+    std::string path;
+    IndexSlot* slots = nullptr;
+    uint64_t capacity = 0;
+};
+
+struct CacheKey
+{
+    unsigned char digest[SHA_DIGEST_LENGTH];
 };
 
 struct CacheEntry
 {
-    size_t file_position = 0;
-    EntryState state = EntryState::DEAD;
-    std::string signal;
-    std::string source;
-    std::string filename;
+    uint64_t slot = 0;
+    EntryState state = EntryState::EMPTY;
     unsigned long long timestamp = 0;
+    unsigned long long created = 0;
     unsigned long long properties = 0;
-    unsigned long dbkey = 0;
+    CacheKey key = {};
 };
 
 } // anon namespace
 
-static int set_db_file_lock_state(FILE* db, LockActionType type);
+static int set_db_file_lock_state(int fd, LockActionType type);
 static bool is_cache_time_valid(unsigned long long timestamp);
-static bool is_cache_locked_time_valid(unsigned long long timestamp);
 static bool is_cache_file_valid(const std::string& filename);
-static boost::optional<CacheStats> get_cache_stats(FILE* db);
-static int update_cache_stats(FILE* db, CacheStats stats);
-static boost::optional<CacheStats> purge_cache(FILE* db);
-static boost::optional<CacheEntry> find_cache_entry(const REQUEST_DATA* request);
-static unsigned int xcrc32(const unsigned char* buf, int len, unsigned int init);
-static int set_entry_state(const CacheEntry& entry, EntryState state);
+static CacheIndex* open_cache_index();
+static boost::optional<CacheEntry> find_cache_entry(CacheIndex* index, const CacheKey& key);
+static bool read_slot(const IndexSlot& slot, CacheEntry* entry);
 static std::string get_file_path(const std::string& filename);
 
-constexpr const char* delimiter = ";";
-
-// Cache database table lock/unlock
-// nullptr File handle returned if there is no cache
+// nullptr index returned if there is no cache
 
 std::string get_file_path(const std::string& filename)
 {
@@ -127,76 +160,27 @@ std::string get_file_path(const std::string& filename)
     return std::string{dir} + "/" + filename;
 }
 
-FILE* open_db_file(bool create)
-{
-    // Open the Database Table and apply an Exclusive lock
-    const char* table = getenv("UDA_CACHE_TABLE");  // List of cached files
-    if (table == nullptr) {
-        return nullptr;
-    }
-
-    std::string dbfile = get_file_path(table);
-    if (dbfile.empty()) {
-        return nullptr;
-    }
-
-    // Open the Cache database table
-
-    errno = 0;
-    FILE* fh = fopen(dbfile.c_str(), "r+"); // ASCII file: Read with update (over-write)
-    if (fh == nullptr && create) {
-        errno = 0;
-        fh = fopen(dbfile.c_str(), "w");
-    }
-
-    return fh;
-}
-
-int set_db_file_lock_state(FILE* db, LockActionType type)
+int set_db_file_lock_state(int fd, LockActionType type)
 {
-    int fd = fileno(db);
-
     struct flock lock = {};
     lock.l_whence = SEEK_SET;               // Relative to the start of the file
     lock.l_start = 0;                       // Lock applies from this byte
     lock.l_len = 0;                         // To the end of the file
     lock.l_type = static_cast<short>(type); // Lock type to apply
 
-    int rc = fcntl(fd, F_SETLK, &lock);    // Manage the Cache table lock
+    // The index file is only locked while it is created or validated: wait for the lock
 
-    if (rc == 0) {
-        // Lock managed OK
-        return 0;
-    }
-
-    if (type == LockActionType::UNLOCK) {
-        int err = 999;
-        addIdamError(UDA_CODE_ERROR_TYPE, __func__, err,
-                     "cache file lock not released indicating problem with cache");
-        return err;
-    }
-
-    // Problem obtaing an exclusive file lock - wait for a random time delay and try again
+    int rc;
     int count = 0;
-    do {
-        int delay = 1 + (int)(10.0 * (rand() / (RAND_MAX + 1.0))); // Random delay [1,10]
-
-        timespec requested = {};
-        requested.tv_sec = 0;
-        requested.tv_nsec = 1000 * delay; // Microsecs
+    while ((rc = fcntl(fd, F_SETLKW, &lock)) == -1 && errno == EINTR && count++ < CACHE_MAXCOUNT) {}
 
-        timespec remaining = {};
-        nanosleep(&requested, &remaining);
-        rc = fcntl(fd, F_SETLK, &lock);
-    } while (rc == -1 && count++ < CACHE_MAXCOUNT);
-
-    if (rc == -1 || count >= CACHE_MAXCOUNT) {
+    if (rc == -1) {
         int err = 999;
         addIdamError(UDA_CODE_ERROR_TYPE, __func__, err, "unable to lock the cache database");
         return err;
     }
 
-    return 0;    // Lock obtained
+    return 0;
 }
 
 // Time stamp test
@@ -215,19 +199,6 @@ bool is_cache_time_valid(unsigned long long timestamp)
     return false;
 }
 
-// Check the locked file time is within a reasonable time period - protect against possible bugs in file management
-
-bool is_cache_locked_time_valid(unsigned long long timestamp)
-{
-    timeval current = {};
-    gettimeofday(&current, nullptr);
-    if ((timestamp + CACHE_MAXLOCKTIME) >= (unsigned long long)current.tv_sec) {
-        // Timestamp OK
-        return true;
-    }
-    return false;
-}
-
 // Test the File exists
 
 bool is_cache_file_valid(const std::string& filename)
@@ -236,170 +207,293 @@ bool is_cache_file_valid(const std::string& filename)
     return access(path.c_str(), F_OK) != -1;
 }
 
-// Current table statistics
-
-boost::optional<CacheStats> get_cache_stats(FILE* db)
+/**
+ * Number of index slots for a new index: UDA_CACHE_MAXRECORDS rounded up to a power of 2.
+ */
+uint64_t index_capacity()
 {
-    rewind(db);
-    char buffer[CACHE_STATSLENGTH + 1];
-    if (fgets(buffer, CACHE_STATSLENGTH, db) == nullptr) {
-        fseek(db, 0, SEEK_END);
-        if (ftell(db) == 0) {
-            update_cache_stats(db, {});
-            return CacheStats{};
-        }
-        return {};
+    uint64_t records = CACHE_MAXRECORDS;
+    const char* env = getenv("UDA_CACHE_MAXRECORDS");
+    if (env != nullptr && strtoull(env, nullptr, 10) > 0) {
+        records = strtoull(env, nullptr, 10);
     }
 
-    std::vector<std::string> tokens;
-    boost::split(tokens, buffer, boost::is_any_of(delimiter));
-
-    CacheStats stats = {};
-    stats.recordCount = std::stoul(tokens[0]);
-    stats.deadCount = std::stoul(tokens[1]);
-    stats.endOffset = std::stol(tokens[2]);
-
-    // If there are too many dead records, then compact the database table
-    if (stats.deadCount >= CACHE_MAXDEADRECORDS) {
-        auto maybe_updated_stats = purge_cache(db);
-        if (!maybe_updated_stats) {
-            addIdamError(UDA_CODE_ERROR_TYPE, __func__, 999, "failed to purge cache");
-            return {};
-        }
-        stats = maybe_updated_stats.get();
+    uint64_t capacity = CACHE_PROBEWINDOW;
+    while (capacity < records) {
+        capacity <<= 1u;
     }
+    return capacity;
+}
 
-    return stats;
+bool is_index_header_valid(const IndexHeader& header, off_t file_size)
+{
+    return memcmp(header.magic, CACHE_INDEXMAGIC, sizeof(CACHE_INDEXMAGIC)) == 0
+           && header.version == CACHE_INDEXVERSION
+           && header.slot_size == sizeof(IndexSlot)
+           && header.capacity >= CACHE_PROBEWINDOW
+           && (header.capacity & (header.capacity - 1)) == 0
+           && (uint64_t)file_size == sizeof(IndexHeader) + header.capacity * sizeof(IndexSlot);
 }
 
 /**
- * Update statistics
- * @param db cache file
- * @param stats
- * @return 0 on success, else error code
+ * Create the index in an empty file, or re-create it over an index in an older format (e.g. the text table).
+ * The caller holds the file write lock.
  */
-int update_cache_stats(FILE* db, CacheStats stats)
+int create_index(int fd)
 {
-    std::stringstream ss;
-    ss << stats.recordCount << delimiter << stats.deadCount << delimiter << stats.endOffset;
-
-    std::string stats_line = ss.str();
-
-    size_t size = stats_line.size();
-    if (size < CACHE_STATSLENGTH - 1) {
-        rewind(db);
-        fwrite(stats_line.c_str(), sizeof(char), size, db);
-        for (size_t i = size; i < CACHE_STATSLENGTH - 1; i++) {
-            // Pack remaining record with space chars
-            fputc(' ', db);
-        }
-        fputc('\n', db);
-    } else {
-        UDA_THROW_ERROR(999, "invalid cache stats record");
+    uint64_t capacity = index_capacity();
+
+    errno = 0;
+    if (ftruncate(fd, 0) != 0 || ftruncate(fd, sizeof(IndexHeader) + capacity * sizeof(IndexSlot)) != 0) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "");
+        UDA_THROW_ERROR(999, "unable to size the cache index");
+    }
+
+    IndexHeader header = {};
+    memcpy(header.magic, CACHE_INDEXMAGIC, sizeof(CACHE_INDEXMAGIC));
+    header.version = CACHE_INDEXVERSION;
+    header.slot_size = sizeof(IndexSlot);
+    header.capacity = capacity;
+
+    if (pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+        UDA_THROW_ERROR(999, "unable to write the cache index header");
     }
 
-    fflush(db);
     return 0;
 }
 
 /**
- * Remove dead records to compact the database table
- * @param db
- * @return
+ * Open and map the cache index, creating it if needed. The mapping is shared by all threads of the process and kept
+ * until the cache location changes.
  */
-boost::optional<CacheStats> purge_cache(FILE* db)
+CacheIndex* open_cache_index()
 {
-    // rewind the file to the beginning of the records
-    fseek(db, CACHE_STATSLENGTH, SEEK_SET);
+    static std::mutex mutex;
+    static CacheIndex index = {};
 
-    std::vector<std::pair<unsigned long long, std::string>> table;
+    const char* table = getenv("UDA_CACHE_TABLE");  // Index of cached files
+    if (table == nullptr) {
+        return nullptr;
+    }
 
-    char* line = nullptr;
-    size_t n = 0;
-    while (getline(&line, &n, db) >= 0) {
-        if (line[0] == '#') {
-            // Preserve comments
-            table.emplace_back(std::make_pair(0, line));
-            continue;
+    std::string dbfile = get_file_path(table);
+    if (dbfile.empty()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (index.slots != nullptr && index.path == dbfile) {
+        return &index;
+    }
+
+    if (index.slots != nullptr) {
+        munmap((char*)index.slots - sizeof(IndexHeader), sizeof(IndexHeader) + index.capacity * sizeof(IndexSlot));
+        index = {};
+    }
+
+    errno = 0;
+    int fd = open(dbfile.c_str(), O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    // Validate the header under a read lock: re-create the index under the write lock if it is new or not valid
+
+    IndexHeader header = {};
+    struct stat status = {};
+    bool valid = false;
+
+    for (LockActionType type : { LockActionType::READ, LockActionType::WRITE }) {
+        if (set_db_file_lock_state(fd, type) != 0) {
+            close(fd);
+            return nullptr;
         }
 
-        if (line[0] == '\n') {
-            continue;
+        valid = fstat(fd, &status) == 0
+                && pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)
+                && is_index_header_valid(header, status.st_size);
+
+        if (!valid && type == LockActionType::WRITE) {
+            valid = create_index(fd) == 0 && pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header);
+        }
+
+        set_db_file_lock_state(fd, LockActionType::UNLOCK);
+
+        if (valid) {
+            break;
         }
+    }
 
-        std::vector<std::string> tokens;
-        boost::split(tokens, line, boost::is_any_of(delimiter));
+    if (!valid) {
+        close(fd);
+        return nullptr;
+    }
 
-        unsigned short state = std::stoul(tokens[0]);
-        unsigned long long timestamp = std::stoull(tokens[2]);
-        std::string filename = tokens[3];
+    size_t size = sizeof(IndexHeader) + header.capacity * sizeof(IndexSlot);
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
 
-        if (state == static_cast<int>(EntryState::DEAD)) {
-            std::string cache_file = get_file_path(filename);
-            remove(cache_file.c_str());
+    if (map == MAP_FAILED) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "");
+        addIdamError(UDA_CODE_ERROR_TYPE, __func__, 999, "unable to map the cache index");
+        return nullptr;
+    }
+
+    index.path = dbfile;
+    index.slots = reinterpret_cast<IndexSlot*>((char*)map + sizeof(IndexHeader));
+    index.capacity = header.capacity;
+
+    return &index;
+}
+
+CacheKey generate_hash_key(const REQUEST_DATA* request)
+{
+    // Digest of the signal and source: also names the cached data file
+    std::string text = std::string{ request->signal } + '\0' + request->source;
+    CacheKey key = {};
+    SHA1(reinterpret_cast<const unsigned char*>(text.data()), text.size(), key.digest);
+    return key;
+}
+
+uint64_t slot_index(const CacheKey& key, uint64_t capacity)
+{
+    uint64_t hash;
+    memcpy(&hash, key.digest, sizeof(hash));
+    return hash & (capacity - 1);
+}
+
+/**
+ * Copy a slot without locking: returns false if a writer held or changed the slot during the copy.
+ */
+bool read_slot(const IndexSlot& slot, CacheEntry* entry)
+{
+    for (int count = 0; count < CACHE_MAXCOUNT; ++count) {
+        uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1u) {
             continue;
         }
 
-        table.emplace_back(std::make_pair(timestamp, line));
-    }
+        entry->state = static_cast<EntryState>(slot.state.load(std::memory_order_relaxed));
+        memcpy(entry->key.digest, slot.digest, SHA_DIGEST_LENGTH);
+        entry->timestamp = slot.timestamp;
+        entry->created = slot.created;
+        entry->properties = slot.properties;
 
-    using pair_type = std::pair<unsigned long long, std::string>;
-    std::sort(table.begin(), table.end(), [](const pair_type& a, const pair_type& b){ return a.first < b.first; });
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+            return true;
+        }
+    }
+    return false;
+}
 
-    while (table.size() > CACHE_MAXRECORDS) {
-        std::vector<std::string> tokens;
-        boost::split(tokens, line, boost::is_any_of(delimiter));
+/**
+ * Claim a slot for writing: returns the sequence number to release it with, or 0 if another writer holds it.
+ */
+uint32_t lock_slot(IndexSlot& slot)
+{
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1u) || !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        return 0;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return sequence + 2;
+}
 
-        std::string filename = tokens[3];
-        std::string cache_file = get_file_path(filename);
-        remove(cache_file.c_str());
+void unlock_slot(IndexSlot& slot, uint32_t sequence)
+{
+    slot.sequence.store(sequence, std::memory_order_release);
+}
 
-        table.pop_back();
+// Identify the name of the required cache file
+std::string generate_cache_filename(const CacheKey& key)
+{
+    static const char* hex = "0123456789abcdef";
+    std::string name = "uda_";
+    for (unsigned char byte : key.digest) {
+        name += hex[byte >> 4u];
+        name += hex[byte & 15u];
     }
+    return name + ".cache";
+}
 
-    fseek(db, CACHE_STATSLENGTH, SEEK_SET); // Position at the start of records
+boost::optional<CacheEntry> find_cache_entry(CacheIndex* index, const CacheKey& key)
+{
+    uint64_t start = slot_index(key, index->capacity);
 
-    errno = 0;
-    for (const auto& pair : table) {
-        const auto& record = pair.second;
-        size_t count = fwrite(record.c_str(), sizeof(char), record.size(), db);
-        if (count != record.size() || errno != 0) {
-            addIdamError(UDA_CODE_ERROR_TYPE, __func__, 999, "Failed to write cache record");
-            return {};
+    for (uint64_t i = 0; i < CACHE_PROBEWINDOW; ++i) {
+        uint64_t slot = (start + i) & (index->capacity - 1);
+
+        CacheEntry entry;
+        if (!read_slot(index->slots[slot], &entry)) {
+            continue;
+        }
+
+        if (entry.state == EntryState::EMPTY) {
+            break;
+        }
+
+        if (entry.state == EntryState::LIVE && memcmp(entry.key.digest, key.digest, SHA_DIGEST_LENGTH) == 0) {
+            entry.slot = slot;
+            return entry;
         }
     }
 
-    CacheStats stats = {};
-    stats.endOffset = ftell(db);
-    stats.recordCount = table.size();
-    stats.deadCount = 0;
+    return {};
+}
 
-    update_cache_stats(db, stats);
+/**
+ * Mark the entry dead if the slot still holds it and remove its cached data file.
+ */
+void remove_cache_entry(CacheIndex* index, const CacheEntry& entry)
+{
+    IndexSlot& slot = index->slots[entry.slot];
+
+    uint32_t sequence = lock_slot(slot);
+    if (sequence == 0) {
+        return;
+    }
 
-    return stats;
+    bool same = slot.state.load(std::memory_order_relaxed) == static_cast<uint32_t>(EntryState::LIVE)
+                && memcmp(slot.digest, entry.key.digest, SHA_DIGEST_LENGTH) == 0;
+    if (same) {
+        slot.state.store(static_cast<uint32_t>(EntryState::DEAD), std::memory_order_relaxed);
+    }
+
+    unlock_slot(slot, sequence);
+
+    if (same) {
+        std::string path = get_file_path(generate_cache_filename(entry.key));
+        remove(path.c_str());
+    }
 }
 
 DATA_BLOCK*
 udaFileCacheRead(const REQUEST_DATA* request, LOGMALLOCLIST* logmalloclist, USERDEFINEDTYPELIST* userdefinedtypelist,
                  int protocolVersion, LOGSTRUCTLIST* log_struct_list, unsigned int private_flags, int malloc_source)
 {
-    auto maybe_entry = find_cache_entry(request);
+    CacheIndex* index = open_cache_index();
+    if (index == nullptr) {
+        return nullptr;
+    }
+
+    auto maybe_entry = find_cache_entry(index, generate_hash_key(request));
     if (!maybe_entry) {
         return nullptr;
     }
 
     auto entry = maybe_entry.get();
+    std::string filename = generate_cache_filename(entry.key);
 
-    if (!is_cache_file_valid(entry.filename)
-        || (entry.state == EntryState::LIVE && !is_cache_time_valid(entry.timestamp))
-        || (entry.state == EntryState::LOCKED && !is_cache_locked_time_valid(entry.timestamp))) {
-        set_entry_state(entry, EntryState::DEAD);
+    if (!is_cache_file_valid(filename) || !is_cache_time_valid(entry.timestamp)) {
+        remove_cache_entry(index, entry);
         return nullptr;
-    } else {
-        set_entry_state(entry, EntryState::LOCKED);
     }
 
-    std::string path = get_file_path(entry.filename);
+    std::string path = get_file_path(filename);
+
+    // The file may be replaced or removed by another process: once open, its contents remain readable
 
     errno = 0;
 
@@ -413,206 +507,86 @@ udaFileCacheRead(const REQUEST_DATA* request, LOGMALLOCLIST* logmalloclist, USER
 
     fclose(xdrfile);
 
-    set_entry_state(entry, EntryState::LIVE);
-
     return data_block;
 }
 
-boost::optional<CacheEntry> processLine(const std::string& line, size_t position)
-{
-    if (line[0] == '#' || line[0] == '\n') {
-        return {};
-    }
-
-    std::vector<std::string> tokens;
-    boost::split(tokens, line, boost::is_any_of(delimiter));
-
-    CacheEntry entry;
-    entry.file_position = position;
-
-    int i = 0;
-    for (const auto& token : tokens) {
-        switch (i) {
-            case 0:
-                entry.state = static_cast<EntryState>(std::stoi(token));
-                break;
-            case 1:
-                entry.dbkey = static_cast<unsigned int>(std::stoul(token));
-                break;
-            case 2:
-                entry.timestamp = std::stoull(token);
-                break;
-            case 3:
-                entry.filename = token;
-                break;
-            case 4:
-                entry.properties = std::stoull(token);
-                break;
-            case 5:
-                entry.signal = token;
-                break;
-            case 6:
-                if (!token.empty() && token[token.size() - 1] == '\n') {
-                    entry.source = token.substr(0, token.size() - 1);
-                } else {
-                    entry.source = token;
-                }
-                break;
-            default:
-                break;
-        }
-        if (entry.state == EntryState::DEAD) {
-            // Don't need the remaining information on this record!
-            break;
-        }
-        ++i;
-    }
-
-    return entry;
-}
-
-unsigned int generate_hash_key(const REQUEST_DATA* request)
-{
-    // Generate a Hash Key (not guaranteed unique)
-    unsigned int key = 0;
-    // combine CRC has keys
-    key = xcrc32((const unsigned char*)request->signal, (int)strlen(request->signal), key);
-    key = xcrc32((const unsigned char*)request->source, (int)strlen(request->source), key);
-    return key;
-}
-
-int set_entry_state(const CacheEntry& entry, EntryState state)
+/**
+ * Record the entry in the index: in the first unused, dead or expired slot within the probe window of the key, else
+ * in place of the oldest entry in the window, whose cached data file is removed.
+ */
+int add_cache_record(CacheIndex* index, const CacheKey& key)
 {
-    int rc = 0;
-    FILE* db = open_db_file(false);
-    if (db == nullptr || (rc = set_db_file_lock_state(db, LockActionType::WRITE)) != 0) {
-        return rc;
-    }
-
-    fseek(db, entry.file_position, SEEK_SET);
-    char buffer[3];
-    snprintf(buffer, 3, "%d%c", static_cast<int>(state), delimiter[0]);
-    fwrite(buffer, sizeof(char), 2, db);
-
-    rc = set_db_file_lock_state(db, LockActionType::UNLOCK);    // release lock
-    fclose(db);
-
-    return rc;
-}
+    // Generate a timestamp
+    timeval current = {};
+    gettimeofday(&current, nullptr);
 
-// Identify the name of the required cache file
-boost::optional<CacheEntry> find_cache_entry(const REQUEST_DATA* request)
-{
-    // Lock the database
-    FILE* db = open_db_file(false);
-    if (db == nullptr || set_db_file_lock_state(db, LockActionType::READ) != 0) {
-        return {};
+    unsigned long long timestamp = 0;
+    if (CACHE_HOURSVALID != 0) {
+        timestamp = (unsigned long long)current.tv_sec + CACHE_HOURSVALID * 3600 + 60;
     }
 
-    unsigned int key = generate_hash_key(request);
+    uint64_t start = slot_index(key, index->capacity);
 
-    fseek(db, CACHE_STATSLENGTH, SEEK_SET);    // Position at the start of record 2
+    for (int count = 0; count < CACHE_MAXCOUNT; ++count) {
+        boost::optional<CacheEntry> target;
+        boost::optional<CacheEntry> oldest;
 
-    boost::optional<CacheEntry> found_entry;
+        for (uint64_t i = 0; i < CACHE_PROBEWINDOW && !target; ++i) {
+            CacheEntry entry;
+            entry.slot = (start + i) & (index->capacity - 1);
+            if (!read_slot(index->slots[entry.slot], &entry)) {
+                continue;
+            }
 
-    char* line = nullptr;
-    size_t n = 0;
-    size_t position = CACHE_STATSLENGTH;
-    size_t len;
-    while ((len = getline(&line, &n, db)) != static_cast<size_t>(-1)) {
-        auto maybe_entry = processLine(line, position);
-        position += len;
-        if (!maybe_entry) {
-            continue;
+            if (entry.state != EntryState::LIVE || !is_cache_time_valid(entry.timestamp)
+                    || memcmp(entry.key.digest, key.digest, SHA_DIGEST_LENGTH) == 0) {
+                target = entry;
+            } else if (!oldest || entry.created < oldest->created) {
+                oldest = entry;
+            }
         }
 
-        auto& entry = maybe_entry.get();
-        if (entry.state == EntryState::DEAD) {
+        if (!target) {
+            target = oldest;
+        }
+        if (!target) {
             continue;
         }
 
-        if (key == entry.dbkey
-            && (entry.signal == request->signal && entry.source == request->source)) {
-            found_entry = entry;
-            break;
+        IndexSlot& slot = index->slots[target->slot];
+        uint32_t sequence = lock_slot(slot);
+        if (sequence == 0) {
+            continue;
         }
-    }
-
-    free(line);
-    set_db_file_lock_state(db, LockActionType::UNLOCK);
-    fclose(db);
-
-    return found_entry;
-}
-
-int add_cache_record(const REQUEST_DATA* request, const char* filename)
-{
-    // Generate a Hash Key (not guaranteed unique)
-    unsigned int key = 0;
-    // combine CRC has keys
-    key = xcrc32((const unsigned char*)request->signal, (int)strlen(request->signal), key);
-    key = xcrc32((const unsigned char*)request->source, (int)strlen(request->source), key);
-
-    // Generate a timestamp
-    unsigned long long timestamp = 0;
-    if (CACHE_HOURSVALID != 0) {
-        timeval current = {};
-        gettimeofday(&current, nullptr);
-        timestamp = (unsigned long long)current.tv_sec + CACHE_HOURSVALID * 3600 + 60;
-    }
 
-    // Create the new record string
-    std::stringstream ss;
-    constexpr int properties = 0;
-    ss << static_cast<int>(EntryState::LIVE) << delimiter
-       << key << delimiter
-       << timestamp << delimiter
-       << filename << delimiter
-       << properties << delimiter
-       << request->signal << delimiter
-       << request->source << '\n';
-    std::string record = ss.str();
+        // The slot may have changed since it was chosen: choose again
 
-    // Append the new record to the database table
-    int rc = 0;
-    FILE* db = open_db_file(true);
-    if (db == nullptr || (rc = set_db_file_lock_state(db, LockActionType::WRITE)) != 0) {
-        UDA_THROW_ERROR(rc, "unable to get lock cache file");
-    }
+        if (slot.state.load(std::memory_order_relaxed) != static_cast<uint32_t>(target->state)
+                || memcmp(slot.digest, target->key.digest, SHA_DIGEST_LENGTH) != 0) {
+            unlock_slot(slot, sequence);
+            continue;
+        }
 
-    // Current table statistics
-    auto maybe_stats = get_cache_stats(db);
-    if (!maybe_stats) {
-        rc = set_db_file_lock_state(db, LockActionType::UNLOCK);    // Free the Lock and File
-        UDA_THROW_ERROR(rc, "unable to get cache stats");
-    }
-    CacheStats stats = maybe_stats.get();
+        bool evicted = target->state == EntryState::LIVE
+                       && memcmp(target->key.digest, key.digest, SHA_DIGEST_LENGTH) != 0;
 
-    // Append a new record at the file position (always the end of the valid set of records)
-    if (stats.endOffset == 0) {
-        fseek(db, 0, SEEK_END);
-        stats.endOffset = ftell(db);
-    }
+        memcpy(slot.digest, key.digest, SHA_DIGEST_LENGTH);
+        slot.timestamp = timestamp;
+        slot.created = (uint64_t)current.tv_sec;
+        slot.properties = 0;
+        slot.state.store(static_cast<uint32_t>(EntryState::LIVE), std::memory_order_relaxed);
 
-    fseek(db, stats.endOffset, SEEK_SET);
-    fwrite(record.c_str(), sizeof(char), record.size(), db);
-    stats.endOffset = ftell(db);
+        unlock_slot(slot, sequence);
 
-    fflush(db);
-    stats.recordCount++;
+        if (evicted) {
+            std::string path = get_file_path(generate_cache_filename(target->key));
+            remove(path.c_str());
+        }
 
-    rc = update_cache_stats(db, stats);
-    if (rc != 0) {
-        UDA_THROW_ERROR(rc, "unable to update cache stats");
+        return 0;
     }
 
-    return set_db_file_lock_state(db, LockActionType::UNLOCK);
-}
-
-std::string generate_cache_filename(const REQUEST_DATA* request)
-{
-    unsigned int key = generate_hash_key(request);
-    return std::string{"uda_"} + std::to_string(key) + ".cache";
+    UDA_THROW_ERROR(999, "unable to find a free cache index slot");
 }
 
 int udaFileCacheWrite(const DATA_BLOCK* data_block, const REQUEST_BLOCK* request_block, LOGMALLOCLIST* logmalloclist,
@@ -621,18 +595,29 @@ int udaFileCacheWrite(const DATA_BLOCK* data_block, const REQUEST_BLOCK* request
 {
     REQUEST_DATA* request = &request_block->requests[0];
 
-    auto maybe_entry = find_cache_entry(request);
-    if (maybe_entry) {
+    CacheIndex* index = open_cache_index();
+    if (index == nullptr) {
+        return 0;
+    }
+
+    CacheKey key = generate_hash_key(request);
+
+    auto maybe_entry = find_cache_entry(index, key);
+    if (maybe_entry && is_cache_file_valid(generate_cache_filename(key))) {
         // Entry already exists, do not add another
         return 0;
     }
 
-    std::string filename = generate_cache_filename(request);
-    std::string path = get_file_path(filename);
+    // Write under a temporary name and rename into place so that readers only see complete files. The name is unique
+    // to the writing thread: threads of the same process may write the same entry at the same time
+
+    std::string path = get_file_path(generate_cache_filename(key));
+    std::string tmp_path = path + "." + std::to_string(getpid()) + "."
+                           + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
 
     FILE* xdrfile;
     errno = 0;
-    if ((xdrfile = fopen(path.c_str(), "wb")) == nullptr || errno != 0) {
+    if ((xdrfile = fopen(tmp_path.c_str(), "wb")) == nullptr || errno != 0) {
         UDA_THROW_ERROR(0, "unable to create the Cached Data File");
     }
 
@@ -641,7 +626,12 @@ int udaFileCacheWrite(const DATA_BLOCK* data_block, const REQUEST_BLOCK* request
 
     fclose(xdrfile);
 
-    int rc = add_cache_record(request, filename.c_str());
+    if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+        remove(tmp_path.c_str());
+        UDA_THROW_ERROR(0, "unable to create the Cached Data File");
+    }
+
+    int rc = add_cache_record(index, key);
     if (rc != 0) {
         UDA_THROW_ERROR(rc, "unable to add cache record");
     }
@@ -653,209 +643,24 @@ int udaFileCacheWrite(const DATA_BLOCK* data_block, const REQUEST_BLOCK* request
 //=========================================================================================
 // Test the cache
 
-   lock the cache database using fcntl (wait with random delay until lock is free if locked)
-   query the table for the required data
+   map the cache index (created, or re-created over an older format, under an fcntl write lock)
+   probe the slots of the key's window, copying each under its sequence lock, until the key or an empty slot
 
    if the data is available from the cache
-        test the timestamp
-    if timestamp OK
+        test the timestamp and the cached file
+    if OK
         read the data
-        free the lock
     else
-        remove database entry
+        mark the slot dead
         remove cached file
-        free the lock
         access the original data source
    else
-    free the lock
     access the original data source
 
    if new data accessed
-       lock the cache database
-    add new record
-    write new cache file
-    free the lock
+       write new cache file under a temporary name and rename it
+    claim a free, dead, expired or (oldest) live slot in the window and record the key
+    remove the evicted entry's cached file
 */
 
-//=========================================================================================
-/* crc32.c
-   Copyright (C) 2009, 2011 Free Software Foundation, Inc.
-
-   This file is part of the libiberty library.
-
-   This file is free software; you can redistribute it and/or modify
-   it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2 of the License, or
-   (at your option) any later version.
-
-   In addition to the permissions in the GNU General Public License, the
-   Free Software Foundation gives you unlimited permission to link the
-   compiled version of this file into combinations with other programs,
-   and to distribute those combinations without any restriction coming
-   from the use of this file.  (The General Public License restrictions
-   do apply in other respects; for example, they cover modification of
-   the file, and distribution when not linked into a combined
-   executable.)
-
-   This program is distributed in the hope that it will be useful,
-   but WITHOUT ANY WARRANTY; without even the implied warranty of
-   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-   GNU General Public License for more details.
-
-   You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston, MA 02110-1301, USA.
-*/
-
-//#ifdef HAVE_CONFIG_H
-//#include "Config.h"
-//#endif
-
-// #include "libiberty.h"
-
-/* This table was generated by the following program.  This matches
-   what gdb does.
-
-   #include <cstdio>
-
-   int
-   main ()
-   {
-     unsigned int c;
-     int table[256];
-
-     for (int i = 0; i < 256; i++)
-       {
-     for (c = i << 24, j = 8; j > 0; --j)
-       c = c & 0x80000000 ? (c << 1) ^ 0x04c11db7 : (c << 1);
-     table[i] = c;
-       }
-
-     printf ("static const unsigned int crc32_table[] =\n{\n");
-     for (int i = 0; i < 256; i += 4)
-       {
-     printf ("  0x%08x, 0x%08x, 0x%08x, 0x%08x",
-         table[i + 0], table[i + 1], table[i + 2], table[i + 3]);
-     if (i + 4 < 256)
-       putchar (',');
-     putchar ('\n');
-       }
-     printf ("};\n");
-     return 0;
-   }
-
-   For more information on CRC, see, e.g.,
-   http://www.ross.net/crc/download/crc_v3.txt.  */
-
-static const unsigned int crc32_table[] =
-        {
-                0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9,
-                0x130476dc, 0x17c56b6b, 0x1a864db2, 0x1e475005,
-                0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61,
-                0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd,
-                0x4c11db70, 0x48d0c6c7, 0x4593e01e, 0x4152fda9,
-                0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
-                0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011,
-                0x791d4014, 0x7ddc5da3, 0x709f7b7a, 0x745e66cd,
-                0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039,
-                0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5,
-                0xbe2b5b58, 0xbaea46ef, 0xb7a96036, 0xb3687d81,
-                0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
-                0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49,
-                0xc7361b4c, 0xc3f706fb, 0xceb42022, 0xca753d95,
-                0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1,
-                0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d,
-                0x34867077, 0x30476dc0, 0x3d044b19, 0x39c556ae,
-                0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
-                0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16,
-                0x018aeb13, 0x054bf6a4, 0x0808d07d, 0x0cc9cdca,
-                0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde,
-                0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02,
-                0x5e9f46bf, 0x5a5e5b08, 0x571d7dd1, 0x53dc6066,
-                0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
-                0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e,
-                0xbfa1b04b, 0xbb60adfc, 0xb6238b25, 0xb2e29692,
-                0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6,
-                0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a,
-                0xe0b41de7, 0xe4750050, 0xe9362689, 0xedf73b3e,
-                0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
-                0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686,
-                0xd5b88683, 0xd1799b34, 0xdc3abded, 0xd8fba05a,
-                0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637,
-                0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb,
-                0x4f040d56, 0x4bc510e1, 0x46863638, 0x42472b8f,
-                0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
-                0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47,
-                0x36194d42, 0x32d850f5, 0x3f9b762c, 0x3b5a6b9b,
-                0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff,
-                0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623,
-                0xf12f560e, 0xf5ee4bb9, 0xf8ad6d60, 0xfc6c70d7,
-                0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
-                0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f,
-                0xc423cd6a, 0xc0e2d0dd, 0xcda1f604, 0xc960ebb3,
-                0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7,
-                0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b,
-                0x9b3660c6, 0x9ff77d71, 0x92b45ba8, 0x9675461f,
-                0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
-                0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640,
-                0x4e8ee645, 0x4a4ffbf2, 0x470cdd2b, 0x43cdc09c,
-                0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8,
-                0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24,
-                0x119b4be9, 0x155a565e, 0x18197087, 0x1cd86d30,
-                0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
-                0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088,
-                0x2497d08d, 0x2056cd3a, 0x2d15ebe3, 0x29d4f654,
-                0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0,
-                0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c,
-                0xe3a1cbc1, 0xe760d676, 0xea23f0af, 0xeee2ed18,
-                0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
-                0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0,
-                0x9abc8bd5, 0x9e7d9662, 0x933eb0bb, 0x97ffad0c,
-                0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668,
-                0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
-        };
-
-/*
-
-@deftypefn Extension {unsigned int} crc32 (const unsigned char *@var{buf}, @
-  int @var{len}, unsigned int @var{init})
-
-Compute the 32-bit CRC of @var{buf} which has length @var{len}.  The
-starting value is @var{init}; this may be used to compute the CRC of
-data split across multiple buffers by passing the return value of each
-call as the @var{init} parameter of the next.
-
-This is intended to match the CRC used by the @command{gdb} remote
-protocol for the @samp{qCRC} command.  In order to get the same
-results as gdb for a block of data, you must pass the first CRC
-parameter as @code{0xffffffff}.
-
-This CRC can be specified as:
-
-  Width  : 32
-  Poly   : 0x04c11db7
-  Init   : parameter, typically 0xffffffff
-  RefIn  : false
-  RefOut : false
-  XorOut : 0
-
-This differs from the "standard" CRC-32 algorithm in that the values
-are not reflected, and there is no final XOR value.  These differences
-make it easy to compose the values of multiple blocks.
-
-@end deftypefn
-
-*/
-
-unsigned int
-xcrc32(const unsigned char* buf, int len, unsigned int init)
-{
-    unsigned int crc = init;
-    while (len--) {
-        crc = (crc << 8u) ^ crc32_table[((crc >> 24u) ^ *buf) & 255u];
-        buf++;
-    }
-    return crc;
-}
-
 #endif // _WIN32
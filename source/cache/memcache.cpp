@@ -1,10 +1,69 @@
 #include "memcache.hpp"
 
 #include <fmt/format.h>
+#include <openssl/sha.h>
 #include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <sstream>
 
 #include "cache.h"
 
+#define MAX_ELEMENT_SHA1 20
+
+/**
+ * Use the requested signal and source with client specified properties to create a unique key.
+ *
+ * All parameters that may effect the data state, e.g. flags, host, port, properties, etc. must be included in the key.
+ *
+ * There is a 250 character limit - use SHA1 hash if it exceeds 250. The local cache should only be used to record data
+ * returned from a server after a GET method - Note: Put methods may be disguised in a GET call!
+ */
+std::string
+uda::cache::generate_cache_key(const REQUEST_DATA* request, ENVIRONMENT environment, uint32_t flags, unsigned int private_flags)
+{
+    // Check Properties for permission and requested method
+    if (!(flags & CLIENTFLAG_CACHE)) {
+        return {};
+    }
+
+    const char* delimiter = "&&";
+    std::stringstream ss;
+    ss << request->signal << delimiter
+       << request->source << delimiter
+       << environment.server_host << delimiter
+       << environment.server_port << delimiter
+       << flags << delimiter
+       << private_flags;
+
+    auto key = ss.str();
+    std::transform(key.begin(), key.end(), key.begin(), [](const decltype(key)::value_type c) {
+        if (std::isspace(c)) {
+            return '_';
+        }
+        return static_cast<decltype(key)::value_type>(std::tolower(c));
+    });
+
+    if (key.length() < 250) {
+        return key;
+    }
+
+    // Need a compact hash - use SHA1 as always 20 bytes (40 bytes when printable)
+    unsigned char hash[MAX_ELEMENT_SHA1 + 1];
+    memset(hash, ' ', MAX_ELEMENT_SHA1);
+    hash[MAX_ELEMENT_SHA1] = '\0';
+    SHA1(reinterpret_cast<const unsigned char*>(key.data()), key.length(), hash);
+
+    // Convert to a printable string (40 characters) for the key (is this necessary?)
+    std::string hash_key;
+    hash_key.reserve(40);
+    for (int i = 0; i < 20; i++) {
+        hash_key += fmt::format("{:2.2x}", hash[i]);
+    }
+
+    return hash_key;
+}
+
 #ifdef NOLIBMEMCACHED
 
 namespace uda {
@@ -53,8 +112,6 @@ DATA_BLOCK* uda::cache::cache_read(uda::cache::UdaCache* cache, const REQUEST_DA
 #define UDA_CACHE_PORT     11211
 #define UDA_CACHE_EXPIRY   86400           //24*3600       // Lifetime of the object in Secs
 
-#define MAX_ELEMENT_SHA1 20
-
 namespace uda {
 namespace cache {
 
@@ -69,59 +126,6 @@ namespace {
 
 static uda::cache::UdaCache* global_cache = nullptr;    // scope limited to this code module
 
-/**
- * Use the requested signal and source with client specified properties to create a unique key.
- *
- * All parameters that may effect the data state, e.g. flags, host, port, properties, etc. must be included in the key.
- *
- * There is a 250 character limit - use SHA1 hash if it exceeds 250. The local cache should only be used to record data
- * returned from a server after a GET method - Note: Put methods may be disguised in a GET call!
- */
-std::string
-generate_cache_key(const REQUEST_DATA* request, ENVIRONMENT environment, uint32_t flags, unsigned int private_flags)
-{
-    // Check Properties for permission and requested method
-    if (!(flags & CLIENTFLAG_CACHE)) {
-        return {};
-    }
-
-    const char* delimiter = "&&";
-    std::stringstream ss;
-    ss << request->signal << delimiter
-       << request->source << delimiter
-       << environment.server_host << delimiter
-       << environment.server_port << delimiter
-       << flags << delimiter
-       << private_flags;
-
-    auto key = ss.str();
-    std::transform(key.begin(), key.end(), key.begin(), [](const decltype(key)::value_type c) {
-        if (std::isspace(c)) {
-            return '_';
-        }
-        return static_cast<decltype(key)::value_type>(std::tolower(c));
-    });
-
-    if (key.length() < 250) {
-        return key;
-    }
-
-    // Need a compact hash - use SHA1 as always 20 bytes (40 bytes when printable)
-    unsigned char hash[MAX_ELEMENT_SHA1 + 1];
-    memset(hash, ' ', MAX_ELEMENT_SHA1);
-    hash[MAX_ELEMENT_SHA1] = '\0';
-    SHA1(reinterpret_cast<const unsigned char*>(key.data()), key.length(), hash);
-
-    // Convert to a printable string (40 characters) for the key (is this necessary?)
-    std::string hash_key;
-    hash_key.reserve(40);
-    for (int i = 0; i < 20; i++) {
-        hash_key += fmt::format("{:2.2x}", hash[i]);
-    }
-
-    return hash_key;
-}
-
 int memcache_put(uda::cache::UdaCache* cache, const char* key, const char* buffer, size_t bufsize)
 {
     // Expiration of the object
@@ -1,6 +1,8 @@
 #ifndef UDA_CACHE_MEMCACHE_H
 #define UDA_CACHE_MEMCACHE_H
 
+#include <string>
+
 #include <clientserver/udaStructs.h>
 #include <structures/genStructs.h>
 #include <clientserver/export.h>
@@ -12,6 +14,9 @@ struct UdaCache;
 
 UdaCache* open_cache();
 
+std::string generate_cache_key(const REQUEST_DATA* request, ENVIRONMENT environment, uint32_t flags,
+                               unsigned int private_flags);
+
 void free_cache();
 
 int cache_write(uda::cache::UdaCache* cache, const REQUEST_DATA* request_data, DATA_BLOCK* data_block,
@@ -864,6 +864,17 @@ int getIdamLastHandle(CLIENT_FLAGS* client_flags)
 int getIdamDataNum(int handle)
 {
     // Data Array Size
+    if (handle < 0 || (unsigned int)handle >= data_blocks.size()) return 0;
+    return (int)data_blocks[handle].data_n;
+}
+
+//!  returns the number of data items in the data object as a 64 bit count
+/** the number of array elements, for arrays that may exceed INT_MAX elements
+\param   handle   The data object handle
+\return  the number of data items
+*/
+int64_t getIdamDataNum64(int handle)
+{
     if (handle < 0 || (unsigned int)handle >= data_blocks.size()) return 0;
     return data_blocks[handle].data_n;
 }
@@ -912,6 +923,18 @@ unsigned int getIdamCachePermission(int handle)
  * @return byte count
  */
 unsigned int getIdamTotalDataBlockSize(int handle)
+{
+    if (handle < 0 || (unsigned int)handle >= data_blocks.size()) return 0;
+    return (unsigned int)data_blocks[handle].totalDataBlockSize;
+}
+
+/**
+ * Returns the total amount of data (bytes) as a 64 bit count
+ *
+ * @param handle The data object handle
+ * @return byte count
+ */
+uint64_t getIdamTotalDataBlockSize64(int handle)
 {
     if (handle < 0 || (unsigned int)handle >= data_blocks.size()) return 0;
     return data_blocks[handle].totalDataBlockSize;
@@ -2152,6 +2175,21 @@ void getIdamDataDescTdi(int handle, char* desc)
 \return  the dimension size
 */
 int getIdamDimNum(int handle, int ndim)
+{
+    if (handle < 0 || (unsigned int)handle >= data_blocks.size() || ndim < 0 ||
+        (unsigned int)ndim >= data_blocks[handle].rank) {
+        return 0;
+    }
+    return (int)data_blocks[handle].dims[ndim].dim_n;
+}
+
+//! Returns the coordinate dimension size as a 64 bit count
+/** the number of elements in the coordinate array, for arrays that may exceed INT_MAX elements
+\param   handle   The data object handle
+\param   ndim    the position of the dimension in the data array - numbering is as data[0][1][2]
+\return  the dimension size
+*/
+int64_t getIdamDimNum64(int handle, int ndim)
 {
     if (handle < 0 || (unsigned int)handle >= data_blocks.size() || ndim < 0 ||
         (unsigned int)ndim >= data_blocks[handle].rank) {
@@ -3287,6 +3325,9 @@ void getIdamClientSerialisedDataBlock(int handle, void** object, size_t* objectS
     DATA_BLOCK_LIST data_block_list;
     data_block_list.count = 1;
     data_block_list.data = getIdamDataBlock(handle);
+    data_block_list.native_data = 0;
+    data_block_list.stream_data = 0;
+    data_block_list.compress_data = 0;
     protocol2(&xdrs, UDA_PROTOCOL_DATA_BLOCK_LIST, XDR_SEND, &token, logmalloclist, userdefinedtypelist,
               &data_block_list, protocolVersion, log_struct_list, private_flags, malloc_source);
 
@@ -86,6 +86,7 @@ LIBRARY_API int getIdamDataStatus(int handle);
 LIBRARY_API int getIdamLastHandle(CLIENT_FLAGS* client_flags);
 
 LIBRARY_API int getIdamDataNum(int handle);
+LIBRARY_API int64_t getIdamDataNum64(int handle);
 
 LIBRARY_API int getIdamRank(int handle);
 
@@ -94,6 +95,7 @@ LIBRARY_API int getIdamOrder(int handle);
 LIBRARY_API unsigned int getIdamCachePermission(int handle);
 
 LIBRARY_API unsigned int getIdamTotalDataBlockSize(int handle);
+LIBRARY_API uint64_t getIdamTotalDataBlockSize64(int handle);
 
 LIBRARY_API int getIdamDataType(int handle);
 
@@ -186,6 +188,7 @@ LIBRARY_API const char* getIdamDataDesc(int handle);
 LIBRARY_API void getIdamDataDescTdi(int handle, char* desc);
 
 LIBRARY_API int getIdamDimNum(int handle, int ndim);
+LIBRARY_API int64_t getIdamDimNum64(int handle, int ndim);
 
 LIBRARY_API int getIdamDimType(int handle, int ndim);
 
@@ -39,9 +39,9 @@
 //------------------------------------------------ Static Globals ------------------------------------------------------
 
 #if !defined(FATCLIENT) || !defined(NOLIBMEMCACHED)
-static int protocol_version = 9;
+static int protocol_version = 10;
 #endif
-int client_version = 9;          // previous version
+int client_version = 10;         // Client library version, sent to the server in the client block
 
 //----------------------------------------------------------------------------------------------------------------------
 // FATCLIENT objects shared with server code
@@ -92,6 +92,11 @@ void updateClientBlock(CLIENT_BLOCK* str, const CLIENT_FLAGS* client_flags, unsi
 
     str->timeout = client_flags->user_timeout;
     str->clientFlags = client_flags->flags;
+#ifndef FATCLIENT
+    if (littleEndianHost()) {
+        str->clientFlags |= CLIENTFLAG_NATIVEDATA;          // Same byte order as the wire: no array conversion
+    }
+#endif
     str->altRank = client_flags->alt_rank;
     str->get_datadble = client_flags->get_datadble;
     str->get_dimdble = client_flags->get_dimdble;
@@ -119,8 +124,8 @@ int check_file_cache(const REQUEST_DATA* request_data, DATA_BLOCK** p_data_block
                      CLIENT_FLAGS* client_flags, unsigned int private_flags, int malloc_source)
 {
     if (client_flags->flags & CLIENTFLAG_FILECACHE && !request_data->put) {
-        // Query the cache for the Data
-        DATA_BLOCK* data = udaFileCacheRead(request_data, log_malloc_list, user_defined_type_list, protocol_version,
+        // Query the cache for the Data: cached data are always encoded with this client's protocol version
+        DATA_BLOCK* data = udaFileCacheRead(request_data, log_malloc_list, user_defined_type_list, client_version,
                                             log_struct_list, private_flags, malloc_source);
 
         if (data != nullptr) {
@@ -158,7 +163,7 @@ int check_mem_cache(uda::cache::UdaCache* cache, REQUEST_DATA* request_data, DAT
 
         // Query the cache for the Data
         DATA_BLOCK* data = cache_read(cache, request_data, log_malloc_list, user_defined_type_list,
-                                      *getIdamClientEnvironment(), protocol_version, client_flags->flags,
+                                      *getIdamClientEnvironment(), client_version, client_flags->flags,
                                       log_struct_list, private_flags, malloc_source);
 
         if (data != nullptr) {
@@ -969,7 +974,7 @@ int idamClient(REQUEST_BLOCK* request_block, int* indices)
             //------------------------------------------------------------------------------
             // Cache the data if the server has passed permission and the application (client) has enabled caching
             if (client_flags->flags & CLIENTFLAG_FILECACHE) {
-                udaFileCacheWrite(data_block, request_block, g_log_malloc_list, g_user_defined_type_list, protocol_version,
+                udaFileCacheWrite(data_block, request_block, g_log_malloc_list, g_user_defined_type_list, client_version,
                                   &log_struct_list, *private_flags, malloc_source);
             }
 
@@ -981,7 +986,7 @@ int idamClient(REQUEST_BLOCK* request_block, int* indices)
             if (cache != nullptr && client_flags->flags & CLIENTFLAG_CACHE) {
 #    endif
                 cache_write(cache, &request_block->requests[i], data_block, g_log_malloc_list, g_user_defined_type_list,
-                            *environment, protocol_version, client_flags->flags, &log_struct_list,
+                            *environment, client_version, client_flags->flags, &log_struct_list,
                             *private_flags, malloc_source);
             }
 #  endif // !NOLIBMEMCACHED
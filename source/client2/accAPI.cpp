@@ -56,6 +56,21 @@ int udaGetNewDataHandle()
     return instance.new_handle();
 }
 
+//! Select a client per thread
+/** By default all threads share one client, so their requests are served one at a time over one connection. With a
+* client per thread each thread has its own connection and data handles and may fetch data concurrently with the others.
+* A handle is then only valid on the thread that obtained it. Properties (udaSetProperty) and the server (udaPutServer)
+* are also per thread: each thread starts from the environment and must make its own settings. Overrides the
+* UDA_CLIENT_PER_THREAD environment variable and should be called before the first request.
+*
+* @param per_thread 1 for a client per thread, 0 for the single shared client.
+* @return Void.
+*/
+void udaSetClientPerThread(int per_thread)
+{
+    uda::client::ThreadClient::set_per_thread(per_thread != 0);
+}
+
 //--------------------------------------------------------------
 /* Notes:
 
@@ -535,6 +550,22 @@ int udaGetDataNum(int handle)
     auto data_block = instance.data_block(handle);
 
     // Data Array Size
+    if (data_block == nullptr) {
+        return 0;
+    }
+    return (int)data_block->data_n;
+}
+
+//!  returns the number of data items in the data object as a 64 bit count
+/** the number of array elements, for arrays that may exceed INT_MAX elements
+\param   handle   The data object handle
+\return  the number of data items
+*/
+int64_t udaGetDataNum64(int handle)
+{
+    auto& instance = uda::client::ThreadClient::instance();
+    auto data_block = instance.data_block(handle);
+
     if (data_block == nullptr) {
         return 0;
     }
@@ -604,6 +635,23 @@ unsigned int udaGetTotalDataBlockSize(int handle)
     auto& instance = uda::client::ThreadClient::instance();
     auto data_block = instance.data_block(handle);
 
+    if (data_block == nullptr) {
+        return 0;
+    }
+    return (unsigned int)data_block->totalDataBlockSize;
+}
+
+/**
+ * Returns the total amount of data (bytes) as a 64 bit count
+ *
+ * @param handle The data object handle
+ * @return byte count
+ */
+uint64_t udaGetTotalDataBlockSize64(int handle)
+{
+    auto& instance = uda::client::ThreadClient::instance();
+    auto data_block = instance.data_block(handle);
+
     if (data_block == nullptr) {
         return 0;
     }
@@ -2001,6 +2049,24 @@ int udaGetDimNum(int handle, int ndim)
     auto& instance = uda::client::ThreadClient::instance();
     auto data_block = instance.data_block(handle);
 
+    if (data_block == nullptr || ndim < 0 ||
+        (unsigned int)ndim >= data_block->rank) {
+        return 0;
+    }
+    return (int)data_block->dims[ndim].dim_n;
+}
+
+//! Returns the coordinate dimension size as a 64 bit count
+/** the number of elements in the coordinate array, for arrays that may exceed INT_MAX elements
+\param   handle   The data object handle
+\param   ndim    the position of the dimension in the data array - numbering is as data[0][1][2]
+\return  the dimension size
+*/
+int64_t udaGetDimNum64(int handle, int ndim)
+{
+    auto& instance = uda::client::ThreadClient::instance();
+    auto data_block = instance.data_block(handle);
+
     if (data_block == nullptr || ndim < 0 ||
         (unsigned int)ndim >= data_block->rank) {
         return 0;
@@ -3197,6 +3263,9 @@ void udaGetClientSerialisedDataBlock(int handle, void** object, size_t* objectSi
     DATA_BLOCK_LIST data_block_list;
     data_block_list.count = 1;
     data_block_list.data = udaGetDataBlock(handle);
+    data_block_list.native_data = 0;
+    data_block_list.stream_data = 0;
+    data_block_list.compress_data = 0;
     protocol2(&xdrs, UDA_PROTOCOL_DATA_BLOCK_LIST, XDR_SEND, &token, logmalloclist, userdefinedtypelist,
               &data_block_list, protocolVersion, log_struct_list, private_flags, malloc_source);
 
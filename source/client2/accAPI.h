@@ -50,6 +50,8 @@ LIBRARY_API int udaGetNewDataHandle();
 
 LIBRARY_API void udaFreeDataBlocks();
 
+LIBRARY_API void udaSetClientPerThread(int per_thread);
+
 LIBRARY_API void udaSetPrivateFlag(unsigned int flag, unsigned int* private_flags);
 
 LIBRARY_API void udaResetPrivateFlag(unsigned int flag, unsigned int* private_flags);
@@ -115,6 +117,7 @@ LIBRARY_API int udaGetDataStatus(int handle);
 LIBRARY_API int udaGetLastHandle();
 
 LIBRARY_API int udaGetDataNum(int handle);
+LIBRARY_API int64_t udaGetDataNum64(int handle);
 
 LIBRARY_API int udaGetRank(int handle);
 
@@ -123,6 +126,7 @@ LIBRARY_API int udaGetOrder(int handle);
 LIBRARY_API unsigned int udaGetCachePermission(int handle);
 
 LIBRARY_API unsigned int udaGetTotalDataBlockSize(int handle);
+LIBRARY_API uint64_t udaGetTotalDataBlockSize64(int handle);
 
 LIBRARY_API int udaGetDataType(int handle);
 
@@ -213,6 +217,7 @@ LIBRARY_API const char* udaGetDataDesc(int handle);
 LIBRARY_API void udaGetDataDescTdi(int handle, char* desc);
 
 LIBRARY_API int udaGetDimNum(int handle, int ndim);
+LIBRARY_API int64_t udaGetDimNum64(int handle, int ndim);
 
 LIBRARY_API int udaGetDimType(int handle, int ndim);
 
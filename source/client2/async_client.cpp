@@ -0,0 +1,229 @@
+#include "async_client.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <clientserver/errorLog.h>
+#include <clientserver/initStructs.h>
+
+#include "client.hpp"
+#include "handle.hpp"
+
+namespace {
+
+// The first error recorded by the failed request on this thread
+std::string request_error()
+{
+    UDA_ERROR_STACK error_stack = {};
+    concatUdaError(&error_stack);
+
+    std::string message = error_stack.nerrors > 0 ? error_stack.idamerror[0].msg : "data request failed";
+    free(error_stack.idamerror);
+
+    return message;
+}
+
+} // anon namespace
+
+uda::client::AsyncResult::AsyncResult()
+    : data_block_{ new DATA_BLOCK }
+{
+    initDataBlock(data_block_.get());
+}
+
+void uda::client::AsyncResult::DataBlockDeleter::operator()(DATA_BLOCK* data_block) const
+{
+    free_data_block(data_block);
+    delete data_block;
+}
+
+/**
+ * Start the worker threads, one connection to the server each. Connections are opened by the first request a worker
+ * serves.
+ */
+uda::client::AsyncClient::AsyncClient(size_t connections)
+{
+    if (connections == 0) {
+        connections = 1;
+    }
+    for (size_t i = 0; i < connections; ++i) {
+        workers_.emplace_back(&AsyncClient::run, this);
+    }
+}
+
+/**
+ * Serve the requests still queued, then stop the workers and close their connections.
+ */
+uda::client::AsyncClient::~AsyncClient()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    queued_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void uda::client::AsyncClient::set_host(std::string_view host)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_.host = host;
+    ++settings_.generation;
+}
+
+void uda::client::AsyncClient::set_port(int port)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_.port = port;
+    ++settings_.generation;
+}
+
+/**
+ * Set a client property (see Client::set_property) for the requests queued from now on.
+ */
+void uda::client::AsyncClient::set_property(const char* property)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_.properties.emplace_back(property);
+    ++settings_.generation;
+}
+
+/**
+ * Queue a request, returning a future for its result. A request the client fails to make (no connection, protocol
+ * error, ...) completes with a std::runtime_error carrying the first error recorded.
+ */
+std::future<uda::client::AsyncResult>
+uda::client::AsyncClient::get_async(std::string_view data_signal, std::string_view data_source)
+{
+    auto promise = std::make_shared<std::promise<AsyncResult>>();
+    auto future = promise->get_future();
+
+    get_async(data_signal, data_source, [promise](std::exception_ptr error, AsyncResult result) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(result));
+        }
+    });
+
+    return future;
+}
+
+/**
+ * Queue a request whose result is passed to the callback, on the worker thread that served it.
+ */
+void uda::client::AsyncClient::get_async(std::string_view data_signal, std::string_view data_source,
+                                         AsyncCallback callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(Request{ std::string{ data_signal }, std::string{ data_source }, std::move(callback) });
+    }
+    queued_.notify_one();
+}
+
+/**
+ * Wait until one of the futures returned by get_async is ready and return its index, or futures.size() if none is
+ * valid.
+ */
+size_t uda::client::AsyncClient::wait_any(std::vector<std::future<AsyncResult>>& futures)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        bool pending = false;
+        for (size_t i = 0; i < futures.size(); ++i) {
+            if (!futures[i].valid()) {
+                continue;
+            }
+            if (futures[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                return i;
+            }
+            pending = true;
+        }
+        if (!pending) {
+            return futures.size();
+        }
+        completed_.wait(lock);
+    }
+}
+
+void uda::client::AsyncClient::wait_all(std::vector<std::future<AsyncResult>>& futures)
+{
+    for (auto& future : futures) {
+        if (future.valid()) {
+            future.wait();
+        }
+    }
+}
+
+void uda::client::AsyncClient::run()
+{
+    Client client;
+    unsigned int generation = 0;
+
+    while (true) {
+        Request request;
+        Settings settings;
+        bool configure = false;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queued_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            request = std::move(queue_.front());
+            queue_.pop_front();
+            if (settings_.generation != generation) {
+                settings = settings_;
+                generation = settings_.generation;
+                configure = true;
+            }
+        }
+
+        if (configure) {
+            if (!settings.host.empty()) {
+                client.set_host(settings.host);
+            }
+            if (settings.port != 0) {
+                client.set_port(settings.port);
+            }
+            for (const auto& property : settings.properties) {
+                client.set_property(property.c_str());
+            }
+        }
+
+        AsyncResult result;
+        std::exception_ptr error;
+
+        try {
+            int handle = client.get(request.signal, request.source);
+            DATA_BLOCK* data_block = client.data_block(handle);
+            if (data_block != nullptr) {
+                *result.data_block_ = *data_block;      // The result takes over the heap memory of the block
+                initDataBlock(data_block);
+            } else {
+                // No connection, or another failure the Client returns rather than throws: no handle was issued
+                error = std::make_exception_ptr(std::runtime_error(request_error()));
+            }
+        } catch (...) {
+            error = std::make_exception_ptr(std::runtime_error(request_error()));
+        }
+
+        client.clear();     // Blocks are handed over: nothing to keep between requests
+
+        complete(request, error, std::move(result));
+    }
+}
+
+void uda::client::AsyncClient::complete(const Request& request, std::exception_ptr error, AsyncResult result)
+{
+    request.callback(error, std::move(result));
+
+    // Taking the lock orders the notification after any wait_any that found this request still pending
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_.notify_all();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef UDA_SOURCE_CLIENT2_ASYNC_CLIENT_H
+#define UDA_SOURCE_CLIENT2_ASYNC_CLIENT_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <clientserver/udaStructs.h>
+
+namespace uda {
+namespace client {
+
+//--------------------------------------------------------------------------------------------
+// Asynchronous data requests.
+//
+// Requests are queued and served by a fixed set of worker threads, each with its own Client and so its own server
+// connection, so the caller can issue many requests, carry on computing and wait for any or all of them. Each result
+// owns the data block it received, independent of any Client handle, and may be used from any thread.
+
+class AsyncResult
+{
+public:
+    AsyncResult();
+
+    // As for a handle, a server side error is reported by the data block's errcode and error_msg
+    DATA_BLOCK* data_block() { return data_block_.get(); }
+    const DATA_BLOCK* data_block() const { return data_block_.get(); }
+
+private:
+    friend class AsyncClient;
+
+    struct DataBlockDeleter {
+        void operator()(DATA_BLOCK* data_block) const;
+    };
+
+    std::unique_ptr<DATA_BLOCK, DataBlockDeleter> data_block_;
+};
+
+using AsyncCallback = std::function<void(std::exception_ptr error, AsyncResult result)>;
+
+class AsyncClient
+{
+public:
+    static constexpr size_t DefaultConnections = 4;
+
+    explicit AsyncClient(size_t connections = DefaultConnections);
+    ~AsyncClient();
+
+    AsyncClient(const AsyncClient&) = delete;
+    AsyncClient& operator=(const AsyncClient&) = delete;
+
+    void set_host(std::string_view host);
+    void set_port(int port);
+    void set_property(const char* property);
+
+    std::future<AsyncResult> get_async(std::string_view data_signal, std::string_view data_source);
+    void get_async(std::string_view data_signal, std::string_view data_source, AsyncCallback callback);
+
+    size_t wait_any(std::vector<std::future<AsyncResult>>& futures);
+    void wait_all(std::vector<std::future<AsyncResult>>& futures);
+
+private:
+    struct Request {
+        std::string signal;
+        std::string source;
+        AsyncCallback callback;
+    };
+
+    struct Settings {
+        std::string host;
+        int port = 0;
+        std::vector<std::string> properties;
+        unsigned int generation = 0;
+    };
+
+    void run();
+    void complete(const Request& request, std::exception_ptr error, AsyncResult result);
+
+    std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable completed_;
+    std::deque<Request> queue_;
+    Settings settings_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+}
+}
+
+#endif // UDA_SOURCE_CLIENT2_ASYNC_CLIENT_H
@@ -21,6 +21,10 @@
 #include <clientserver/stringUtils.h>
 #include <clientserver/allocData.h>
 
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
 namespace {
 
 void copy_data_block(DATA_BLOCK* str, DATA_BLOCK* in)
@@ -78,6 +82,9 @@ void update_client_block(CLIENT_BLOCK& client_block, const ClientFlags& client_f
 {
     client_block.timeout = client_flags.user_timeout;
     client_block.clientFlags = client_flags.flags;
+    if (littleEndianHost()) {
+        client_block.clientFlags |= CLIENTFLAG_NATIVEDATA;  // Same byte order as the wire: no array conversion
+    }
     client_block.altRank = client_flags.alt_rank;
     client_block.get_datadble = client_flags.get_datadble;
     client_block.get_dimdble = client_flags.get_dimdble;
@@ -106,6 +113,54 @@ void update_client_block(CLIENT_BLOCK& client_block, const ClientFlags& client_f
     }
 }
 
+/**
+ * Set the log level and open the debug and error log files selected by the client environment.
+ */
+void open_logs(const ENVIRONMENT& environment)
+{
+    //----------------------------------------------------------------
+    // Check if Output Requested
+
+    udaSetLogLevel((LOG_LEVEL)environment.loglevel);
+
+    if (environment.loglevel == UDA_LOG_NONE) {
+        return;
+    }
+
+    //---------------------------------------------------------------
+    // Open the Log File
+
+    errno = 0;
+
+    std::string file_name = environment.logdir;
+    file_name += "Debug.dbg";
+
+    FILE* file = fopen(file_name.c_str(), environment.logmode);
+    udaSetLogFile(UDA_LOG_WARN, file);
+    udaSetLogFile(UDA_LOG_DEBUG, file);
+    udaSetLogFile(UDA_LOG_INFO, file);
+
+    if (errno != 0) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "failed to open debug log");
+        udaCloseLogging();
+        return;
+    }
+
+    if (udaGetLogLevel() <= UDA_LOG_ERROR) {
+        file_name = environment.logdir;
+        file_name += "Error.err";
+
+        file = fopen(file_name.c_str(), environment.logmode);
+        udaSetLogFile(UDA_LOG_ERROR, file);
+    }
+
+    if (errno != 0) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "failed to open error log");
+        udaCloseLogging();
+        return;
+    }
+}
+
 } // anon namespace
 
 uda::client::Client::Client()
@@ -128,6 +183,7 @@ uda::client::Client::Client()
     initUdaErrorStack();
 
     environment_ = load_environment(&env_host_, &env_port_);
+    default_environment_ = environment_;
     print_client_environment(environment_);
 
     //----------------------------------------------------------------
@@ -158,47 +214,10 @@ uda::client::Client::Client()
 
     initClientBlock(&client_block_, ClientVersion, client_username_.c_str());
 
-    //----------------------------------------------------------------
-    // Check if Output Requested
-
-    udaSetLogLevel((LOG_LEVEL)environment_.loglevel);
-
-    if (environment_.loglevel == UDA_LOG_NONE) {
-        return;
-    }
+    // Logs are shared by all the clients of the process (one per thread in per thread mode)
 
-    //---------------------------------------------------------------
-    // Open the Log File
-
-    errno = 0;
-
-    std::string file_name = environment_.logdir;
-    file_name += "Debug.dbg";
-
-    FILE* file = fopen(file_name.c_str(), environment_.logmode);
-    udaSetLogFile(UDA_LOG_WARN, file);
-    udaSetLogFile(UDA_LOG_DEBUG, file);
-    udaSetLogFile(UDA_LOG_INFO, file);
-
-    if (errno != 0) {
-        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "failed to open debug log");
-        udaCloseLogging();
-        return;
-    }
-
-    if (udaGetLogLevel() <= UDA_LOG_ERROR) {
-        file_name = environment_.logdir;
-        file_name += "Error.err";
-
-        file = fopen(file_name.c_str(), environment_.logmode);
-        udaSetLogFile(UDA_LOG_ERROR, file);
-    }
-
-    if (errno != 0) {
-        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "failed to open error log");
-        udaCloseLogging();
-        return;
-    }
+    static std::once_flag logs_opened;
+    std::call_once(logs_opened, open_logs, std::cref(environment_));
 }
 
 int
@@ -286,6 +305,54 @@ uda::client::Client::fetch_hierarchical_data(DATA_BLOCK* data_block)
     return 0;
 }
 
+/**
+ * Pass the data array of a data block to the stream callback. Arrays streamed by the server are received chunk by
+ * chunk into a single reused buffer; otherwise the array already received is passed whole.
+ */
+int uda::client::Client::receive_data_stream(int handle, bool streamed, bool native, bool compress)
+{
+    DATA_BLOCK* data_block = &data_blocks_[handle];
+
+    if (!streamed) {
+        if (data_block->data != nullptr && data_block->data_n > 0) {
+            stream_callback_(handle, data_block->data, 0, data_block->data_n, stream_user_data_);
+        }
+        return 0;
+    }
+
+    DATA_CHUNK data_chunk = {};
+    data_chunk.data_type = data_block->data_type;
+    data_chunk.native_data = native;
+    data_chunk.compress_data = compress;
+
+    int err = 0;
+    int64_t offset = 0;
+    bool deliver = true;
+
+    do {
+        if ((err = protocol2(client_input_, UDA_PROTOCOL_DATA_CHUNK, XDR_RECEIVE, nullptr, logmalloclist_,
+                             userdefinedtypelist_, &data_chunk, protocol_version_, &log_struct_list_, private_flags_,
+                             malloc_source_)) != 0) {
+            addIdamError(UDA_CODE_ERROR_TYPE, __func__, err, "Protocol 2 Error (Failure Receiving Data Chunk)");
+            break;
+        }
+        if (data_chunk.count > 0 && deliver) {
+            // The application may stop the delivery, but the remaining chunks must still be read
+            deliver = stream_callback_(handle, data_chunk.data, offset, data_chunk.count, stream_user_data_) == 0;
+        }
+        offset += data_chunk.count;
+    } while (data_chunk.count > 0);
+
+    free(data_chunk.data);
+
+    if (err == 0 && offset != data_block->data_n) {
+        err = UDA_PROTOCOL_ERROR_62;
+        addIdamError(UDA_CODE_ERROR_TYPE, __func__, err, "Streamed data array is incomplete");
+    }
+
+    return err;
+}
+
 const char* uda::client::Client::get_server_error_stack_record_msg(int record)
 {
     UDA_LOG(UDA_LOG_DEBUG, "record %d\n", record);
@@ -305,24 +372,79 @@ int uda::client::Client::get_server_error_stack_record_code(int record)
 }
 
 int uda::client::Client::get_requests(RequestBlock& request_block, int* indices)
+{
+    int err = prepare_connection();
+    if (err != 0) {
+        return err;
+    }
+
+    try {
+        test_connection();
+        send_request(request_block);
+
+        transfer_size_ = 0;
+        err = receive_response(request_block, indices);
+    } catch (...) {
+        close_connection();
+        throw;
+    }
+
+    if (err == 0) {
+        adapt_input_buffer();
+    }
+
+    return err;
+}
+
+/**
+ * Close the server connection after a failed exchange: the state of the streams is not known, so the next request
+ * opens a new connection rather than reading the remains of this one.
+ */
+void uda::client::Client::close_connection()
+{
+    closedown(ClosedownType::CLOSE_SOCKETS, &connection_, client_input_, client_output_, &reopen_logs_, &env_host_,
+              &env_port_);
+}
+
+/**
+ * Grow the input stream's buffer after a bulk transfer, up to the environment's limit, so that later transfers of a
+ * similar size need fewer reads. The stream is only re-created when no further response is already buffered in it.
+ */
+void uda::client::Client::adapt_input_buffer()
+{
+    u_int buffer_size = xdr_record_buffer_size(input_buffer_size_, transfer_size_, environment_.xdr_buffer_max);
+    if (buffer_size == input_buffer_size_ || !connection_.open() || client_input_->x_ops == nullptr) {
+        return;
+    }
+
+    if (xdrrec_eof(client_input_)) {
+        resizeXDRInputStream(&io_data_, client_input_, buffer_size);
+        input_buffer_size_ = buffer_size;
+    }
+}
+
+/**
+ * Open the server connection if there is none, or a new one if the server has timed out or the host has changed,
+ * and exchange client and server versions when a connection is opened.
+ */
+int uda::client::Client::prepare_connection()
 {
     initServerBlock(&server_block_, 0);
     initUdaErrorStack();
 
-    time_t tv_server_start = 0;
     time_t tv_server_end = 0;
 
     if (environment_.server_reconnect || environment_.server_change_socket) {
-        int err = connection_.reconnect(&client_input_, &client_output_, &tv_server_start, &client_flags_.user_timeout);
+        int err = connection_.reconnect(&client_input_, &client_output_, &tv_server_start_, &client_flags_.user_timeout);
         if (err) {
             return err;
         }
     }
 
     time(&tv_server_end);
-    long age = (long)tv_server_end - (long)tv_server_start;
+    long age = (long)tv_server_end - (long)tv_server_start_;
 
-    UDA_LOG(UDA_LOG_DEBUG, "Start: %ld    End: %ld\n", (long)tv_server_start, (long)tv_server_end);
+    UDA_LOG(UDA_LOG_DEBUG, "Start: %ld    End: %ld\n", (long)tv_server_start_, (long)tv_server_end);
     UDA_LOG(UDA_LOG_DEBUG, "Server Age: %ld\n", age);
 
     bool init_server = true;
@@ -359,8 +481,10 @@ int uda::client::Client::get_requests(RequestBlock& request_block, int* indices)
         }
 
         io_data_ = connection_.io_data();
-        std::tie(client_input_, client_output_) = createXDRStream(&io_data_);
-        time(&tv_server_start);        // Start the Clock again: Age of Server
+        input_buffer_size_ = environment_.xdr_buffer_size;
+        std::tie(client_input_, client_output_) = createXDRStream(&io_data_, &input_stream_, &output_stream_,
+                                                                  input_buffer_size_);
+        time(&tv_server_start_);       // Start the Clock again: Age of Server
     }
 
     char* env = nullptr;
@@ -370,6 +494,9 @@ int uda::client::Client::get_requests(RequestBlock& request_block, int* indices)
     }
 
     update_client_block(client_block_, client_flags_, private_flags_);
+    if (stream_callback_ != nullptr) {
+        client_block_.clientFlags |= CLIENTFLAG_STREAMDATA;
+    }
     printClientBlock(client_block_);
 
     //-------------------------------------------------------------------------
@@ -385,13 +512,27 @@ int uda::client::Client::get_requests(RequestBlock& request_block, int* indices)
     UDA_LOG(UDA_LOG_DEBUG, "Client Version   %d\n", client_block_.version);
     UDA_LOG(UDA_LOG_DEBUG, "Server Version   %d\n", server_block_.version);
 
-    int err = test_connection();
+    return 0;
+}
+
+/**
+ * Send a request to the server as a single record, without waiting for the response.
+ */
+int uda::client::Client::send_request(RequestBlock& request_block)
+{
+    send_client_block();
+    send_request_block(request_block);
+    send_putdata(request_block);
 
-    err = send_client_block();
-    err = send_request_block(request_block);
-    err = send_putdata(request_block);
+    return send_record();
+}
 
-    err = flush_sockets();
+/**
+ * Receive the response to the oldest request sent, setting indices to the handles of its data blocks.
+ */
+int uda::client::Client::receive_response(RequestBlock& request_block, int* indices)
+{
+    int err = receive_record();
 
     err = receive_server_block();
 
@@ -402,6 +543,18 @@ int uda::client::Client::get_requests(RequestBlock& request_block, int* indices)
         err = server_block_.idamerrorstack.idamerror[0].code;      // Problem on the Server Side!
         UDA_LOG(UDA_LOG_DEBUG, "Server Block passed Server Error State %d\n", err);
         //server_side = true;        // Most Server Side errors are benign so don't close the server
+
+        // No data follow: each request gets a handle carrying the server's error, which the response to a later
+        // request cannot overwrite as it does the server block
+        for (int i = 0; i < request_block.num_requests; ++i) {
+            int handle = new_handle();
+            DataBlock* data_block = &data_blocks_[handle];
+            initDataBlock(data_block);
+            copy_client_block(&data_block->client_block, &client_flags_);
+            data_block->errcode = get_server_error_stack_record_code(0);
+            strcpy(data_block->error_msg, get_server_error_stack_record_msg(0));
+            indices[i] = handle;
+        }
         return 0;
     }
 
@@ -459,23 +612,33 @@ int uda::client::Client::get_requests(RequestBlock& request_block, int* indices)
             *data_block->signal_desc    = metadata_.signal_desc;
         }
 
+        bool streamed = recv_data_block_list.stream_data && streamedDataBlock(data_block);
+        if (stream_callback_ != nullptr) {
+            if ((err = receive_data_stream((int)data_block_idx, streamed, recv_data_block_list.native_data,
+                                           recv_data_block_list.compress_data)) != 0) {
+                break;
+            }
+        }
+
         fetch_hierarchical_data(data_block);
 
         //------------------------------------------------------------------------------
         // Cache the data if the server has passed permission and the application (client) has enabled caching
-        if (client_flags_.flags & CLIENTFLAG_FILECACHE) {
-            udaFileCacheWrite(data_block, &request_block, logmalloclist_, userdefinedtypelist_, protocol_version_,
+        // Streamed data arrays are not kept so cannot be cached
+        if (client_flags_.flags & CLIENTFLAG_FILECACHE && !streamed) {
+            udaFileCacheWrite(data_block, &request_block, logmalloclist_, userdefinedtypelist_, ClientVersion,
                               &log_struct_list_, private_flags_, malloc_source_);
         }
 
-        if (cache_ != nullptr && client_flags_.flags & CLIENTFLAG_CACHE) {
+        if (cache_ != nullptr && client_flags_.flags & CLIENTFLAG_CACHE && !streamed) {
             cache_write(cache_, &request_block.requests[i], data_block, logmalloclist_, userdefinedtypelist_,
-                        environment_, protocol_version_, client_flags_.flags, &log_struct_list_,
+                        environment_, ClientVersion, client_flags_.flags, &log_struct_list_,
                         private_flags_, malloc_source_);
         }
 
         data_block_indices[i] = data_block_idx;
         data_received = true;
+        transfer_size_ += (size_t)data_block->data_n * getSizeOf((UDA_TYPE)data_block->data_type);
     }
 
     free(recv_data_block_list.data);
@@ -597,6 +760,22 @@ int uda::client::Client::get(std::string_view data_signal, std::string_view data
     return indices[0];
 }
 
+int uda::client::Client::get_stream(std::string_view data_signal, std::string_view data_source,
+                                    UDA_DATA_CHUNK_CALLBACK callback, void* user_data)
+{
+    stream_callback_ = callback;
+    stream_user_data_ = user_data;
+
+    try {
+        int handle = get(data_signal, data_source);
+        stream_callback_ = nullptr;
+        return handle;
+    } catch (...) {
+        stream_callback_ = nullptr;
+        throw;
+    }
+}
+
 std::vector<int> uda::client::Client::get(std::vector<std::pair<std::string, std::string>>& requests)
 {
     REQUEST_BLOCK request_block;
@@ -626,6 +805,94 @@ std::vector<int> uda::client::Client::get(std::vector<std::pair<std::string, std
     return indices;
 }
 
+/**
+ * Fetch each request separately, as with a get per request, but without waiting for each response before sending the
+ * next request: up to depth requests are in flight on the connection at once, so a sequence of small requests costs
+ * about one round trip rather than one per request.
+ *
+ * The server answers requests strictly in the order received, so responses are matched to requests by order. The
+ * window bounds the unread responses queued behind the one being read, so neither end can stall writing to the other.
+ * A request the server reports an error for gets a handle carrying that error, and the pipeline continues. The handle
+ * of a request is -1 if it could not be sent or its response not received, which ends the pipeline.
+ */
+std::vector<int> uda::client::Client::get_pipelined(std::vector<std::pair<std::string, std::string>>& requests,
+                                                    size_t depth)
+{
+    std::vector<REQUEST_BLOCK> request_blocks(requests.size());
+    for (auto& request_block : request_blocks) {
+        initRequestBlock(&request_block);
+    }
+
+    auto free_request_blocks = [&request_blocks]() {
+        for (auto& request_block : request_blocks) {
+            freeRequestBlock(&request_block);
+        }
+    };
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const char* signal = requests[i].first.c_str();
+        const char* source = requests[i].second.c_str();
+        if (make_request_block(&environment_, &signal, &source, 1, &request_blocks[i]) != 0) {
+            free_request_blocks();
+            if (udaNumErrors() == 0) {
+                UDA_LOG(UDA_LOG_ERROR, "Error identifying the Data Source [%s]\n", source);
+                addIdamError(UDA_CODE_ERROR_TYPE, __func__, 999, "Error identifying the Data Source");
+            }
+            throw uda::exceptions::ClientError("Error identifying the Data Source [%1%]", source);
+        }
+        printRequestBlock(request_blocks[i]);
+    }
+
+    std::vector<int> indices(requests.size(), -1);
+    if (requests.empty()) {
+        return indices;
+    }
+
+    depth = std::max(depth, (size_t)1);
+
+    try {
+        if (prepare_connection() != 0) {
+            free_request_blocks();
+            return indices;
+        }
+
+        test_connection();
+
+        size_t sent = 0;
+        size_t received = 0;
+        transfer_size_ = 0;
+        while (received < requests.size()) {
+            while (sent < requests.size() && sent - received < depth) {
+                if (send_request(request_blocks[sent]) != 0) {
+                    break;
+                }
+                ++sent;
+            }
+            if (received == sent) {
+                break;
+            }
+            if (receive_response(request_blocks[received], &indices[received]) != 0) {
+                indices[received] = -1;
+                break;
+            }
+            ++received;
+        }
+        if (received < sent) {
+            // Responses to the requests already sent are still to come
+            close_connection();
+        } else if (received == requests.size()) {
+            adapt_input_buffer();
+        }
+    } catch (...) {
+        close_connection();
+        free_request_blocks();
+        throw;
+    }
+
+    free_request_blocks();
+    return indices;
+}
+
 void uda::client::Client::set_host(std::string_view host)
 {
     host_ = host;
@@ -776,10 +1043,10 @@ int uda::client::Client::perform_handshake()
     return 0;
 }
 
-int uda::client::Client::flush_sockets()
+int uda::client::Client::send_record()
 {
     //------------------------------------------------------------------------------
-    // Send the Full TCP packet and wait for the returned data
+    // Send the Full TCP packet
 
     int rc = 0;
     if (!(rc = xdrrec_endofrecord(client_output_, 1))) {
@@ -789,6 +1056,13 @@ int uda::client::Client::flush_sockets()
     }
 
     UDA_LOG(UDA_LOG_DEBUG, "****** Outgoing tcp packet sent without error. Waiting for data.\n");
+    return 0;
+}
+
+int uda::client::Client::receive_record()
+{
+    //------------------------------------------------------------------------------
+    // Wait for the returned data
 
     if (!xdrrec_skiprecord(client_input_)) {
         int err = UDA_PROTOCOL_ERROR_5;
@@ -906,6 +1180,7 @@ void uda::client::Client::set_property(const char* property)
         if (STR_IEQUALS(property, "reuseLastHandle")) client_flags_.flags = client_flags_.flags | CLIENTFLAG_REUSELASTHANDLE;
         if (STR_IEQUALS(property, "freeAndReuseLastHandle")) client_flags_.flags = client_flags_.flags | CLIENTFLAG_FREEREUSELASTHANDLE;
         if (STR_IEQUALS(property, "fileCache")) client_flags_.flags = client_flags_.flags | CLIENTFLAG_FILECACHE;
+        if (STR_IEQUALS(property, "compressData")) client_flags_.flags = client_flags_.flags | CLIENTFLAG_COMPRESSDATA;
     }
 }
 
@@ -935,6 +1210,7 @@ int uda::client::Client::get_property(const char* property)
         if (STR_IEQUALS(property, "debug")) return udaGetLogLevel() == UDA_LOG_DEBUG;
         if (STR_IEQUALS(property, "altData")) return (int)(client_flags_.flags & CLIENTFLAG_ALTDATA);
         if (STR_IEQUALS(property, "fileCache")) return (int)(client_flags_.flags & CLIENTFLAG_FILECACHE);
+        if (STR_IEQUALS(property, "compressData")) return (int)(client_flags_.flags & CLIENTFLAG_COMPRESSDATA);
     }
     return 0;
 }
@@ -966,6 +1242,7 @@ void uda::client::Client::reset_property(const char* property)
             client_flags_.flags &= !CLIENTFLAG_FREEREUSELASTHANDLE;
         }
         if (STR_IEQUALS(property, "fileCache")) client_flags_.flags &= !CLIENTFLAG_FILECACHE;
+        if (STR_IEQUALS(property, "compressData")) client_flags_.flags &= ~CLIENTFLAG_COMPRESSDATA;
     }
 }
 
@@ -994,6 +1271,46 @@ void uda::client::Client::reset_properties()
     client_flags_.alt_rank = 0;
 }
 
+/**
+ * Return the Client to the state of a new one, for reuse by another thread: its data handles are freed, and the
+ * properties, flags and server set through the API are dropped. The connection is kept open if it is to the server
+ * of the environment, otherwise it is closed and the next request connects to that server.
+ */
+void uda::client::Client::reset()
+{
+    for (auto& data_block : data_blocks_) {
+        freeDataBlock(&data_block);
+    }
+    data_blocks_.clear();
+
+    client_flags_ = {};
+    client_flags_.user_timeout = TIMEOUT;
+    if (getenv("UDA_TIMEOUT")) {
+        client_flags_.user_timeout = atoi(getenv("UDA_TIMEOUT"));
+    }
+    private_flags_ = 0;
+
+    host_ = DefaultHost;
+    port_ = DefaultPort;
+
+    bool default_server = strcmp(environment_.server_host, default_environment_.server_host) == 0
+                          && environment_.server_port == default_environment_.server_port
+                          && !environment_.server_reconnect && !environment_.server_change_socket;
+    int server_socket = environment_.server_socket;
+    if (!default_server) {
+        close_connection();
+    }
+
+    environment_ = default_environment_;
+    if (default_server) {
+        environment_.server_socket = server_socket;
+    }
+
+    stream_callback_ = nullptr;
+    stream_user_data_ = nullptr;
+    error_stack_.clear();
+}
+
 DATA_BLOCK* uda::client::Client::data_block(int handle)
 {
     auto idx = static_cast<size_t>(handle);
@@ -15,6 +15,7 @@
 #include "connection.hpp"
 #include "host_list.hpp"
 #include "accAPI.h"
+#include "udaGetAPI.h"
 
 constexpr auto DefaultHost = "localhost";
 constexpr auto DefaultPort = 56565;
@@ -22,7 +23,8 @@ constexpr auto DefaultPort = 56565;
 namespace uda {
 namespace client {
 
-constexpr int ClientVersion = 8;
+constexpr int ClientVersion = 11;
+constexpr size_t DefaultPipelineDepth = 16;
 
 struct MetadataBlock {
     DATA_SOURCE data_source;
@@ -39,6 +41,10 @@ public:
 
     int get(std::string_view data_signal, std::string_view data_source);
     std::vector<int> get(std::vector<std::pair<std::string, std::string>>& requests);
+    std::vector<int> get_pipelined(std::vector<std::pair<std::string, std::string>>& requests,
+                                   size_t depth = DefaultPipelineDepth);
+    int get_stream(std::string_view data_signal, std::string_view data_source, UDA_DATA_CHUNK_CALLBACK callback,
+                   void* user_data);
 
     int put(std::string_view put_instruction, PUTDATA_BLOCK* putdata_block);
     int put(std::string_view put_instruction, PUTDATA_BLOCK_LIST* putdata_block_list);
@@ -55,6 +61,7 @@ public:
     int get_property(const char* property);
     void reset_property(const char* property);
     void reset_properties();
+    void reset();
     const CLIENT_BLOCK* client_block(int handle);
     const CLIENT_FLAGS* client_flags();
     const SERVER_BLOCK* server_block();
@@ -68,6 +75,11 @@ public:
 
 private:
     int get_requests(RequestBlock& request_block, int* indices);
+    int prepare_connection();
+    int send_request(RequestBlock& request_block);
+    int receive_response(RequestBlock& request_block, int* indices);
+    void adapt_input_buffer();
+    void close_connection();
     void concat_errors(UDA_ERROR_STACK* error_stack);
     const char* get_server_error_stack_record_msg(int record);
     int get_server_error_stack_record_code(int record);
@@ -77,6 +89,7 @@ private:
     uint32_t flags_ = 0;
     int alt_rank_ = 0;
     ENVIRONMENT environment_ = {};
+    ENVIRONMENT default_environment_ = {};                          // As loaded at construction, restored by reset()
     ClientFlags client_flags_ = {};
     uint32_t private_flags_= 0;
     ClientBlock client_block_ = {};
@@ -86,11 +99,16 @@ private:
     std::vector<UDA_ERROR> error_stack_ = {};
     XDR* client_input_ = nullptr;
     XDR* client_output_ = nullptr;
+    XDR input_stream_ = {};
+    XDR output_stream_ = {};
     Connection connection_;
     HostList host_list_ = {};
     IoData io_data_ = {};
-    bool env_host_ = false;
-    bool env_port_ = false;
+    time_t tv_server_start_ = 0;                                    // Time the server connection was opened
+    unsigned int input_buffer_size_ = 0;
+    size_t transfer_size_ = 0;                                      // Data received for the current request(s)
+    bool env_host_ = true;                                          // UDA_HOST/UDA_PORT still to be read (not set
+    bool env_port_ = true;                                          // by the user): load_environment clears these
     bool reopen_logs_ = false;
     std::string client_username_ = "client";
     int protocol_version_ = ClientVersion;
@@ -100,16 +118,20 @@ private:
     LOGSTRUCTLIST log_struct_list_ = {};
     int malloc_source_ = UDA_MALLOC_SOURCE_NONE;
     MetadataBlock metadata_ = {};
+    UDA_DATA_CHUNK_CALLBACK stream_callback_ = nullptr;
+    void* stream_user_data_ = nullptr;
 
     int send_putdata(const RequestBlock& request_block);
     int send_request_block(RequestBlock& request_block);
     int send_client_block();
     int test_connection();
     int perform_handshake();
-    int flush_sockets();
+    int send_record();
+    int receive_record();
     int receive_server_block();
     int fetch_meta();
     int fetch_hierarchical_data(DATA_BLOCK* data_block);
+    int receive_data_stream(int handle, bool streamed, bool native, bool compress);
 };
 
 }
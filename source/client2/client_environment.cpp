@@ -1,4 +1,5 @@
 #include <logging/logging.h>
+#include <clientserver/udaDefines.h>
 #include <cstdlib>
 #include "client_environment.hpp"
 #include <fmt/format.h>
@@ -185,6 +186,24 @@ Environment uda::client::load_environment(bool* env_host, bool* env_port)
     environment.altRank = 0;
     if ((env = getenv("UDA_ALTRANK")) != nullptr) environment.altRank = atoi(env);
 
+    //-------------------------------------------------------------------------------------------
+    // XDR record stream and socket buffer sizes (bytes)
+
+    environment.xdr_buffer_size = DB_READ_BLOCK_SIZE;
+    if ((env = getenv("UDA_XDR_BUFFER_SIZE")) != nullptr && atoi(env) > 0) environment.xdr_buffer_size = atoi(env);
+
+    environment.xdr_buffer_max = DB_MAX_BLOCK_SIZE;
+    if ((env = getenv("UDA_XDR_BUFFER_MAX")) != nullptr && atoi(env) > 0) environment.xdr_buffer_max = atoi(env);
+    if (environment.xdr_buffer_max < environment.xdr_buffer_size) {
+        environment.xdr_buffer_max = environment.xdr_buffer_size;
+    }
+
+    environment.socket_buffer_size = 0;
+    if ((env = getenv("UDA_SOCKET_BUFFER_SIZE")) != nullptr) environment.socket_buffer_size = atoi(env);
+
+    environment.socket_timeout = 0;
+    if ((env = getenv("UDA_SOCKET_TIMEOUT")) != nullptr && atoi(env) > 0) environment.socket_timeout = atoi(env);
+
     //-------------------------------------------------------------------------------------------
 
     environment.initialised = 1;        // Initialisation Complete
@@ -200,6 +219,9 @@ void uda::client::print_client_environment(const Environment& environment)
     UDA_LOG(UDA_LOG_INFO, "Log Level       : %d\n", environment.loglevel);
     UDA_LOG(UDA_LOG_INFO, "Client Flags    : %u\n", environment.clientFlags);
     UDA_LOG(UDA_LOG_INFO, "Alt Rank        : %d\n", environment.altRank);
+    UDA_LOG(UDA_LOG_INFO, "XDR Buffer Size : %d (max %d)\n", environment.xdr_buffer_size, environment.xdr_buffer_max);
+    UDA_LOG(UDA_LOG_INFO, "Socket Buffer   : %d\n", environment.socket_buffer_size);
+    UDA_LOG(UDA_LOG_INFO, "Socket Timeout  : %d\n", environment.socket_timeout);
 #ifdef FATCLIENT
     UDA_LOG(UDA_LOG_INFO, "External User?  : %d\n", environment.external_user);
 #  ifdef PROXYSERVER
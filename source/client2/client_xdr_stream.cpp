@@ -4,7 +4,6 @@
 #include <rpc/rpc.h>
 
 #include <logging/logging.h>
-#include <clientserver/udaDefines.h>
 
 #include "connection.hpp"
 
@@ -12,50 +11,29 @@
 #  include <authentication/udaClientSSL.h>
 #endif
 
-std::pair<XDR*, XDR*> uda::client::createXDRStream(IoData* io_data)
-{
-    static XDR client_input = {};
-    static XDR client_output = {};
-
-    client_output.x_ops = nullptr;
-    client_input.x_ops = nullptr;
-
-    UDA_LOG(UDA_LOG_DEBUG, "Creating XDR Streams \n");
+namespace {
 
+// Create a record stream with the given send and receive buffer sizes over the server connection
+void create_stream(XDR* xdrs, uda::client::IoData* io_data, u_int send_size, u_int recv_size)
+{
 #if defined(SSLAUTHENTICATION) && !defined(FATCLIENT)
     if (getUdaClientSSLDisabled()) {
 #if defined (__APPLE__) || defined(__TIRPC__)
-       xdrrec_create(&client_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
-                     reinterpret_cast<int (*)(void *, void *, int)>(uda::client::readin),
-                     reinterpret_cast<int (*)(void *, void *, int)>(uda::client::writeout));
-
-       xdrrec_create(&client_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+       xdrrec_create(xdrs, send_size, recv_size, io_data,
                      reinterpret_cast<int (*)(void *, void *, int)>(uda::client::readin),
                      reinterpret_cast<int (*)(void *, void *, int)>(uda::client::writeout));
 #else
-       xdrrec_create(&client_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
-                     reinterpret_cast<int (*)(char *, char *, int)>(uda::client::readin),
-                     reinterpret_cast<int (*)(char *, char *, int)>(uda::client::writeout));
-
-       xdrrec_create(&client_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+       xdrrec_create(xdrs, send_size, recv_size, (char*)io_data,
                      reinterpret_cast<int (*)(char *, char *, int)>(uda::client::readin),
                      reinterpret_cast<int (*)(char *, char *, int)>(uda::client::writeout));
 #endif    
     } else {
 #if defined (__APPLE__) || defined(__TIRPC__)
-       xdrrec_create(&client_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
-                     reinterpret_cast<int (*)(void *, void *, int)>(readUdaClientSSL),
-                     reinterpret_cast<int (*)(void *, void *, int)>(writeUdaClientSSL));
-
-       xdrrec_create(&client_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+       xdrrec_create(xdrs, send_size, recv_size, io_data,
                      reinterpret_cast<int (*)(void *, void *, int)>(readUdaClientSSL),
                      reinterpret_cast<int (*)(void *, void *, int)>(writeUdaClientSSL));
 #else
-       xdrrec_create(&client_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
-                     reinterpret_cast<int (*)(char *, char *, int)>(readUdaClientSSL),
-                     reinterpret_cast<int (*)(char *, char *, int)>(writeUdaClientSSL));
-
-       xdrrec_create(&client_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+       xdrrec_create(xdrs, send_size, recv_size, (char*)io_data,
                      reinterpret_cast<int (*)(char *, char *, int)>(readUdaClientSSL),
                      reinterpret_cast<int (*)(char *, char *, int)>(writeUdaClientSSL));
 #endif
@@ -63,27 +41,54 @@ std::pair<XDR*, XDR*> uda::client::createXDRStream(IoData* io_data)
 #else
 
 #if defined (__APPLE__) || defined(__TIRPC__)
-    xdrrec_create(&client_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
-                  reinterpret_cast<int (*)(void *, void *, int)>(uda::client::readin),
-                  reinterpret_cast<int (*)(void *, void *, int)>(uda::client::writeout));
-
-    xdrrec_create(&client_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+    xdrrec_create(xdrs, send_size, recv_size, io_data,
                   reinterpret_cast<int (*)(void *, void *, int)>(uda::client::readin),
                   reinterpret_cast<int (*)(void *, void *, int)>(uda::client::writeout));
 #else
-    xdrrec_create(&client_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
-                  reinterpret_cast<int (*)(char *, char *, int)>(uda::client::readin),
-                  reinterpret_cast<int (*)(char *, char *, int)>(uda::client::writeout));
-
-    xdrrec_create(&client_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+    xdrrec_create(xdrs, send_size, recv_size, (char*)io_data,
                   reinterpret_cast<int (*)(char *, char *, int)>(uda::client::readin),
                   reinterpret_cast<int (*)(char *, char *, int)>(uda::client::writeout));
 #endif
 
 #endif // SSLAUTHENTICATION
+}
+
+} // anon namespace
+
+/**
+ * Create the client's input and output record streams over the server connection in the XDR structures provided, with
+ * buffers of buffer_size bytes. Only the input stream's receive and the output stream's send buffers are used.
+ */
+std::pair<XDR*, XDR*> uda::client::createXDRStream(IoData* io_data, XDR* client_input, XDR* client_output,
+                                                   unsigned int buffer_size)
+{
+    client_output->x_ops = nullptr;
+    client_input->x_ops = nullptr;
 
-    client_input.x_op = XDR_DECODE;
-    client_output.x_op = XDR_ENCODE;
+    UDA_LOG(UDA_LOG_DEBUG, "Creating XDR Streams \n");
+
+    create_stream(client_output, io_data, buffer_size, 0);
+    create_stream(client_input, io_data, 0, buffer_size);
+
+    client_input->x_op = XDR_DECODE;
+    client_output->x_op = XDR_ENCODE;
+
+    return std::make_pair(client_input, client_output);
+}
+
+/**
+ * Re-create the client's input record stream with a receive buffer of buffer_size bytes. Any data buffered in the
+ * stream is lost, so this is only done between responses.
+ */
+void uda::client::resizeXDRInputStream(IoData* io_data, XDR* client_input, unsigned int buffer_size)
+{
+    UDA_LOG(UDA_LOG_DEBUG, "Resizing XDR Input Stream buffer to %u bytes\n", buffer_size);
+
+    if (client_input->x_ops != nullptr) {
+        xdr_destroy(client_input);
+    }
+    client_input->x_ops = nullptr;
 
-    return std::make_pair(&client_input, &client_output);
+    create_stream(client_input, io_data, 0, buffer_size);
+    client_input->x_op = XDR_DECODE;
 }
@@ -12,7 +12,9 @@
 namespace uda {
 namespace client {
 
-std::pair<XDR*, XDR*> createXDRStream(IoData* io_data);
+std::pair<XDR*, XDR*> createXDRStream(IoData* io_data, XDR* client_input, XDR* client_output,
+                                      unsigned int buffer_size);
+void resizeXDRInputStream(IoData* io_data, XDR* client_input, unsigned int buffer_size);
 
 }
 }
@@ -10,7 +10,6 @@
 
 #include <cstdlib>
 #include <cerrno>
-#include <csignal>
 #include <vector>
 #include <string>
 #include <boost/algorithm/string.hpp>
@@ -59,6 +58,10 @@
 
 #define PORT_STRING    64
 
+#if !defined(MSG_NOSIGNAL)
+#  define MSG_NOSIGNAL 0
+#endif
+
 int uda::client::Connection::open()
 {
     return client_socket != -1;
@@ -196,7 +199,6 @@ void setHints(struct addrinfo* hints, const char* hostname)
 
 int uda::client::Connection::create(XDR* client_input, XDR* client_output, const HostList& host_list)
 {
-    int window_size = DB_READ_BLOCK_SIZE;        // 128K
     int rc;
 
     static int max_socket_delay = -1;
@@ -472,11 +474,33 @@ int uda::client::Connection::create(XDR* client_input, XDR* client_output, const
 
     if (result) freeaddrinfo(result);
 
-    // Set the receive and send buffer sizes
+    // Set the receive and send buffer sizes if configured: fixing these disables the OS's own tuning of them to the
+    // connection's bandwidth and latency
+
+    int window_size = environment.socket_buffer_size;
+    if (window_size > 0) {
+        setsockopt(client_socket, SOL_SOCKET, SO_SNDBUF, (char*)&window_size, sizeof(window_size));
+        setsockopt(client_socket, SOL_SOCKET, SO_RCVBUF, (char*)&window_size, sizeof(window_size));
+    }
 
-    setsockopt(client_socket, SOL_SOCKET, SO_SNDBUF, (char*)&window_size, sizeof(window_size));
+    // Bound the wait for the server in readin and writeout if configured. By default these block without limit, as a
+    // request can legitimately take the server minutes to serve
 
-    setsockopt(client_socket, SOL_SOCKET, SO_RCVBUF, (char*)&window_size, sizeof(window_size));
+    if (environment.socket_timeout > 0) {
+#ifndef _WIN32
+        struct timeval timeout = {};
+        timeout.tv_sec = environment.socket_timeout;
+#else
+        DWORD timeout = (DWORD)environment.socket_timeout * 1000;
+#endif
+        if (setsockopt(client_socket, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout)) < 0
+            || setsockopt(client_socket, SOL_SOCKET, SO_SNDTIMEO, (char*)&timeout, sizeof(timeout)) < 0) {
+            addIdamError(UDA_CODE_ERROR_TYPE, __func__, -1, "Error Setting the Timeout on Socket");
+            ::close(client_socket);
+            client_socket = -1;
+            return -1;
+        }
+    }
 
     // Other Socket Options
 
@@ -494,6 +518,16 @@ int uda::client::Connection::create(XDR* client_input, XDR* client_output, const
         client_socket = -1;
         return -1;
     }
+#ifdef SO_NOSIGPIPE
+    // No MSG_NOSIGNAL on this platform: suppress SIGPIPE for the socket instead
+    on = 1;
+    if (setsockopt(client_socket, SOL_SOCKET, SO_NOSIGPIPE, (char*)&on, sizeof(on)) < 0) {
+        addIdamError(UDA_CODE_ERROR_TYPE, __func__, -1, "Error Setting NOSIGPIPE on Socket");
+        ::close(client_socket);
+        client_socket = -1;
+        return -1;
+    }
+#endif
 
     // Add New Socket to the Socket's List
 
@@ -555,128 +589,84 @@ void uda::client::Connection::close(ClosedownType type)
     client_socket = -1;
 }
 
-void update_select_params(int fd, fd_set *rfds, struct timeval *tv) {
-    FD_ZERO(rfds);
-    FD_SET(fd, rfds);
-    tv->tv_sec = 0;
-    tv->tv_usec = 500;    // in microsecs => 0.5 ms wait
-}
-
 int uda::client::writeout(void* iohandle, char* buf, int count)
 {
-#ifndef _WIN32
-    void (* OldSIGPIPEHandler)(int);
-#endif
-    int rc = 0;
-    size_t BytesSent = 0;
-
-    fd_set wfds;
-    struct timeval tv = {};
-
     auto io_data = reinterpret_cast<IoData*>(iohandle);
 
-    update_select_params(*io_data->client_socket, &wfds, &tv);
+    // The socket is blocking so send waits for room in the socket buffer, for at most UDA_SOCKET_TIMEOUT if set.
+    // MSG_NOSIGNAL (SO_NOSIGPIPE where there is no MSG_NOSIGNAL) has a write to a closed connection fail with EPIPE
+    // rather than raise SIGPIPE, which would otherwise terminate the application with an error code of 141.
 
-    errno = 0;
-
-    while (select(*io_data->client_socket + 1, nullptr, &wfds, nullptr, &tv) <= 0) {
+    int bytes_sent = 0;
 
-        if (errno == ECONNRESET || errno == ENETUNREACH || errno == ECONNREFUSED) {
-            if (errno == ECONNRESET) {
+    while (bytes_sent < count) {
+        int rc = 0;
+#ifndef _WIN32
+        // Checking for EINTR, as happens if called from IDL
+        while ((rc = (int)send(*io_data->client_socket, buf + bytes_sent, count - bytes_sent, MSG_NOSIGNAL)) == -1
+               && errno == EINTR) {}
+#else
+        while ((rc = send(*io_data->client_socket, buf + bytes_sent, count - bytes_sent, 0)) == SOCKET_ERROR
+               && errno == EINTR) {}
+#endif
+        if (rc <= 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                UDA_LOG(UDA_LOG_DEBUG, "Socket send timed out!\n");
+                addIdamError(UDA_CODE_ERROR_TYPE, __func__, -5,
+                             "Timed out writing to the server socket (UDA_SOCKET_TIMEOUT)");
+                return -5;
+            } else if (errno == ECONNRESET || errno == EPIPE) {
                 UDA_LOG(UDA_LOG_DEBUG, "ECONNRESET error!\n");
                 addIdamError(UDA_CODE_ERROR_TYPE, __func__, -2,
                              "ECONNRESET: The server program has crashed or closed the socket unexpectedly");
                 return -2;
-            } else {
-                if (errno == ENETUNREACH) {
-                    UDA_LOG(UDA_LOG_DEBUG, "ENETUNREACH error!\n");
-                    addIdamError(UDA_CODE_ERROR_TYPE, __func__, -3, "Server Unavailable: ENETUNREACH");
-                    return -3;
-                } else {
-                    UDA_LOG(UDA_LOG_DEBUG, "ECONNREFUSED error!\n");
-                    addIdamError(UDA_CODE_ERROR_TYPE, __func__, -4, "Server Unavailable: ECONNREFUSED");
-                    return -4;
-                }
+            } else if (errno == ENETUNREACH) {
+                UDA_LOG(UDA_LOG_DEBUG, "ENETUNREACH error!\n");
+                addIdamError(UDA_CODE_ERROR_TYPE, __func__, -3, "Server Unavailable: ENETUNREACH");
+                return -3;
+            } else if (errno == ECONNREFUSED) {
+                UDA_LOG(UDA_LOG_DEBUG, "ECONNREFUSED error!\n");
+                addIdamError(UDA_CODE_ERROR_TYPE, __func__, -4, "Server Unavailable: ECONNREFUSED");
+                return -4;
             }
+            addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "Error writing to the server socket");
+            return -1;
         }
-
-        update_select_params(*io_data->client_socket, &wfds, &tv);
-    }
-
-    /* UNIX version
-
-     Ignore the SIG_PIPE signal.  Standard behaviour terminates
-     the application with an error code of 141.  When the signal
-     is ignored, write calls (when there is no server process to
-     communicate with) will return with errno set to EPIPE
-    */
-
-#ifndef _WIN32
-    if ((OldSIGPIPEHandler = signal(SIGPIPE, SIG_IGN)) == SIG_ERR) {
-        addIdamError(UDA_CODE_ERROR_TYPE, __func__, -1, "Error attempting to ignore SIG_PIPE");
-        return -1;
-    }
-#endif
-
-    // Write to socket, checking for EINTR, as happens if called from IDL
-
-    while (BytesSent < (unsigned int)count) {
-#ifndef _WIN32
-        while (((rc = (int)write(*io_data->client_socket, buf, count)) == -1) && (errno == EINTR)) {}
-#else
-        while (((rc = send(*io_data->client_socket, buf , count, 0)) == SOCKET_ERROR) && (errno == EINTR)) {}
-#endif
-        BytesSent += rc;
-        buf += rc;
-    }
-
-// Restore the original SIGPIPE handler set by the application
-
-#ifndef _WIN32
-    if (signal(SIGPIPE, OldSIGPIPEHandler) == SIG_ERR) {
-        addIdamError(UDA_CODE_ERROR_TYPE, __func__, -1, "Error attempting to restore SIG_PIPE handler");
-        return -1;
+        bytes_sent += rc;
     }
-#endif
 
-    return rc;
+    return bytes_sent;
 }
 
 int uda::client::readin(void* iohandle, char* buf, int count)
 {
     int rc;
-    fd_set rfds;
-    struct timeval tv = {};
-
-    int maxloop = 0;
 
     auto io_data = reinterpret_cast<IoData*>(iohandle);
 
     errno = 0;
 
-    /* Wait till it is possible to read from socket */
-
-    update_select_params(*io_data->client_socket, &rfds, &tv);
-
-    while ((select(*io_data->client_socket + 1, &rfds, nullptr, nullptr, &tv) <= 0) && maxloop++ < MAXLOOP) {
-        update_select_params(*io_data->client_socket, &rfds, &tv);        // Keep trying ...
-    }
-
+    // The socket is blocking so recv waits until data arrives, or UDA_SOCKET_TIMEOUT passes if set, returning whatever
+    // is available up to count bytes.
     // Read from it, checking for EINTR, as happens if called from IDL
 
 #ifndef _WIN32
-    while (((rc = (int)read(*io_data->client_socket, buf, count)) == -1) && (errno == EINTR)) {}
+    while (((rc = (int)recv(*io_data->client_socket, buf, count, 0)) == -1) && (errno == EINTR)) {}
 #else
     while (((rc=recv(*io_data->client_socket, buf, count, 0)) == SOCKET_ERROR) && (errno == EINTR)) {}
 #endif
 
-    // As we have waited to be told that there is data to be read, if nothing
-    // arrives, then there must be an error
+    // As recv only returns once data has arrived, if nothing is read then the connection has closed or failed
 
-    if (!rc) {
+    if (rc <= 0) {
         rc = -1;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            UDA_LOG(UDA_LOG_DEBUG, "Socket receive timed out!\n");
+            addIdamError(UDA_CODE_ERROR_TYPE, __func__, rc, "Timed out waiting for the server (UDA_SOCKET_TIMEOUT)");
+            return rc;
+        }
         if (errno != 0 && errno != EINTR) {
-            addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, rc, "");
+            addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "");
         }
         addIdamError(UDA_CODE_ERROR_TYPE, __func__, rc, "No Data waiting at Socket when Data Expected!");
     }
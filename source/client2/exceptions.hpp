@@ -11,7 +11,7 @@
 namespace uda {
 namespace exceptions {
 
-class UDAException : std::exception
+class UDAException : public std::exception
 {
 public:
     UDAException(std::string_view msg)
@@ -45,7 +45,7 @@ protected:
     }
 };
 
-class ClientError: UDAException
+class ClientError : public UDAException
 {
 public:
     ClientError(std::string_view msg)
@@ -58,7 +58,7 @@ public:
     {}
 };
 
-class ServerError : UDAException
+class ServerError : public UDAException
 {
 public:
     ServerError(std::string_view msg)
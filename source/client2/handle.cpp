@@ -11,14 +11,22 @@ void free_handle(int handle)
 {
     // Free Heap Memory (Not the Data Blocks themselves: These will be re-used.)
 
-    char* cptr;
-    DIMS* ddims;
-    int rank;
-
     DATA_BLOCK* data_block = udaGetDataBlock(handle);
 
     if (data_block == nullptr) return;
 
+    uda::client::free_data_block(data_block);
+}
+
+/**
+ * Free the heap memory held by a data block received by the client and re-initialise it, leaving the block itself.
+ */
+void uda::client::free_data_block(DATA_BLOCK* data_block)
+{
+    char* cptr;
+    DIMS* ddims;
+    int rank;
+
     // Free Hierarchical structured data first
 
     switch (data_block->opaque_type) {
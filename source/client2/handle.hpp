@@ -3,10 +3,13 @@
 #ifndef UDA_SOURCE_CLIENT2_HANDLE_H
 #define UDA_SOURCE_CLIENT2_HANDLE_H
 
+#include <clientserver/udaStructs.h>
+
 namespace uda {
 namespace client {
 
 void free_handle(int handle);
+void free_data_block(DATA_BLOCK* data_block);
 
 }
 }
@@ -1,15 +1,71 @@
 #include "thread_client.hpp"
 
+#include <cstdlib>
+
 std::once_flag uda::client::ThreadClient::init_flag_ = {};
 uda::client::Client* uda::client::ThreadClient::instance_ = nullptr;
+std::atomic<int> uda::client::ThreadClient::per_thread_ = { -1 };
+std::mutex uda::client::ThreadClient::pool_mutex_ = {};
+std::vector<uda::client::Client*> uda::client::ThreadClient::pool_ = {};
+thread_local uda::client::ThreadClient::Lease uda::client::ThreadClient::lease_ = {};
 
 uda::client::Client& uda::client::ThreadClient::instance()
 {
+    if (per_thread()) {
+        if (lease_.client == nullptr) {
+            lease_.client = lease_client();
+        }
+        return *lease_.client;
+    }
     std::call_once(init_flag_, &ThreadClient::init_client);
     return *instance_;
 }
 
+/**
+ * Select per thread Clients (true) or the single process wide Client (false). Takes precedence over
+ * UDA_CLIENT_PER_THREAD and should be called before the first request: handles already obtained remain with the
+ * Client that returned them.
+ */
+void uda::client::ThreadClient::set_per_thread(bool per_thread)
+{
+    per_thread_ = per_thread ? 1 : 0;
+}
+
 void uda::client::ThreadClient::init_client()
 {
     instance_ = new Client;
 }
+
+bool uda::client::ThreadClient::per_thread()
+{
+    int mode = per_thread_;
+    if (mode < 0) {
+        const char* env = getenv("UDA_CLIENT_PER_THREAD");
+        int expected = -1;
+        per_thread_.compare_exchange_strong(expected, env != nullptr && atoi(env) != 0 ? 1 : 0);
+        mode = per_thread_;
+    }
+    return mode == 1;
+}
+
+uda::client::Client* uda::client::ThreadClient::lease_client()
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (!pool_.empty()) {
+            Client* client = pool_.back();
+            pool_.pop_back();
+            return client;
+        }
+    }
+    return new Client;
+}
+
+uda::client::ThreadClient::Lease::~Lease()
+{
+    if (client != nullptr) {
+        client->reset();        // Nothing set by this thread is carried over to the next
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        pool_.push_back(client);
+    }
+}
@@ -1,26 +1,56 @@
 #ifndef UDA_SOURCE_CLIENT2_PERTHREADSINGLETON_H
 #define UDA_SOURCE_CLIENT2_PERTHREADSINGLETON_H
 
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 #include "client.hpp"
 
 namespace uda {
 namespace client {
 
+//--------------------------------------------------------------------------------------------
+// The Client used by the C API of the calling thread.
+//
+// By default one Client is shared by the whole process. In per thread mode (udaSetClientPerThread, or the
+// UDA_CLIENT_PER_THREAD environment variable) each thread leases a Client of its own, with its own server connection,
+// XDR streams and data handles, so threads fetch data concurrently. A handle is then only valid on the thread that
+// obtained it. When a thread exits its Client is returned to a pool, connection still open, for reuse by the next new
+// thread.
+//
+// Properties (udaSetProperty) and the server host and port (udaPutServer) are per Client, so in per thread mode they
+// are per thread: settings made on the main thread do not reach the worker threads, each of which starts from the
+// environment (UDA_HOST, UDA_PORT, UDA_TIMEOUT, ...) and makes its own settings. A pooled Client is reset before it is
+// reused: the handles, properties and server of the thread that released it are not carried over.
+
 class ThreadClient
 {
 public:
     static uda::client::Client& instance();
+    static void set_per_thread(bool per_thread);
 
 private:
     ThreadClient() = default;
     ~ThreadClient() = default;
 
+    class Lease
+    {
+    public:
+        ~Lease();
+        Client* client = nullptr;
+    };
+
     static uda::client::Client* instance_;
     static std::once_flag init_flag_;
+    static std::atomic<int> per_thread_;
+    static std::mutex pool_mutex_;
+    static std::vector<Client*> pool_;
+    static thread_local Lease lease_;
 
     static void init_client();
+    static bool per_thread();
+    static Client* lease_client();
 };
 
 }
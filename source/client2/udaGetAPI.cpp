@@ -16,6 +16,22 @@ int udaGetAPI(const char *data_object, const char *data_source)
     }
 }
 
+/**
+ * As udaGetAPI but the data array is passed to the callback in chunks as it arrives and is not kept: the handle's data
+ * pointer is NULL afterwards while its count, type and dimensions are available as usual. A server that cannot stream
+ * (protocol version < 10) returns the array whole, which is then passed to the callback as a single chunk and kept.
+ */
+int udaGetStreamAPI(const char *data_object, const char *data_source, UDA_DATA_CHUNK_CALLBACK callback,
+                    void* user_data)
+{
+    auto& client = uda::client::ThreadClient::instance();
+    try {
+        return client.get_stream(data_object, data_source, callback, user_data);
+    } catch (uda::exceptions::UDAException& ex) {
+        return -1;
+    }
+}
+
 int udaGetBatchAPI(const char** data_signals, const char** data_sources, int count, int* handles)
 {
     auto& client = uda::client::ThreadClient::instance();
@@ -35,6 +51,32 @@ int udaGetBatchAPI(const char** data_signals, const char** data_sources, int cou
     }
 }
 
+/**
+ * As udaGetBatchAPI but each request is served separately, with its own handle and error state, as by a call to
+ * udaGetAPI for each. Requests are sent without waiting for the responses to earlier requests, so the round trip
+ * latency of the connection is paid about once rather than once per request. A request the server reports an error
+ * for has a handle of its own: udaGetErrorCode and udaGetErrorMsg return that request's error, whatever the later
+ * requests returned. The handle of a request that could not be sent or received, which ends the batch, is -1.
+ */
+int udaGetPipelinedAPI(const char** data_signals, const char** data_sources, int count, int* handles)
+{
+    auto& client = uda::client::ThreadClient::instance();
+    try {
+        std::vector<std::pair<std::string, std::string>> requests;
+        requests.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            requests.emplace_back(std::make_pair(data_signals[i], data_sources[i]));
+        }
+        auto handle_vec = client.get_pipelined(requests);
+        for (int i = 0; i < count; ++i) {
+            handles[i] = handle_vec[i];
+        }
+        return 0;
+    } catch (uda::exceptions::UDAException& ex) {
+        return -1;
+    }
+}
+
 int udaGetAPIWithHost(const char *data_object, const char *data_source, const char *host, int port)
 {
     auto& client = uda::client::ThreadClient::instance();
@@ -1,6 +1,7 @@
 #ifndef UDA_CLIENT_UDAGETAPI_H
 #define UDA_CLIENT_UDAGETAPI_H
 
+#include <stdint.h>
 #include <clientserver/export.h>
 
 #ifdef __cplusplus
@@ -14,8 +15,18 @@ extern "C" {
 #  define idamGetBatchAPIWithHost idamGetBatchAPIWithHostFat
 #endif
 
+/**
+ * Called with each chunk of a data array received by udaGetStreamAPI: count elements of the handle's data type, starting
+ * at element offset. The chunk is only valid for the duration of the call. A non-zero return stops further chunks of
+ * this array being delivered.
+ */
+typedef int (*UDA_DATA_CHUNK_CALLBACK)(int handle, const void* data, int64_t offset, int64_t count, void* user_data);
+
 LIBRARY_API int udaGetAPI(const char *data_object, const char *data_source);
+LIBRARY_API int udaGetStreamAPI(const char *data_object, const char *data_source, UDA_DATA_CHUNK_CALLBACK callback,
+                                void* user_data);
 LIBRARY_API int udaGetBatchAPI(const char** uda_signals, const char** sources, int count, int* handles);
+LIBRARY_API int udaGetPipelinedAPI(const char** uda_signals, const char** sources, int count, int* handles);
 LIBRARY_API int udaGetAPIWithHost(const char *data_object, const char *data_source, const char *host, int port);
 LIBRARY_API int udaGetBatchAPIWithHost(const char** uda_signals, const char** sources, int count, int* handles, const char* host, int port);
 
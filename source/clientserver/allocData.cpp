@@ -44,15 +44,12 @@ int allocArray(int data_type, size_t n_data, char** ap)
 }
 
 /**
- * Main routine for allocating memory for Data and Errors
+ * Allocate memory for the Dimension structures only, e.g. when the data array is streamed
  * @param data_block
  * @return
  */
-int allocData(DATA_BLOCK* data_block)
+int allocDimBlocks(DATA_BLOCK* data_block)
 {
-    //------------------------------------------------------------------------
-    // Allocate Memory for data Dimensions
-
     if (data_block->rank > 0) {
         data_block->dims = (DIMS*)malloc(data_block->rank * sizeof(DIMS));
         if (data_block->dims == nullptr) {
@@ -63,11 +60,29 @@ int allocData(DATA_BLOCK* data_block)
         }
     }
 
+    return 0;
+}
+
+/**
+ * Main routine for allocating memory for Data and Errors
+ * @param data_block
+ * @return
+ */
+int allocData(DATA_BLOCK* data_block)
+{
+    //------------------------------------------------------------------------
+    // Allocate Memory for data Dimensions
+
+    int err = allocDimBlocks(data_block);
+    if (err != 0) {
+        return err;
+    }
+
     //------------------------------------------------------------------------
     // Allocate Memory for data and errors
 
-    unsigned int ndata;
-    if ((ndata = (unsigned int)data_block->data_n) == 0) {
+    size_t ndata;
+    if ((ndata = (size_t)data_block->data_n) == 0) {
         // Insufficient Data to Allocate!
         return 1;
     }
@@ -91,7 +106,7 @@ int allocData(DATA_BLOCK* data_block)
 
     UDA_LOG(UDA_LOG_DEBUG, "allocData :\n");
     UDA_LOG(UDA_LOG_DEBUG, "rank      : %d\n", data_block->rank);
-    UDA_LOG(UDA_LOG_DEBUG, "count     : %d\n", data_block->data_n);
+    UDA_LOG(UDA_LOG_DEBUG, "count     : %lld\n", (long long)data_block->data_n);
     UDA_LOG(UDA_LOG_DEBUG, "data_type : %d\n", data_block->data_type);
     UDA_LOG(UDA_LOG_DEBUG, "error_type: %d\n", data_block->error_type);
     UDA_LOG(UDA_LOG_DEBUG, "data  != nullptr: %d\n", db != nullptr);
@@ -131,14 +146,14 @@ int allocDim(DATA_BLOCK* data_block)
     //
     // It may or may not be called by a Server Plugin.
 
-    unsigned int ndata;
+    size_t ndata;
     char* db = nullptr;
     char* ebh = nullptr;
     char* ebl = nullptr;
 
     for (unsigned int i = 0; i < data_block->rank; i++) {
 
-        ndata = (unsigned int)data_block->dims[i].dim_n;
+        ndata = (size_t)data_block->dims[i].dim_n;
 
         if (ndata == 0) return 1;   // Insufficient Data to Allocate!
 
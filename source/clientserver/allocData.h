@@ -13,6 +13,7 @@ extern "C" {
 LIBRARY_API int allocArray(int data_type, size_t ndata, char** ap);
 LIBRARY_API int allocData(DATA_BLOCK* data_block);
 LIBRARY_API int allocDim(DATA_BLOCK* data_block);
+LIBRARY_API int allocDimBlocks(DATA_BLOCK* data_block);
 LIBRARY_API int allocPutData(PUTDATA_BLOCK* putData);
 LIBRARY_API void addIdamPutDataBlockList(PUTDATA_BLOCK* putDataBlock, PUTDATA_BLOCK_LIST* putDataBlockList);
 
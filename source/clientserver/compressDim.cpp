@@ -1,8 +1,11 @@
 #include "compressDim.h"
 
 #include <cfloat>
+#include <climits>
 #include <cstdlib>
 #include <cstdint>
+#include <type_traits>
+#include <vector>
 
 #include <clientserver/udaTypes.h>
 
@@ -19,15 +22,109 @@ template <typename T> T Precision<T>::precision = 0;
 template <> float Precision<float>::precision = FLT_EPSILON;
 template <> double Precision<double>::precision = DBL_EPSILON;
 
+// Do consecutive differences agree to within the precision of the type? Integer differences must be equal: their
+// difference can overflow the type
 template <typename T>
-int compress(DIMS* ddim)
+bool sameDiff(T diff, T prev_diff)
+{
+    if (std::is_integral<T>::value) {
+        return diff == prev_diff;
+    }
+    T abs_diff = diff < prev_diff ? (prev_diff - diff) : (diff - prev_diff);
+    return abs_diff <= Precision<T>::precision;
+}
+
+/**
+ * Piecewise regular data, e.g. a timebase with gaps or changes of sampling rate, is compressed into domains each of
+ * a starting value, an interval and a number of values (method 1). Consecutive differences within a domain must agree
+ * to the same precision as the single domain of method 0. Only used if the domains take at most half the space of
+ * the data.
+ */
+template <typename T>
+int compressDomains(DIMS* ddim)
+{
+    const T* dim_data = (T*)ddim->dim;
+    int64_t ndata = ddim->dim_n;
+
+    size_t max_domains = (ndata * sizeof(T)) / (2 * (sizeof(int) + 2 * sizeof(T)));
+    if (max_domains < 2) {
+        return 1;
+    }
+
+    std::vector<int64_t> starts;
+    int64_t start = 0;
+
+    while (start < ndata) {
+        if (starts.size() == max_domains) {
+            return 1;       // Too irregular to be worthwhile
+        }
+        starts.push_back(start);
+
+        int64_t end = start + 1;
+        if (end < ndata) {
+            T prev_diff = dim_data[end] - dim_data[start];
+            for (++end; end < ndata; ++end) {
+                T diff = dim_data[end] - dim_data[end - 1];
+                if (!sameDiff(diff, prev_diff)) {
+                    break;
+                }
+                prev_diff = diff;
+            }
+        }
+        if (end - start > INT_MAX) {
+            return 1;       // Domain length does not fit the sams field
+        }
+        start = end;
+    }
+
+    size_t udoms = starts.size();
+
+    auto sams = (int*)malloc(udoms * sizeof(int));
+    auto offs = (T*)malloc(udoms * sizeof(T));
+    auto ints = (T*)malloc(udoms * sizeof(T));
+
+    if (sams == nullptr || offs == nullptr || ints == nullptr) {
+        free(sams);
+        free(offs);
+        free(ints);
+        return 1;
+    }
+
+    for (size_t i = 0; i < udoms; i++) {
+        int64_t first = starts[i];
+        int64_t count = (i + 1 < udoms ? starts[i + 1] : ndata) - first;
+        sams[i] = (int)count;
+        offs[i] = dim_data[first];
+        if (count == 1) {
+            ints[i] = 0;
+        } else if (std::is_floating_point<T>::value) {
+            ints[i] = (dim_data[first + count - 1] - dim_data[first]) / (count - 1);      // Average difference
+        } else {
+            ints[i] = (T)(dim_data[first + 1] - dim_data[first]);      // Exact: wraps consistently with decompression
+        }
+    }
+
+    ddim->compressed = 1;
+    ddim->dim0 = dim_data[0];
+    ddim->diff = 0;
+    ddim->method = 1;
+    ddim->udoms = (unsigned int)udoms;
+    ddim->sams = sams;
+    ddim->offs = (char*)offs;
+    ddim->ints = (char*)ints;
+
+    return 0;
+}
+
+template <typename T>
+int compress(DIMS* ddim, bool domains)
 {
     T* dim_data = (T*)ddim->dim;
     if (dim_data == nullptr) {
         return 1;
     }
 
-    int ndata = ddim->dim_n;
+    int64_t ndata = ddim->dim_n;
 
     //no need to compress if the data is already compressed or if there are less or equal to 2 elements
     if (ndata <= 3 || ddim->compressed == 1) {
@@ -35,14 +132,13 @@ int compress(DIMS* ddim)
         return 1;
     }
     T prev_diff = dim_data[1] - dim_data[0];
-    T mean_diff = (dim_data[ndata - 1] - dim_data[0]) / (ndata - 1);
-    T precision = Precision<T>::precision;
+    T mean_diff = std::is_integral<T>::value ? prev_diff        // Exact: the average is wrong if the values wrap
+                                             : (T)((dim_data[ndata - 1] - dim_data[0]) / (ndata - 1));
 
     bool constant = true;
-    for (int i = 1; i < ndata; i++) {
+    for (int64_t i = 1; i < ndata; i++) {
         T diff = dim_data[i] - dim_data[i - 1];
-        T abs_diff = diff < prev_diff ? (prev_diff - diff) : (diff - prev_diff);
-        if (abs_diff > precision) {
+        if (!sameDiff(diff, prev_diff)) {
             constant = false;
             break;
         }
@@ -51,7 +147,7 @@ int compress(DIMS* ddim)
 
     if (!constant) {
         ddim->compressed = 0;
-        return 1;        // Data not regular
+        return domains ? compressDomains<T>(ddim) : 1;        // Data not regular: may be piecewise regular
     }
 
     ddim->compressed = 1;
@@ -65,7 +161,7 @@ int compress(DIMS* ddim)
 template <typename T>
 int decompress(DIMS* ddim)
 {
-    int ndata = ddim->dim_n;
+    int64_t ndata = ddim->dim_n;
 
     if (ddim->dim == nullptr) {
         if ((ddim->dim = (char*)malloc(ndata * sizeof(T))) == nullptr) {
@@ -76,12 +172,12 @@ int decompress(DIMS* ddim)
 
     T d0 = (T)ddim->dim0;        // Default Compression Method
     T diff = (T)ddim->diff;
-    int count = 0;
+    int64_t count = 0;
 
     switch (ddim->method) {
         case 0:
             dim_data[0] = d0;
-            for (int i = 1; i < ndata; i++) {
+            for (int64_t i = 1; i < ndata; i++) {
                 dim_data[i] = dim_data[i - 1] + diff;
             }
             break;
@@ -118,11 +214,15 @@ int decompress(DIMS* ddim)
  *
  * Out:             DIMS* ->dim0            Starting value
  *                  DIMS* ->diff            Value increment
- *                  DIMS* ->method          0 for naive compression
+ *                  DIMS* ->method          0 for naive compression, 1 for piecewise regular domains
+ *                  DIMS* ->udoms           Number of domains (method 1)
+ *                  DIMS* ->sams, offs, ints    Length, starting value and increment of each domain (method 1)
  *                  DIMS* ->compressed      1 if compression performed
  *
  * Notes: If the dimensional data is regular it can be compressed into three numbers: A starting value, a step value
  * and the number of data points. The first two of these are cast as doubles to preserve the highest level of accuracy.
+ * Otherwise, if the data is regular over a few ranges, e.g. a timebase with gaps, it is compressed into a set of
+ * domains each with their own starting value, step and number of points.
  */
 int compressDim(DIMS* ddim)
 {
@@ -133,27 +233,27 @@ int compressDim(DIMS* ddim)
 
     switch (ddim->data_type) {
         case UDA_TYPE_CHAR:
-            return compress<char>(ddim);
+            return compress<char>(ddim, true);
         case UDA_TYPE_SHORT:
-            return compress<short>(ddim);
+            return compress<short>(ddim, true);
         case UDA_TYPE_INT:
-            return compress<int>(ddim);
+            return compress<int>(ddim, true);
         case UDA_TYPE_LONG:
-            return compress<long>(ddim);
+            return compress<long>(ddim, true);
 //        case UDA_TYPE_LONG64:
 //            return compress<int64_t>(ddim);
         case UDA_TYPE_FLOAT:
-            return compress<float>(ddim);
+            return compress<float>(ddim, true);
         case UDA_TYPE_DOUBLE:
-            return compress<double>(ddim);
+            return compress<double>(ddim, true);
         case UDA_TYPE_UNSIGNED_CHAR:
-            return compress<unsigned char>(ddim);
+            return compress<unsigned char>(ddim, true);
         case UDA_TYPE_UNSIGNED_SHORT:
-            return compress<unsigned short>(ddim);
+            return compress<unsigned short>(ddim, true);
         case UDA_TYPE_UNSIGNED_INT:
-            return compress<unsigned int>(ddim);
+            return compress<unsigned int>(ddim, true);
         case UDA_TYPE_UNSIGNED_LONG:
-            return compress<unsigned long>(ddim);
+            return compress<unsigned long>(ddim, false);        // No domain transfer for this type
 //        case UDA_TYPE_UNSIGNED_LONG64:
 //            return compress<uint64_t>(ddim);
         default:
@@ -6,7 +6,7 @@
 #include <logging/logging.h>
 #include <clientserver/stringUtils.h>
 
-static std::vector<UDA_ERROR> udaerrorstack;
+static thread_local std::vector<UDA_ERROR> udaerrorstack;     // Per thread: each thread may run its own client
 
 int udaNumErrors()
 {
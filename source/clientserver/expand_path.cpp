@@ -18,7 +18,9 @@
 #include <cerrno>
 
 #ifndef _WIN32
+#  include <climits>
 #  include <unistd.h>
+#  include <sys/stat.h>
 #else
 #  include <Windows.h>
 #endif
@@ -50,13 +52,94 @@ void expandFilePath(char *path) {
 #else
 
 #include <boost/algorithm/string.hpp>
-#include <fmt/format.h>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #define MAXPATHSUBS         10
 #define MAXPATHSUBSLENGTH   256
+#define MAXPATHCACHE        256     // Maximum number of resolved directory names remembered
+#define PATHCACHETTL        10      // Lifetime (secs) of a remembered resolved directory name
+
+#ifndef _WIN32
+
+namespace {
+
+struct ResolvedPath {
+    std::string path;
+    time_t expires;
+};
+
+/**
+ * Resolve a directory path to its canonical absolute form: relative elements and symbolic links are resolved, as seen
+ * by changing to the directory. Resolved names are remembered for a short time to avoid repeating the file system
+ * lookups for every request. They are remembered by absolute path, as a relative path names another directory once
+ * the working directory changes.
+ *
+ * @param path The directory path to resolve.
+ * @param cwd The current working directory, if already known, otherwise nullptr.
+ * @param resolved The resolved path. The string is pre-allocated with length STRING_LENGTH
+ * @return 0 if the path was resolved, otherwise the errno value of the failure.
+ */
+int resolve_directory(const char* path, const char* cwd, char* resolved)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::string, ResolvedPath> cache;
+
+    std::string absolute = path;
+    if (path[0] != '/') {
+        char work[PATH_MAX];
+        errno = 0;
+        if (cwd == nullptr && (cwd = getcwd(work, sizeof(work))) == nullptr) {
+            return errno != 0 ? errno : ENOENT;
+        }
+        absolute = std::string{ cwd } + "/" + path;
+    }
+
+    time_t now = time(nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = cache.find(absolute);
+        if (found != cache.end() && found->second.expires > now) {
+            copyString(found->second.path.c_str(), resolved, STRING_LENGTH);
+            return 0;
+        }
+    }
+
+    char work[PATH_MAX];
+    errno = 0;
+    if (realpath(absolute.c_str(), work) == nullptr) {
+        return errno != 0 ? errno : ENOENT;
+    }
+
+    struct stat status = {};
+    if (stat(work, &status) != 0 || !S_ISDIR(status.st_mode)) {
+        return ENOTDIR;
+    }
+
+    if (strlen(work) >= STRING_LENGTH) {
+        return ENAMETOOLONG;
+    }
+
+    copyString(work, resolved, STRING_LENGTH);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cache.size() >= MAXPATHCACHE) {
+        cache.clear();
+    }
+    cache[absolute] = { work, now + PATHCACHETTL };
+
+    return 0;
+}
+
+} // anon namespace
+
+#endif // !_WIN32
 
 /**
- * The workstation (client host) name is obtained using the operating system command 'hostname'.
+ * The workstation (client host) name is obtained from the operating system, once per process.
  *
  * @param host The name of the client host workstation. The string is pre-allocated with length STRING_LENGTH
  * @return A pointer to the host string (Identical to the argument).
@@ -70,6 +153,18 @@ char* hostid(char* host)
     return host;
 #else
 
+    // The host name is identified once: later calls return the remembered name
+
+    static std::mutex mutex;
+    static std::string host_name;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!host_name.empty()) {
+        copyString(host_name.c_str(), host, STRING_LENGTH);
+        return host;
+    }
+
     host[0] = '\0';
 
 #ifndef USEHOSTDOMAINNAME
@@ -96,6 +191,8 @@ char* hostid(char* host)
 
     if (host[0] == '\0') {
         addIdamError(UDA_CODE_ERROR_TYPE, "hostid", 999, "Unable to Identify the Host Name");
+    } else {
+        host_name = host;
     }
     return host;
 
@@ -284,45 +381,15 @@ int linkReplacement(char* path)
     return path != nullptr; // No check for windows
 #  else
 
-    int err;
-    FILE* ph = nullptr;
-    char* p;
-
     //------------------------------------------------------------------------------------
-    //! Dereference path links using a command pipe: Ignore any errors
-    //
-    // If the user has embedded linux commands within the source string, they will be exposed here
-    // within the client's environment - not the server's.
-
-    std::string cmd = fmt::format("ls -l {} 2>&1;", path);
-
-    errno = 0;
-    if ((ph = popen(cmd.c_str(), "r")) == nullptr) {
-        if (errno != 0) addIdamError(UDA_SYSTEM_ERROR_TYPE, "linkReplacement", errno, "");
-        err = 1;
-        addIdamError(UDA_CODE_ERROR_TYPE, "linkReplacement", err, "Unable to Dereference Symbolic links");
-        path[0] = '\0';
-        return err;
-    }
+    //! Dereference the path link: Ignore any errors. Accept only if it is Not a Relative path
 
-    char buffer[STRING_LENGTH];
-    if (!feof(ph)) {
-        if (fgets(buffer, STRING_LENGTH - 1, ph) == nullptr) {
-            UDA_THROW_ERROR(999, "failed to read line from command");
-        }
-    }
-    pclose(ph);
+    char target[STRING_LENGTH];
+    ssize_t length = readlink(path, target, STRING_LENGTH - 1);
 
-    //------------------------------------------------------------------------------------
-    //! Extract the Dereferenced path. Accept only if it is Not a Relative path
-
-    if ((p = strstr(buffer, " -> ")) != nullptr) {
-        if (p[4] == '/') {
-            strcpy(path, p + 4);
-            convertNonPrintable2(path);
-            TrimString(path);
-            //expandFilePath(path);
-        }
+    if (length > 0 && target[0] == '/') {
+        target[length] = '\0';
+        strcpy(path, target);
     }
 
     return 0;
@@ -376,7 +443,6 @@ int expandFilePath(char* path, const ENVIRONMENT* environment)
     char host[STRING_LENGTH];
 #endif
     char cwd[STRING_LENGTH];
-    char ocwd[STRING_LENGTH];        // Current Working Directory
     char opath[STRING_LENGTH];        // Original Path string
     char work[STRING_LENGTH];
     char work1[STRING_LENGTH];
@@ -520,8 +586,6 @@ int expandFilePath(char* path, const ENVIRONMENT* environment)
             UDA_THROW_ERROR(999, "Cannot resolve the Current Working Directory! Unable to resolve full file names.");
         }
 
-        strcpy(ocwd, cwd);
-
         //! Does the path NOT contain a path directory separator character => filename only so prepend the CWD and return
 
         if ((fp = strrchr(path, '/')) == nullptr) {        // Search backwards - extract filename
@@ -544,7 +608,7 @@ int expandFilePath(char* path, const ENVIRONMENT* environment)
         strcpy(file, &fp[1]);                // Filename
         fp[1] = '\0';                    // Split the path string: path now contains directory only
 
-        //! Does the Path contain with an Environment variable (Not resolved by the function chdir!)
+        //! Does the Path contain with an Environment variable (Not resolved by the file system!)
 
         fp = nullptr;
         lpath = (int)strlen(path);
@@ -595,51 +659,20 @@ int expandFilePath(char* path, const ENVIRONMENT* environment)
             }
         }
 
-        /* Change to the File's Directory (will resolve relative path elements ~/./../$envVariable/ as well as links)
+        /* Resolve the File's Directory (relative path elements ./../$envVariable/ as well as links), as seen by
+         * changing to the directory
          *
          * If an error occurs, either the directory doesn't exist or the path is not a file path!
          * If the path contains an environment variable, then resolved server side
          */
 
-        if (chdir(path) != 0) {
-            // Ensure the Original WD
-            if (chdir(ocwd) != 0) {
-                UDA_THROW_ERROR(999, "Failed to chdir back to original working directory");
-            };
+        if (resolve_directory(path, cwd, work1) != 0) {
             strcpy(path, opath);        // Return to the Original path name
             UDA_LOG(UDA_LOG_DEBUG, "Unable to identify the Directory of the file: %s\n"
                                    "The server will know if a true error exists: Plugin & Environment dependent", path);
             return 0;
         }
 
-        //! The Current Working Directory is the resolved directory name
-
-        errno = 0;
-
-        pcwd = getcwd(cwd, lcwd);
-
-        if (errno != 0) {
-            err = 998;
-            addIdamError(UDA_SYSTEM_ERROR_TYPE, "expand_path", errno, "Cannot resolve the Current Working Directory!");
-            addIdamError(UDA_CODE_ERROR_TYPE, "expand_path", err, "Unable to resolve full file names.");
-            return err;
-        }
-
-        if (pcwd == nullptr) {
-            UDA_THROW_ERROR(998, "Cannot resolve the Current Working Directory! Unable to resolve full file names.");
-        }
-
-        strcpy(work1, cwd);
-
-        //! Return to the Original Working Directory
-
-        if (chdir(ocwd) != 0) {
-            err = 999;
-            addIdamError(UDA_SYSTEM_ERROR_TYPE, "expand_path", errno, "Unable to Return to the Working Directory!");
-            addIdamError(UDA_CODE_ERROR_TYPE, "expand_path", err, "Unable to resolve full file names.");
-            return err;
-        }
-
         //! Prepend the expanded/resolved directory name to the File Name
 
         snprintf(path, STRING_LENGTH, "%s/%s", work1, file);        // Prepend the path to the filename
@@ -717,12 +750,9 @@ char* pathid(char* path)
     return path;        // No check for windows
 #else
 
-    char* p;
-    char work[STRING_LENGTH];        // Are these consistent with the system MAX_PATH?
-    char pwd[STRING_LENGTH];
-    strcpy(work, path);
+    char work[STRING_LENGTH];
 
-    // the path string may contain malign embedded linux commands: is chdir secure?
+    // the path string may contain malign embedded linux commands
     // basic check
 
     if (!IsLegalFilePath(path)) {
@@ -731,28 +761,18 @@ char* pathid(char* path)
         return path;
     }
 
-    if (getcwd(pwd, STRING_LENGTH - 1) != nullptr) {
-        errno = 0;
-        if (chdir(path) == 0) {
-            if ((p = getcwd(pwd, STRING_LENGTH - 1)) != nullptr) {
-                strcpy(path, p);
-                if (chdir(pwd) != 0) {
-                    addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "");
-                    addIdamError(UDA_CODE_ERROR_TYPE, __func__, 999, "The directory path is not available");
-                }
-                TrimString(path);
-                LeftTrimString(path);
-                return path;
-            }
-        } else {
-            if (errno == EACCES) {
-                addIdamError(UDA_SYSTEM_ERROR_TYPE, "pathid", errno, "");
-                addIdamError(UDA_CODE_ERROR_TYPE, "pathid", 999, "The directory path is not available");
-            } else if (errno == ENOENT || errno == ENOTDIR) {
-                addIdamError(UDA_SYSTEM_ERROR_TYPE, "pathid", errno, "");
-                addIdamError(UDA_CODE_ERROR_TYPE, "pathid", 999, "The directory path does not exist");
-            }
-        }
+    int rc = resolve_directory(path, nullptr, work);
+    if (rc == 0) {
+        strcpy(path, work);
+        TrimString(path);
+        LeftTrimString(path);
+        return path;
+    } else if (rc == EACCES) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, "pathid", rc, "");
+        addIdamError(UDA_CODE_ERROR_TYPE, "pathid", 999, "The directory path is not available");
+    } else if (rc == ENOENT || rc == ENOTDIR) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, "pathid", rc, "");
+        addIdamError(UDA_CODE_ERROR_TYPE, "pathid", 999, "The directory path does not exist");
     }
     path[0] = '\0';
     return path;
@@ -8,7 +8,7 @@
 extern "C" {
 #endif
 
-/*! The workstation (client host) name is obtained using the operating system command 'hostname'.
+/*! The workstation (client host) name is obtained from the operating system, once per process.
 
 @param host The name of the client host workstation. The string is pre-allocated with length STRING_LENGTH
 @returns A pointer to the host string (Identical to the argument).
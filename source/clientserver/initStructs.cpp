@@ -109,6 +109,9 @@ void initDataBlockList(DATA_BLOCK_LIST* str)
 {
     str->count = 0;
     str->data = nullptr;
+    str->native_data = 0;
+    str->stream_data = 0;
+    str->compress_data = 0;
 }
 
 void initDataBlock(DATA_BLOCK* str)
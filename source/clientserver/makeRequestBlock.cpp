@@ -1,11 +1,17 @@
 #include "makeRequestBlock.h"
 
 #include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <boost/algorithm/string.hpp>
 
 #if defined(__GNUC__)
+#  include <fcntl.h>
 #  include <unistd.h>
+#  include <sys/stat.h>
 #endif
 
 #if defined(__GNUC__)
@@ -43,6 +49,231 @@ static int generic_request_test(const char* source, REQUEST_DATA* request);
 
 static int extract_subset(REQUEST_DATA* request);
 
+namespace {
+
+#ifndef _WIN32
+
+// Number of bytes read from the start of a file to identify its format
+constexpr size_t FileSignatureLength = 4096;
+
+// Number of bytes from the start of an HDF5 file searched for the netCDF-4 attribute names: the root group's object
+// header normally lies within the first few KB, but follows any user block and may hold many attributes
+constexpr size_t NetCDF4MarkerSearchLength = 64 * 1024;
+
+// Maximum number of file paths with remembered formats
+constexpr size_t FileFormatMemoSize = 256;
+
+/**
+ * File format signatures: the magic bytes found at an offset from the start of a file, and the file extension
+ * whose format they identify. Tested in order - add new formats here.
+ */
+struct FileSignature {
+    size_t offset;
+    const char* magic;
+    size_t length;
+    const char* extension;
+};
+
+const FileSignature file_signatures[] = {
+    { 0, "CDF\x01", 4, " nc" },                                 // netCDF classic
+    { 0, "CDF\x02", 4, " nc" },                                 // netCDF 64-bit offset
+    { 0, "CDF\x05", 4, " nc" },                                 // netCDF 64-bit data (CDF5)
+    { 0, "\x89HDF\r\n\x1a\n", 8, " hf" },                       // HDF5 (netCDF-4 files are tested below)
+    { 512, "\x89HDF\r\n\x1a\n", 8, " hf" },                     // HDF5 with a user block
+    { 1024, "\x89HDF\r\n\x1a\n", 8, " hf" },
+    { 2048, "\x89HDF\r\n\x1a\n", 8, " hf" },
+    { 0, "<?xml", 5, " xml" },                                  // XML document
+};
+
+// Attribute names written by the netCDF library into the root group of a netCDF-4 (HDF5) file
+const char* netcdf4_markers[] = { "_NCProperties", "_Netcdf4Dimid", "_Netcdf4Coordinates", "_nc3_strict" };
+
+struct FileFormatMemo {
+    dev_t device;
+    ino_t inode;
+    off_t size;
+    time_t modified;
+    const char* extension;
+};
+
+bool contains(const char* buffer, size_t length, const char* text)
+{
+    size_t text_length = strlen(text);
+    for (size_t i = 0; i + text_length <= length; ++i) {
+        if (buffer[i] == text[0] && memcmp(&buffer[i], text, text_length) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Legacy IDA files have no signature: test whether the IDA dump utility (UDA_DUMP_IDA) can open the file.
+ */
+bool is_ida_file(const char* source)
+{
+    char* env = getenv("UDA_DUMP_IDA");
+    if (env == nullptr) {
+        return false;
+    }
+
+    std::string cmd = fmt::format("{} -h {} 2>/dev/null 2>/dev/null", env, source);
+    errno = 0;
+    FILE* ph = popen(cmd.c_str(), "r");
+    if (ph == nullptr) {
+        return false;
+    }
+
+    // IDA3 interface version V3.13 with file structure IDA3.1, Build, Compiled without ..., Opening ida file, then
+    // ida_open error if the file is not an IDA file
+
+    char buffer[STRING_LENGTH] = "";
+    for (int i = 0; i < 5 && fgets(buffer, STRING_LENGTH - 1, ph) != nullptr; ++i) {}
+    pclose(ph);
+
+    convertNonPrintable2(buffer);
+    LeftTrimString(buffer);
+    TrimString(buffer);
+
+    return strncmp(buffer, "ida_open error", 14) != 0;
+}
+
+/**
+ * Test whether an HDF5 file was written by the netCDF library: search the start of the file for the attribute names
+ * netCDF-4 writes to the root group. If none is found the file may still be netCDF-4 with its root group further in,
+ * so use the netCDF dump utility (UDA_DUMP_NETCDF) if one is configured, as before the search.
+ */
+bool is_netcdf4_file(int fd, const char* source, const char* buffer, size_t count)
+{
+    auto has_marker = [](const char* data, size_t length) {
+        for (const char* marker : netcdf4_markers) {
+            if (contains(data, length, marker)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (has_marker(buffer, count)) {
+        return true;
+    }
+
+    if (count == FileSignatureLength) {
+        std::vector<char> more(NetCDF4MarkerSearchLength);
+        memcpy(more.data(), buffer, count);
+        ssize_t extra = pread(fd, more.data() + count, more.size() - count, (off_t)count);
+        if (extra > 0 && has_marker(more.data(), count + (size_t)extra)) {
+            return true;
+        }
+    }
+
+    char* env = getenv("UDA_DUMP_NETCDF");
+    if (env == nullptr) {
+        return false;
+    }
+
+    std::string cmd = fmt::format("{} -h {} 2>/dev/null | head -c10 2>/dev/null", env, source);
+    FILE* ph = popen(cmd.c_str(), "r");
+    if (ph == nullptr) {
+        return false;
+    }
+
+    char output[STRING_LENGTH] = "";
+    if (fgets(output, STRING_LENGTH - 1, ph) == nullptr) {
+        output[0] = '\0';
+    }
+    pclose(ph);
+
+    convertNonPrintable2(output);
+    LeftTrimString(output);
+    TrimString(output);
+
+    return strncmp(output, "netcdf ", 7) == 0;    // ncdump -h starts with: netcdf <name> {
+}
+
+/**
+ * Identify the format of a file without an extension from the signature at the start of the file.
+ *
+ * Returns the file extension of the identified format (with a leading character, as returned by strrchr for a '.'),
+ * a blank extension if the format is not known, or nullptr if the file cannot be read. The formats of recently tested
+ * files are remembered while the files are unchanged.
+ */
+const char* file_signature_format(const char* source)
+{
+    static std::mutex memo_mutex;
+    static std::unordered_map<std::string, FileFormatMemo> memo;
+
+    const char* blank = "   ";
+
+    errno = 0;
+    int fd = open(source, O_RDONLY);
+    if (fd < 0) {
+        if (errno != 0) addIdamError(UDA_SYSTEM_ERROR_TYPE, "sourceFileFormatTest", errno, "");
+        addIdamError(UDA_CODE_ERROR_TYPE, "sourceFileFormatTest", 999, "Unable to Identify the File's Format");
+        return nullptr;
+    }
+
+    // The memo is keyed on the identity of the file opened, so a path replaced since it was tested is read again
+
+    struct stat status = {};
+    bool known = fstat(fd, &status) == 0;
+    if (known) {
+        std::lock_guard<std::mutex> lock(memo_mutex);
+        auto found = memo.find(source);
+        if (found != memo.end()) {
+            const FileFormatMemo& entry = found->second;
+            if (entry.device == status.st_dev && entry.inode == status.st_ino && entry.size == status.st_size
+                    && entry.modified == status.st_mtime) {
+                close(fd);
+                return entry.extension;
+            }
+        }
+    }
+
+    char buffer[FileSignatureLength];
+    ssize_t count = pread(fd, buffer, sizeof(buffer), 0);
+
+    if (count < 0) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, "sourceFileFormatTest", errno, "");
+        addIdamError(UDA_CODE_ERROR_TYPE, "sourceFileFormatTest", 999, "Unable to Identify the File's Format");
+        close(fd);
+        return nullptr;
+    }
+
+    const char* extension = blank;
+    for (const auto& signature : file_signatures) {
+        if (signature.offset + signature.length <= (size_t)count
+                && memcmp(&buffer[signature.offset], signature.magic, signature.length) == 0) {
+            extension = signature.extension;
+            break;
+        }
+    }
+
+    if (STR_EQUALS(extension, " hf")) {
+        if (is_netcdf4_file(fd, source, buffer, (size_t)count)) {
+            extension = " nc";    // netCDF file written to an HDF5 file
+        }
+    } else if (extension == blank && is_ida_file(source)) {
+        extension = " 99";    // Legacy IDA file
+    }
+
+    close(fd);
+
+    if (known) {
+        std::lock_guard<std::mutex> lock(memo_mutex);
+        if (memo.size() >= FileFormatMemoSize) {
+            memo.clear();
+        }
+        memo[source] = { status.st_dev, status.st_ino, status.st_size, status.st_mtime, extension };
+    }
+
+    return extension;
+}
+
+#endif // !_WIN32
+
+} // anon namespace
+
 static int find_plugin_id_by_format(const char* format, const PLUGINLIST* plugin_list)
 {
     for (int i = 0; i < plugin_list->count; i++) {
@@ -791,127 +1022,14 @@ int source_file_format_test(const char* source, REQUEST_DATA* request, PLUGINLIS
 
     if ((test = strrchr(source, '.')) == nullptr) {
 
-        // No extension => test the first line of file, e.g. head -c10 <file>, but both netcdf and hdf5 use the same label HDF!
+        // No extension => identify the format from the signature (magic bytes) at the start of the file
 
 #ifndef _WIN32
-        const char* nc = " nc";
-        const char* hf = " hf";
-        const char* ida = " 99";
-        const char* blank = "   ";
-        FILE* ph = nullptr;
-        int lstr = STRING_LENGTH;
-        std::string cmd;
-        cmd = fmt::format("head -c10 {} 2>/dev/null", source);
-        errno = 0;
-        if ((ph = popen(cmd.c_str(), "r")) == nullptr) {
-            if (errno != 0) addIdamError(UDA_SYSTEM_ERROR_TYPE, "sourceFileFormatTest", errno, "");
-            addIdamError(UDA_CODE_ERROR_TYPE, "sourceFileFormatTest", 999,
-                         "Unable to Identify the File's Format");
+        test = file_signature_format(source);
+        if (test == nullptr) {
             return -999;
         }
-
-        char buffer[STRING_LENGTH];
-        if (!feof(ph)) {
-            if (fgets(buffer, lstr - 1, ph) == nullptr) {
-                UDA_THROW_ERROR(-999, "failed to read command");
-            }
-        }
-        pclose(ph);
-
-        test = blank;
-        convertNonPrintable2(buffer);
-        LeftTrimString(buffer);
-        TrimString(buffer);
-
-        if (STR_EQUALS(buffer, "CDF")) {    // Legacy netCDF file
-            test = nc;
-        } else {
-            if (STR_EQUALS(buffer, "HDF")) {    // Either a netCDF or a HDF5 file: use utility programs to reveal!
-                char* env = getenv("UDA_DUMP_NETCDF");
-                if (env != nullptr) {
-                    cmd = fmt::format("{} -h {} 2>/dev/null | head -c10 2>/dev/null", env, source);
-                    errno = 0;
-                    if ((ph = popen(cmd.c_str(), "r")) == nullptr) {
-                        if (errno != 0) {
-                            addIdamError(UDA_SYSTEM_ERROR_TYPE, "sourceFileFormatTest", errno, "");
-                        }
-                        addIdamError(UDA_CODE_ERROR_TYPE, "sourceFileFormatTest", 999,
-                                     "Unable to Identify the File's Format");
-                        return -999;
-                    }
-
-                    buffer[0] = '\0';
-                    if (!feof(ph)) {
-                        if (fgets(buffer, lstr - 1, ph) == nullptr) {
-                            UDA_THROW_ERROR(-999, "failed to read command");
-                        }
-                    }
-                    pclose(ph);
-                    convertNonPrintable2(buffer);
-                    LeftTrimString(buffer);
-                    TrimString(buffer);
-
-                    if (STR_EQUALS(buffer, "netcdf")) {        // netCDF file written to an HDF5 file
-                        test = nc;
-                    } else {
-                        if (cmd[0] == '\0') test = hf;        // HDF5 file
-                    }
-                }
-            } else {                    // an IDA File?
-                char* env = getenv("UDA_DUMP_IDA");
-                if (env != nullptr) {
-                    cmd = fmt::format("{} -h {} 2>/dev/null 2>/dev/null", env, source);
-                    errno = 0;
-                    if ((ph = popen(cmd.c_str(), "r")) == nullptr) {
-                        if (errno != 0) {
-                            UDA_ADD_SYS_ERROR("");
-                        }
-                        UDA_ADD_ERROR(999, "Unable to Identify the File's Format");
-                        return -999;
-                    }
-
-                    buffer[0] = '\0';
-                    if (!feof(ph)) {
-                        // IDA3 interface version V3.13 with file structure IDA3.1
-                        if (fgets(buffer, lstr - 1, ph) == nullptr) {
-                            UDA_THROW_ERROR(-999, "failed to read command output");
-                        }
-                    }
-                    if (!feof(ph)) {
-                        // Build JW Jan 25 2007 09:08:47
-                        if (fgets(buffer, lstr - 1, ph) == nullptr) {
-                            UDA_THROW_ERROR(-999, "failed to read command output");
-                        }
-                    }
-                    if (!feof(ph)) {
-                        // Compiled without high level read/write CUTS
-                        if (fgets(buffer, lstr - 1, ph) == nullptr) {
-                            UDA_THROW_ERROR(-999, "failed to read command output");
-                        }
-                    }
-                    if (!feof(ph)) {
-                        // Opening ida file
-                        if (fgets(buffer, lstr - 1, ph) == nullptr) {
-                            UDA_THROW_ERROR(-999, "failed to read command output");
-                        }
-                    }
-                    if (!feof(ph)) {
-                        // ida_open error ?
-                        if (fgets(buffer, lstr - 1, ph) == nullptr) {
-                            UDA_THROW_ERROR(-999, "failed to read command output");
-                        }
-                    }
-                    pclose(ph);
-                    convertNonPrintable2(buffer);
-                    LeftTrimString(buffer);
-                    TrimString(buffer);
-                    if (strncmp(buffer, "ida_open error", 14) != 0) {
-                        test = ida;    // Legacy IDA file
-                    }
-                }
-            }
-        }
-
+        UDA_LOG(UDA_LOG_DEBUG, "File signature identifies extension: %s\n", &test[1]);
 #else
         return rc;
 #endif
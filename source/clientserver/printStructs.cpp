@@ -111,7 +111,7 @@ void printDataBlock(DATA_BLOCK str)
     UDA_LOG(UDA_LOG_DEBUG, "error msg    : %s\n", str.error_msg);
     UDA_LOG(UDA_LOG_DEBUG, "source status: %d\n", str.source_status);
     UDA_LOG(UDA_LOG_DEBUG, "signal status: %d\n", str.signal_status);
-    UDA_LOG(UDA_LOG_DEBUG, "data_number  : %d\n", str.data_n);
+    UDA_LOG(UDA_LOG_DEBUG, "data_number  : %lld\n", (long long)str.data_n);
     UDA_LOG(UDA_LOG_DEBUG, "rank         : %d\n", str.rank);
     UDA_LOG(UDA_LOG_DEBUG, "order        : %d\n", str.order);
     UDA_LOG(UDA_LOG_DEBUG, "data_type    : %d\n", str.data_type);
@@ -186,7 +186,7 @@ void printDataBlock(DATA_BLOCK str)
             UDA_LOG(UDA_LOG_DEBUG, "param[%d] = %f \n", j, str.dims[i].errparams[j]);
         }
         
-        UDA_LOG(UDA_LOG_DEBUG, "data_number : %d\n", str.dims[i].dim_n);
+        UDA_LOG(UDA_LOG_DEBUG, "data_number : %lld\n", (long long)str.dims[i].dim_n);
         UDA_LOG(UDA_LOG_DEBUG, "compressed? : %d\n", str.dims[i].compressed);
         UDA_LOG(UDA_LOG_DEBUG, "method      : %d\n", str.dims[i].method);
         
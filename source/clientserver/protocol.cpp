@@ -129,19 +129,19 @@ int protocol(XDR* xdrs, int protocol_id, int direction, int* token, LOGMALLOCLIS
 
                     if ((err = allocData(data_block)) != 0) break;        // Allocate Heap Memory
 
-                    if (!xdr_data_block2(xdrs, data_block)) {
+                    if (!xdr_data_block2(xdrs, data_block, false, false)) {
                         err = UDA_PROTOCOL_ERROR_62;
                         break;
                     }
 
                     if (data_block->error_type != UDA_TYPE_UNKNOWN ||
                         data_block->error_param_n > 0) {    // Receive Only if Error Data are available
-                        if (!xdr_data_block3(xdrs, data_block)) {
+                        if (!xdr_data_block3(xdrs, data_block, false, false)) {
                             err = UDA_PROTOCOL_ERROR_62;
                             break;
                         }
 
-                        if (!xdr_data_block4(xdrs, data_block)) {        // Asymmetric Errors
+                        if (!xdr_data_block4(xdrs, data_block, false, false)) {        // Asymmetric Errors
                             err = UDA_PROTOCOL_ERROR_62;
                             break;
                         }
@@ -152,7 +152,7 @@ int protocol(XDR* xdrs, int protocol_id, int direction, int* token, LOGMALLOCLIS
                             initDimBlock(&data_block->dims[i]);
                         }
 
-                        if (!xdr_data_dim1(xdrs, data_block)) {
+                        if (!xdr_data_dim1(xdrs, data_block, protocolVersion)) {
                             err = UDA_PROTOCOL_ERROR_63;
                             break;
                         }
@@ -171,7 +171,7 @@ int protocol(XDR* xdrs, int protocol_id, int direction, int* token, LOGMALLOCLIS
 
                         if ((err = allocDim(data_block)) != 0) break;            // Allocate Heap Memory
 
-                        if (!xdr_data_dim2(xdrs, data_block)) {        // Collect Only Uncompressed data
+                        if (!xdr_data_dim2(xdrs, data_block, false)) {        // Collect Only Uncompressed data
                             err = UDA_PROTOCOL_ERROR_64;
                             break;
                         }
@@ -217,18 +217,18 @@ int protocol(XDR* xdrs, int protocol_id, int direction, int* token, LOGMALLOCLIS
                         break;
                     }
 
-                    if (!xdr_data_block2(xdrs, data_block)) {
+                    if (!xdr_data_block2(xdrs, data_block, false, false)) {
                         err = UDA_PROTOCOL_ERROR_62;
                         break;
                     }
 
                     if (data_block->error_type != UDA_TYPE_UNKNOWN ||
                         data_block->error_param_n > 0) {    // Only Send if Error Data are available
-                        if (!xdr_data_block3(xdrs, data_block)) {
+                        if (!xdr_data_block3(xdrs, data_block, false, false)) {
                             err = UDA_PROTOCOL_ERROR_62;
                             break;
                         }
-                        if (!xdr_data_block4(xdrs, data_block)) {
+                        if (!xdr_data_block4(xdrs, data_block, false, false)) {
                             err = UDA_PROTOCOL_ERROR_62;
                             break;
                         }
@@ -254,12 +254,12 @@ int protocol(XDR* xdrs, int protocol_id, int direction, int* token, LOGMALLOCLIS
                             compressDim(&(data_block->dims[i]));        // Minimise Data Transfer if Regular
                         }
 
-                        if (!xdr_data_dim1(xdrs, data_block)) {
+                        if (!xdr_data_dim1(xdrs, data_block, protocolVersion)) {
                             err = UDA_PROTOCOL_ERROR_63;
                             break;
                         }
 
-                        if (!xdr_data_dim2(xdrs, data_block)) {
+                        if (!xdr_data_dim2(xdrs, data_block, false)) {
                             err = UDA_PROTOCOL_ERROR_64;
                             break;
                         }
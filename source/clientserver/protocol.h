@@ -36,6 +36,7 @@
 #define UDA_PROTOCOL_SERIALISE_FILE     20
 #define UDA_PROTOCOL_DATAOBJECT         21
 #define UDA_PROTOCOL_DATAOBJECT_FILE    22
+#define UDA_PROTOCOL_DATA_CHUNK         23
 #define UDA_PROTOCOL_REGULAR_STOP       99
 
 #define UDA_PROTOCOL_OPAQUE_START       100         // Identifies Legacy Hierarchical Data Protocol Group
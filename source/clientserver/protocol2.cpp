@@ -44,7 +44,9 @@
 #include "errorLog.h"
 
 static int handle_request_block(XDR* xdrs, int direction, const void* str, int protocolVersion);
-static int handle_data_block(XDR* xdrs, int direction, const void* str, int protocolVersion);
+static int handle_data_block(XDR* xdrs, int direction, const void* str, int protocolVersion, bool native,
+                             bool stream, bool compress);
+static int handle_data_chunk(XDR* xdrs, int direction, const void* str, int protocolVersion);
 static int handle_data_block_list(XDR* xdrs, int direction, const void* str, int protocolVersion);
 static int handle_putdata_block_list(XDR* xdrs, int direction, int* token, LOGMALLOCLIST* logmalloclist,
                                      USERDEFINEDTYPELIST* userdefinedtypelist, const void* str, int protocolVersion,
@@ -77,6 +79,9 @@ int protocol2(XDR* xdrs, int protocol_id, int direction, int* token, LOGMALLOCLI
         case UDA_PROTOCOL_DATA_BLOCK_LIST:
             err = handle_data_block_list(xdrs, direction, str, protocolVersion);
             break;
+        case UDA_PROTOCOL_DATA_CHUNK:
+            err = handle_data_chunk(xdrs, direction, str, protocolVersion);
+            break;
         case UDA_PROTOCOL_PUTDATA_BLOCK_LIST:
             err = handle_putdata_block_list(xdrs, direction, token, logmalloclist, userdefinedtypelist, str,
                                             protocolVersion, log_struct_list, private_flags, malloc_source);
@@ -687,7 +692,8 @@ static int handle_putdata_block_list(XDR* xdrs, int direction, int* token, LOGMA
     return err;
 }
 
-static int handle_data_block(XDR* xdrs, int direction, const void* str, int protocolVersion)
+static int handle_data_block(XDR* xdrs, int direction, const void* str, int protocolVersion, bool native,
+                             bool stream, bool compress)
 {
     int err = 0;
     auto data_block = (DATA_BLOCK*)str;
@@ -711,21 +717,26 @@ static int handle_data_block(XDR* xdrs, int direction, const void* str, int prot
 
             if (data_block->data_n == 0) break;            // No Data to Receive!
 
-            if ((err = allocData(data_block)) != 0) break;        // Allocate Heap Memory
+            if (stream && streamedDataBlock(data_block)) {
+                // The data array follows the data block list as a chunk stream
+                if ((err = allocDimBlocks(data_block)) != 0) break;
+            } else {
+                if ((err = allocData(data_block)) != 0) break;        // Allocate Heap Memory
 
-            if (!xdr_data_block2(xdrs, data_block)) {
-                err = UDA_PROTOCOL_ERROR_62;
-                break;
+                if (!xdr_data_block2(xdrs, data_block, native, compress)) {
+                    err = UDA_PROTOCOL_ERROR_62;
+                    break;
+                }
             }
 
             if (data_block->error_type != UDA_TYPE_UNKNOWN ||
                 data_block->error_param_n > 0) {    // Receive Only if Error Data are available
-                if (!xdr_data_block3(xdrs, data_block)) {
+                if (!xdr_data_block3(xdrs, data_block, native, compress)) {
                     err = UDA_PROTOCOL_ERROR_62;
                     break;
                 }
 
-                if (!xdr_data_block4(xdrs, data_block)) {        // Asymmetric Errors
+                if (!xdr_data_block4(xdrs, data_block, native, compress)) {        // Asymmetric Errors
                     err = UDA_PROTOCOL_ERROR_62;
                     break;
                 }
@@ -738,7 +749,7 @@ static int handle_data_block(XDR* xdrs, int direction, const void* str, int prot
                     initDimBlock(&data_block->dims[i]);
                 }
 
-                if (!xdr_data_dim1(xdrs, data_block)) {
+                if (!xdr_data_dim1(xdrs, data_block, protocolVersion)) {
                     err = UDA_PROTOCOL_ERROR_63;
                     break;
                 }
@@ -759,7 +770,7 @@ static int handle_data_block(XDR* xdrs, int direction, const void* str, int prot
 
                 if ((err = allocDim(data_block)) != 0) break;            // Allocate Heap Memory
 
-                if (!xdr_data_dim2(xdrs, data_block)) {        // Collect Only Uncompressed data
+                if (!xdr_data_dim2(xdrs, data_block, native)) {        // Collect Only Uncompressed data
                     err = UDA_PROTOCOL_ERROR_64;
                     break;
                 }
@@ -809,18 +820,18 @@ static int handle_data_block(XDR* xdrs, int direction, const void* str, int prot
                 break;
             }
 
-            if (!xdr_data_block2(xdrs, data_block)) {
+            if (!(stream && streamedDataBlock(data_block)) && !xdr_data_block2(xdrs, data_block, native, compress)) {
                 err = UDA_PROTOCOL_ERROR_62;
                 break;
             }
 
             if (data_block->error_type != UDA_TYPE_UNKNOWN || data_block->error_param_n > 0) {
                 // Only Send if Error Data are available
-                if (!xdr_data_block3(xdrs, data_block)) {
+                if (!xdr_data_block3(xdrs, data_block, native, compress)) {
                     err = UDA_PROTOCOL_ERROR_62;
                     break;
                 }
-                if (!xdr_data_block4(xdrs, data_block)) {
+                if (!xdr_data_block4(xdrs, data_block, native, compress)) {
                     err = UDA_PROTOCOL_ERROR_62;
                     break;
                 }
@@ -849,12 +860,12 @@ static int handle_data_block(XDR* xdrs, int direction, const void* str, int prot
                     compressDim(&(data_block->dims[i]));        // Minimise Data Transfer if Regular
                 }
 
-                if (!xdr_data_dim1(xdrs, data_block)) {
+                if (!xdr_data_dim1(xdrs, data_block, protocolVersion)) {
                     err = UDA_PROTOCOL_ERROR_63;
                     break;
                 }
 
-                if (!xdr_data_dim2(xdrs, data_block)) {
+                if (!xdr_data_dim2(xdrs, data_block, native)) {
                     err = UDA_PROTOCOL_ERROR_64;
                     break;
                 }
@@ -896,7 +907,8 @@ static int handle_data_block_list(XDR* xdrs, int direction, const void* str, int
             for (int i = 0; i < data_block_list->count; ++i) {
                 DATA_BLOCK* data_block = &data_block_list->data[i];
                 initDataBlock(data_block);
-                err = handle_data_block(xdrs, XDR_RECEIVE, data_block, protocolVersion);
+                err = handle_data_block(xdrs, XDR_RECEIVE, data_block, protocolVersion, data_block_list->native_data,
+                                        data_block_list->stream_data, data_block_list->compress_data);
                 if (err != 0) {
                     err = UDA_PROTOCOL_ERROR_2;
                     break;
@@ -912,7 +924,8 @@ static int handle_data_block_list(XDR* xdrs, int direction, const void* str, int
             }
             for (int i = 0; i < data_block_list->count; ++i) {
                 DATA_BLOCK* data_block = &data_block_list->data[i];
-                int rc = handle_data_block(xdrs, XDR_SEND, data_block, protocolVersion);
+                int rc = handle_data_block(xdrs, XDR_SEND, data_block, protocolVersion, data_block_list->native_data,
+                                           data_block_list->stream_data, data_block_list->compress_data);
                 if (rc != 0) {
                     err = UDA_PROTOCOL_ERROR_2;
                     break;
@@ -932,6 +945,71 @@ static int handle_data_block_list(XDR* xdrs, int direction, const void* str, int
     return err;
 }
 
+/**
+ * One chunk of a streamed data array, passed as its own record. The receiver's buffer (DATA_CHUNK::data) is grown as
+ * needed and reused for the following chunks; the caller frees it.
+ */
+static int handle_data_chunk(XDR* xdrs, int direction, const void* str, int protocolVersion)
+{
+    int err = 0;
+    auto data_chunk = (DATA_CHUNK*)str;
+
+    switch (direction) {
+        case XDR_RECEIVE: {
+            if (!xdrrec_skiprecord(xdrs)) {
+                err = UDA_PROTOCOL_ERROR_5;
+                break;
+            }
+            if (!xdr_data_chunk1(xdrs, data_chunk, protocolVersion) || data_chunk->count < 0) {
+                err = UDA_PROTOCOL_ERROR_61;
+                break;
+            }
+            if (data_chunk->count == 0) {
+                break;                              // End of the stream
+            }
+            if (data_chunk->count > data_chunk->capacity) {
+                size_t size = getSizeOf((UDA_TYPE)data_chunk->data_type);
+                auto data = (char*)realloc(data_chunk->data, (size_t)data_chunk->count * size);
+                if (data == nullptr) {
+                    err = ERROR_ALLOCATING_HEAP;
+                    break;
+                }
+                data_chunk->data = data;
+                data_chunk->capacity = data_chunk->count;
+            }
+            if (!xdr_data_chunk2(xdrs, data_chunk)) {
+                err = UDA_PROTOCOL_ERROR_62;
+                break;
+            }
+            break;
+        }
+
+        case XDR_SEND:
+            if (!xdr_data_chunk1(xdrs, data_chunk, protocolVersion)) {
+                err = UDA_PROTOCOL_ERROR_61;
+                break;
+            }
+            if (data_chunk->count > 0 && !xdr_data_chunk2(xdrs, data_chunk)) {
+                err = UDA_PROTOCOL_ERROR_62;
+                break;
+            }
+            if (!xdrrec_endofrecord(xdrs, 1)) {
+                err = UDA_PROTOCOL_ERROR_7;
+                break;
+            }
+            break;
+
+        case XDR_FREE_HEAP:
+            break;
+
+        default:
+            err = UDA_PROTOCOL_ERROR_4;
+            break;
+    }
+
+    return err;
+}
+
 static int handle_request_block(XDR* xdrs, int direction, const void* str, int protocolVersion)
 {
     int err = 0;
@@ -1394,6 +1394,9 @@ packXDRDataBlockObject(unsigned char* object, size_t objectSize, DATA_BLOCK* dat
         DATA_BLOCK_LIST data_block_list;
         data_block_list.count = 1;
         data_block_list.data = data_block;
+        data_block_list.native_data = 0;
+        data_block_list.stream_data = 0;
+        data_block_list.compress_data = 0;
         err = protocol2(&xdrObject, UDA_PROTOCOL_DATA_BLOCK_LIST, XDR_SEND, nullptr, logmalloclist, userdefinedtypelist,
                         &data_block_list, protocolVersion, log_struct_list, private_flags, malloc_source);
 
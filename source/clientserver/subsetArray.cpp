@@ -0,0 +1,143 @@
+#include "subsetArray.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <logging/logging.h>
+
+#include "errorLog.h"
+#include "udaTypes.h"
+
+namespace {
+
+template <size_t Size>
+void copy_blocks(char* p, const char* data, size_t offset, size_t stride, const uda::SubsetSelection& selection)
+{
+    for (int index : selection.indices) {
+        memcpy(p, data + offset + index * stride, Size);
+        p += Size;
+    }
+}
+
+} // anon namespace
+
+/**
+ * The leading dimensions that are not subset are copied as contiguous blocks. The gathered elements are passed to
+ * the chunk callback, if any, in runs of about SubsetChunkBytes, so a transformation of the result (e.g. a
+ * calibration) is applied while the elements are still in cache.
+ */
+int uda::subsetArray(const std::vector<SubsetSelection>& selections, const char* data, int data_type, int64_t* n,
+                     char** new_data, const SubsetChunkCallback& chunk)
+{
+    *n = 0;
+    *new_data = nullptr;
+
+    size_t size = getSizeOf((UDA_TYPE)data_type);
+
+    if (size == 0 || data_type == UDA_TYPE_STRING || data_type == UDA_TYPE_CAPNP) {
+        UDA_LOG(UDA_LOG_ERROR, "Data Type: %d    Rank: %d\n", data_type, (int)selections.size());
+        UDA_THROW_ERROR(9999, "Only Atomic Numeric Data Types can be Subset");
+    }
+
+    int rank = (int)selections.size();
+
+    std::vector<size_t> strides(rank);          // Bytes between consecutive elements of each dimension
+    std::vector<int64_t> lengths(rank);         // Number of elements selected from each dimension
+
+    size_t count = 1;
+    size_t stride = size;
+    for (int k = 0; k < rank; k++) {
+        strides[k] = stride;
+        stride *= selections[k].dim_n;
+        lengths[k] = selections[k].all ? selections[k].dim_n : (int64_t)selections[k].indices.size();
+        count *= lengths[k];
+    }
+
+    int inner = 0;
+    size_t block = size;
+    while (inner < rank && selections[inner].all) {
+        block *= selections[inner].dim_n;
+        inner++;
+    }
+
+    auto p = (char*)malloc(count * size);
+    if (p == nullptr && count > 0) {
+        UDA_THROW_ERROR(9999, "Unable to Allocate Heap memory");
+    }
+
+    *n = (int64_t)count;
+    *new_data = p;
+
+    if (count == 0) {
+        return 0;
+    }
+
+    auto gathered = [&](char* begin, char* end) {
+        if (chunk) {
+            chunk(begin, (int)((end - begin) / size));
+        }
+    };
+
+    if (inner == rank) {
+        for (size_t offset = 0; offset < count * size; offset += SubsetChunkBytes) {
+            size_t bytes = std::min(SubsetChunkBytes, count * size - offset);
+            memcpy(p + offset, data + offset, bytes);
+            gathered(p + offset, p + offset + bytes);
+        }
+        return 0;
+    }
+
+    // Step through the selected elements of the outer dimensions, copying the selected blocks of the innermost
+    // subset dimension
+
+    std::vector<int64_t> counter(rank, 0);
+    const SubsetSelection& selection = selections[inner];
+    size_t copied = block * selection.indices.size();
+    char* pending = p;
+
+    while (true) {
+        size_t offset = 0;
+        for (int k = inner + 1; k < rank; k++) {
+            offset += (selections[k].all ? counter[k] : selections[k].indices[counter[k]]) * strides[k];
+        }
+
+        switch (block) {
+            case 1: copy_blocks<1>(p, data, offset, strides[inner], selection); break;
+            case 2: copy_blocks<2>(p, data, offset, strides[inner], selection); break;
+            case 4: copy_blocks<4>(p, data, offset, strides[inner], selection); break;
+            case 8: copy_blocks<8>(p, data, offset, strides[inner], selection); break;
+            case 16: copy_blocks<16>(p, data, offset, strides[inner], selection); break;
+            default: {
+                char* q = p;
+                for (int index : selection.indices) {
+                    memcpy(q, data + offset + index * strides[inner], block);
+                    q += block;
+                }
+            }
+        }
+        p += copied;
+
+        if ((size_t)(p - pending) >= SubsetChunkBytes) {
+            gathered(pending, p);
+            pending = p;
+        }
+
+        int k = inner + 1;
+        for (; k < rank; k++) {
+            if (++counter[k] < lengths[k]) {
+                break;
+            }
+            counter[k] = 0;
+        }
+        if (k == rank) {
+            break;
+        }
+    }
+
+    if (p > pending) {
+        gathered(pending, p);
+    }
+
+    return 0;
+}
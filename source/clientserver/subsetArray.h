@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef UDA_CLIENTSERVER_SUBSETARRAY_H
+#define UDA_CLIENTSERVER_SUBSETARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "export.h"
+
+namespace uda {
+
+struct SubsetSelection {
+    int64_t dim_n;              // Length of the dimension before subsetting
+    bool all;                   // Every element of the dimension is selected
+    std::vector<int> indices;   // Otherwise the indices selected, in order
+};
+
+// Bytes gathered between calls of the chunk callback
+constexpr size_t SubsetChunkBytes = 16 * 1024;
+
+// Called with each run of count gathered elements while they are still in cache
+using SubsetChunkCallback = std::function<void(char* begin, int count)>;
+
+/**
+ * Gather the elements selected along each dimension of a row-major array (dimension 0 varies fastest) into a new
+ * heap array in a single pass, setting n to the number of elements gathered.
+ *
+ * @return 0, or an error code if the type cannot be subset or the new array not allocated
+ */
+LIBRARY_API int subsetArray(const std::vector<SubsetSelection>& selections, const char* data, int data_type,
+                            int64_t* n, char** new_data, const SubsetChunkCallback& chunk = nullptr);
+
+} // namespace uda
+
+#endif // UDA_CLIENTSERVER_SUBSETARRAY_H
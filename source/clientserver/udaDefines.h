@@ -57,6 +57,7 @@ extern "C" {
 
 #define DB_READ_BLOCK_SIZE      32*1024 //16384
 #define DB_WRITE_BLOCK_SIZE     32*1024 //16384
+#define DB_MAX_BLOCK_SIZE       512*1024        // Limit of the record buffers' growth for bulk transfers
 
 #define GROWPUTDATABLOCKLIST    10
 
@@ -88,6 +89,9 @@ extern "C" {
 #define CLIENTFLAG_REUSELASTHANDLE     32u  // 0010 0000    Reuse the last issued handle value (for this thread) - assume application has freed heap
 #define CLIENTFLAG_FREEREUSELASTHANDLE 64u  // 0100 0000    Free the heap associated with the last issued handle and reuse the handle value
 #define CLIENTFLAG_FILECACHE 128u           // 1000 0000    Access data from and save data to local cache files
+#define CLIENTFLAG_NATIVEDATA 256u          // 1 0000 0000  Receive data arrays as raw little-endian bytes (protocol version 10+)
+#define CLIENTFLAG_STREAMDATA 512u          // 10 0000 0000 Receive data arrays as a stream of chunks (protocol version 10+)
+#define CLIENTFLAG_COMPRESSDATA 1024u       // 100 0000 0000 Receive data arrays compressed where worthwhile (protocol version 11+)
 
 //--------------------------------------------------------
 // Error Models
@@ -147,7 +147,7 @@ typedef struct Dims {
     int error_model;                // Identify the Error Model
     int errasymmetry;               // Flags whether or not error data are asymmetrical
     int error_param_n;              // the Number of Model Parameters
-    int dim_n;                      // Array lengths
+    int64_t dim_n;                  // Array lengths
 
     int compressed;                 // TRUE if data is regular and in compressed form
     double dim0;                    // Starting Value for Regular Grid
@@ -236,7 +236,7 @@ typedef struct DataBlock {
     int errasymmetry;               // Flags whether or not error data are asymmetrical
     int error_param_n;              // the Number of Model Parameters
 
-    int data_n;
+    int64_t data_n;
     char* data;
     char* synthetic;                // Synthetic Data Array used in Client Side Error/Monte-Carlo Modelling
 
@@ -262,15 +262,27 @@ typedef struct DataBlock {
     int opaque_type;                // Identifies the Data Structure Type;
     int opaque_count;               // Number of Instances of the Data Structure;
     void* opaque_block;             // Opaque pointer to Hierarchical Data Structures
-    unsigned int totalDataBlockSize;// The amount of data within this structure.
+    size_t totalDataBlockSize;      // The amount of data within this structure.
     unsigned int cachePermission;   // Permission for the Client to cache this structure.
 } DATA_BLOCK;
 
 typedef struct DataBlockList {
     int count;
     DATA_BLOCK* data;
+    int native_data;        // Data arrays passed as raw little-endian bytes (protocol version 10+)
+    int stream_data;        // Atomic data arrays follow the list as chunk streams (protocol version 10+)
+    int compress_data;      // Data and error arrays may be compressed (protocol version 11+)
 } DATA_BLOCK_LIST;
 
+typedef struct DataChunk {
+    int data_type;          // Type of the streamed data array
+    int native_data;        // Elements passed as raw little-endian bytes
+    int compress_data;      // Elements may be compressed
+    int64_t count;          // Number of elements in this chunk: an empty chunk ends the stream
+    int64_t capacity;       // Number of elements the receive buffer can hold
+    char* data;             // Chunk elements
+} DATA_CHUNK;
+
 typedef struct DataObject {
     unsigned short objectType;      // File or regular object
     unsigned int objectSize;
@@ -420,6 +432,10 @@ typedef struct Environment {
     char api_format[STRING_LENGTH];                 // API Default Client File Format
     char private_path_target[STRING_LENGTH];        // Target this path to private files
     char private_path_substitute[STRING_LENGTH];    // and substitute with this path (so the server can locate them!)
+    int xdr_buffer_size;                            // Initial XDR record stream buffer size (bytes)
+    int xdr_buffer_max;                             // Limit of the record buffer's growth for bulk transfers (bytes)
+    int socket_buffer_size;                         // Socket send and receive buffer sizes (bytes): 0 leaves these to the OS
+    int socket_timeout;                             // Client socket send and receive timeout (seconds): 0 waits without limit
     char initialised;                               // Environment already initialised.
     char _padding[1];
 } ENVIRONMENT;
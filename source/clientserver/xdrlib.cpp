@@ -8,7 +8,14 @@
 #include "xdrlib.h"
 
 #include <memory.h>
+#include <algorithm>
+#include <climits>
 #include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include <zlib.h>
 
 #include <logging/logging.h>
 #include <structures/struct.h>
@@ -16,7 +23,9 @@
 
 #include "printStructs.h"
 #include "errorLog.h"
+#include "initStructs.h"
 #include "stringUtils.h"
+#include "udaTypes.h"
 
 //-----------------------------------------------------------------------
 // Test version's type passing capability
@@ -50,6 +59,457 @@ int protocolVersionTypeTest(int protocol_version, int type)
     return 0;        // Return Test False: This type is OK
 }
 
+//-----------------------------------------------------------------------
+// Bulk Arrays of Atomic Types
+//
+// xdr_vector makes one call through the stream's operations table per element. Where the stream can expose its
+// buffer (xdr_inline) whole runs of elements are converted to and from the XDR representation in place: a byte swap
+// on little-endian hosts or a plain copy on big-endian ones. The encoding on the wire is unchanged, so neither peer
+// needs to know which path the other used.
+
+namespace {
+
+// Largest run of elements converted per xdr_inline request (bytes)
+constexpr u_int BulkChunkBytes = 16 * 1024;
+
+inline uint32_t to_big_endian(uint32_t value)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return value;
+#else
+    return ((value & 0x000000FFu) << 24) | ((value & 0x0000FF00u) << 8)
+           | ((value & 0x00FF0000u) >> 8) | ((value & 0xFF000000u) >> 24);
+#endif
+}
+
+inline uint64_t to_big_endian(uint64_t value)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return value;
+#else
+    return ((uint64_t)to_big_endian((uint32_t)value) << 32) | to_big_endian((uint32_t)(value >> 32));
+#endif
+}
+
+// T is the host element type, W the unsigned XDR unit it is carried in. Types narrower than 4 bytes are widened to
+// an XDR int (sign extended) or unsigned int, as by xdr_char and xdr_short.
+
+template <typename T, typename W>
+inline W to_xdr_unit(T value)
+{
+    if constexpr (std::is_floating_point<T>::value) {
+        static_assert(sizeof(T) == sizeof(W), "floating point types are not resized");
+        W unit;
+        memcpy(&unit, &value, sizeof(W));
+        return unit;
+    } else if constexpr (std::is_signed<T>::value && sizeof(W) == 4) {
+        return (W)(int32_t)value;
+    } else {
+        return (W)value;
+    }
+}
+
+template <typename T, typename W>
+inline T from_xdr_unit(W unit)
+{
+    if constexpr (std::is_floating_point<T>::value) {
+        T value;
+        memcpy(&value, &unit, sizeof(T));
+        return value;
+    } else if constexpr (std::is_signed<T>::value && sizeof(W) == 4) {
+        return (T)(int32_t)unit;
+    } else {
+        return (T)unit;
+    }
+}
+
+template <typename T, typename W>
+void encode_run(const char* data, char* buffer, u_int count)
+{
+    for (u_int i = 0; i < count; ++i) {
+        T value;
+        memcpy(&value, data + i * sizeof(T), sizeof(T));
+        W unit = to_big_endian(to_xdr_unit<T, W>(value));
+        memcpy(buffer + i * sizeof(W), &unit, sizeof(W));
+    }
+}
+
+template <typename T, typename W>
+void decode_run(const char* buffer, char* data, u_int count)
+{
+    for (u_int i = 0; i < count; ++i) {
+        W unit;
+        memcpy(&unit, buffer + i * sizeof(W), sizeof(W));
+        T value = from_xdr_unit<T, W>(to_big_endian(unit));
+        memcpy(data + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+template <typename T, typename W>
+bool_t xdr_bulk_run(XDR* xdrs, char* data, uint64_t count, xdrproc_t xdr_element)
+{
+    constexpr u_int max_run = BulkChunkBytes / sizeof(W);
+    u_int run = max_run;
+    uint64_t done = 0;
+
+    while (done < count) {
+        u_int n = count - done < run ? (u_int)(count - done) : run;
+        auto buffer = (char*)XDR_INLINE(xdrs, (int)(n * sizeof(W)));
+
+        if (buffer != nullptr) {
+            if (xdrs->x_op == XDR_ENCODE) {
+                encode_run<T, W>(data + done * sizeof(T), buffer, n);
+            } else {
+                decode_run<T, W>(buffer, data + done * sizeof(T), n);
+            }
+            done += n;
+            run = run < max_run / 2 ? 2 * run : max_run;
+        } else if (n > 1) {
+            // Not enough of the stream buffer left: try a shorter run
+            run = n / 2;
+        } else {
+            // Buffer exhausted: a single element forces the stream to flush or refill it
+            if (!xdr_element(xdrs, data + done * sizeof(T))) {
+                return 0;
+            }
+            done += 1;
+            run = max_run;
+        }
+    }
+
+    return 1;
+}
+
+template <typename T, typename W>
+bool_t xdr_bulk_try(XDR* xdrs, char* data, uint64_t count, u_int size, xdrproc_t xdr_element, xdrproc_t xdr_type,
+                    bool_t* rc)
+{
+    if (xdr_element != xdr_type || size != sizeof(T)) {
+        return 0;
+    }
+    *rc = xdr_bulk_run<T, W>(xdrs, data, count, xdr_element);
+    return 1;
+}
+
+// xdr_vector over arrays whose length may exceed an u_int
+bool_t xdr_long_vector(XDR* xdrs, char* data, uint64_t count, u_int size, xdrproc_t xdr_element)
+{
+    constexpr uint64_t max_run = UINT_MAX / 2;
+    uint64_t done = 0;
+
+    do {
+        u_int n = count - done < max_run ? (u_int)(count - done) : (u_int)max_run;
+        if (!xdr_vector(xdrs, data + done * size, n, size, xdr_element)) {
+            return 0;
+        }
+        done += n;
+    } while (done < count);
+
+    return 1;
+}
+
+} // anon namespace
+
+/**
+ * Drop-in replacement for xdr_vector for arrays of atomic types (the element routine is one of xdr_float, xdr_double,
+ * xdr_char, xdr_short, xdr_int, xdr_int64_t and their unsigned counterparts). Other element routines, and streams
+ * that cannot expose their buffer (e.g. xdrstdio), are passed to xdr_vector. xdr_long is among the others: how a
+ * 4 byte XDR long is widened to a 64 bit long on decode differs between XDR libraries.
+ */
+bool_t xdr_bulk_vector(XDR* xdrs, char* data, uint64_t count, u_int size, xdrproc_t xdr_element)
+{
+    if (count == 0 || xdrs->x_op == XDR_FREE || XDR_INLINE(xdrs, 0) == nullptr) {
+        return xdr_long_vector(xdrs, data, count, size, xdr_element);
+    }
+
+    bool_t rc = 0;
+    if (xdr_bulk_try<float, uint32_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_float, &rc)
+        || xdr_bulk_try<double, uint64_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_double, &rc)
+        || xdr_bulk_try<char, uint32_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_char, &rc)
+        || xdr_bulk_try<short, uint32_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_short, &rc)
+        || xdr_bulk_try<int, uint32_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_int, &rc)
+        || xdr_bulk_try<int64_t, uint64_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_int64_t, &rc)
+        || xdr_bulk_try<unsigned char, uint32_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_u_char, &rc)
+        || xdr_bulk_try<unsigned short, uint32_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_u_short, &rc)
+        || xdr_bulk_try<unsigned int, uint32_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_u_int, &rc)
+        || xdr_bulk_try<uint64_t, uint64_t>(xdrs, data, count, size, xdr_element, (xdrproc_t)xdr_uint64_t, &rc)) {
+        return rc;
+    }
+
+    return xdr_long_vector(xdrs, data, count, size, xdr_element);
+}
+
+//-----------------------------------------------------------------------
+// Native Data Arrays
+//
+// From protocol version 10 a data block list may be sent with its data, error and dimension arrays as raw
+// little-endian bytes rather than XDR (DATA_BLOCK_LIST::native_data). Little-endian peers (the usual case) then
+// exchange arrays with a plain copy. Only types with the same size on all platforms qualify: LONG (4 or 8 bytes) and
+// structured types are always passed as XDR.
+
+int littleEndianHost()
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return 0;
+#else
+    return 1;
+#endif
+}
+
+int nativeArrayType(int data_type)
+{
+    switch (data_type) {
+        case UDA_TYPE_FLOAT:
+        case UDA_TYPE_DOUBLE:
+        case UDA_TYPE_CHAR:
+        case UDA_TYPE_SHORT:
+        case UDA_TYPE_INT:
+        case UDA_TYPE_LONG64:
+        case UDA_TYPE_UNSIGNED_CHAR:
+        case UDA_TYPE_UNSIGNED_SHORT:
+        case UDA_TYPE_UNSIGNED_INT:
+        case UDA_TYPE_UNSIGNED_LONG64:
+        case UDA_TYPE_STRING:
+        case UDA_TYPE_COMPLEX:
+        case UDA_TYPE_DCOMPLEX:
+        case UDA_TYPE_CAPNP:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+namespace {
+
+// Sent as consecutive opaque runs: every run but the last is a multiple of 4 bytes so carries no padding
+bool_t xdr_opaque_bytes(XDR* xdrs, char* data, size_t bytes)
+{
+    constexpr size_t max_run = 1u << 30;
+    for (size_t offset = 0; offset < bytes; offset += max_run) {
+        size_t n = bytes - offset < max_run ? bytes - offset : max_run;
+        if (!xdr_opaque(xdrs, data + offset, (u_int)n)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Little-endian array received by a big-endian host: complex types are swapped as pairs of float or double
+void swap_little_endian(char* data, size_t bytes, int data_type)
+{
+    size_t unit = data_type == UDA_TYPE_COMPLEX ? sizeof(float)
+                  : data_type == UDA_TYPE_DCOMPLEX ? sizeof(double) : getSizeOf((UDA_TYPE)data_type);
+    for (size_t i = 0; unit > 1 && i < bytes; i += unit) {
+        std::reverse(data + i, data + i + unit);
+    }
+}
+
+} // anon namespace
+
+bool_t xdr_native_array(XDR* xdrs, char* data, uint64_t count, int data_type)
+{
+    size_t bytes = (size_t)count * getSizeOf((UDA_TYPE)data_type);
+
+    if (!xdr_opaque_bytes(xdrs, data, bytes)) {
+        return 0;
+    }
+
+    if (!littleEndianHost() && xdrs->x_op == XDR_DECODE) {
+        swap_little_endian(data, bytes, data_type);
+    }
+
+    return 1;
+}
+
+//-----------------------------------------------------------------------
+// Compressed Data Arrays
+//
+// From protocol version 11 a client may ask for the data and error arrays to be compressed
+// (DATA_BLOCK_LIST::compress_data). Each such array is then preceded by its encoding: arrays that are small or do not
+// compress are sent as before; the others as their little-endian bytes, shuffled so that the k-th bytes of all the
+// elements are adjacent, then deflated. Large arrays are only compressed if a sample from their start compresses, so
+// little time is spent on data that will not. A big-endian host never compresses.
+
+namespace {
+
+constexpr int ArrayUncompressed = 0;
+constexpr int ArrayShuffleDeflate = 1;
+
+constexpr size_t CompressMinBytes = 4096;               // Smaller arrays are sent as they are
+constexpr size_t CompressSampleBytes = 256 * 1024;      // Sample tried first from larger arrays
+constexpr double CompressMaxRatio = 0.8;                // Compressed size must be at most this fraction to be sent
+
+void shuffle(const char* data, char* shuffled, size_t count, size_t size)
+{
+    for (size_t k = 0; k < size; k++) {
+        char* out = shuffled + k * count;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = data[i * size + k];
+        }
+    }
+}
+
+void unshuffle(const char* shuffled, char* data, size_t count, size_t size)
+{
+    for (size_t k = 0; k < size; k++) {
+        const char* in = shuffled + k * count;
+        for (size_t i = 0; i < count; i++) {
+            data[i * size + k] = in[i];
+        }
+    }
+}
+
+// Shuffle and deflate count elements: false if the result is not small enough to be worth sending
+bool deflate_array(const char* data, size_t count, size_t size, std::vector<char>& compressed)
+{
+    size_t bytes = count * size;
+    std::vector<char> shuffled(bytes);
+    shuffle(data, shuffled.data(), count, size);
+
+    uLongf length = compressBound((uLong)bytes);
+    compressed.resize(length);
+    if (compress2((Bytef*)compressed.data(), &length, (const Bytef*)shuffled.data(), (uLong)bytes, Z_BEST_SPEED)
+        != Z_OK || (double)length > CompressMaxRatio * (double)bytes) {
+        return false;
+    }
+    compressed.resize(length);
+    return true;
+}
+
+} // anon namespace
+
+/**
+ * Pass the encoding of an array of a compressible type and, if compressed, the array itself. On return *compressed
+ * is set if the array was passed; otherwise the caller passes it with its usual encoding.
+ */
+bool_t xdr_compressed_array(XDR* xdrs, char* data, uint64_t count, int data_type, int* compressed)
+{
+    *compressed = 0;
+
+    size_t size = getSizeOf((UDA_TYPE)data_type);
+    size_t bytes = (size_t)count * size;
+    int encoding = ArrayUncompressed;
+    std::vector<char> buffer;
+
+    if (xdrs->x_op == XDR_ENCODE && littleEndianHost() && bytes >= CompressMinBytes) {
+        size_t sample = CompressSampleBytes / size;
+        if (bytes <= 2 * CompressSampleBytes || deflate_array(data, sample, size, buffer)) {
+            if (deflate_array(data, count, size, buffer)) {
+                encoding = ArrayShuffleDeflate;
+            }
+        }
+    }
+
+    if (!xdr_int(xdrs, &encoding)) {
+        return 0;
+    }
+
+    if (encoding == ArrayUncompressed) {
+        return 1;
+    }
+    if (encoding != ArrayShuffleDeflate) {
+        UDA_LOG(UDA_LOG_ERROR, "unknown data array encoding: %d\n", encoding);
+        return 0;
+    }
+
+    *compressed = 1;
+
+    uint64_t length = buffer.size();
+    if (!xdr_uint64_t(xdrs, &length)) {
+        return 0;
+    }
+
+    if (xdrs->x_op == XDR_ENCODE) {
+        UDA_LOG(UDA_LOG_DEBUG, "data array compressed from %zu to %zu bytes\n", bytes, buffer.size());
+        return xdr_opaque_bytes(xdrs, buffer.data(), buffer.size());
+    }
+
+    // The length comes off the wire: deflate never needs more than compressBound of the array
+    if (length > compressBound((uLong)bytes)) {
+        UDA_LOG(UDA_LOG_ERROR, "compressed data array length %llu exceeds the bound for %zu bytes\n",
+                (unsigned long long)length, bytes);
+        return 0;
+    }
+
+    buffer.resize(length);
+    if (!xdr_opaque_bytes(xdrs, buffer.data(), length)) {
+        return 0;
+    }
+
+    std::vector<char> shuffled(bytes);
+    uLongf inflated = (uLongf)bytes;
+    if (uncompress((Bytef*)shuffled.data(), &inflated, (const Bytef*)buffer.data(), (uLong)length) != Z_OK
+        || inflated != bytes) {
+        UDA_LOG(UDA_LOG_ERROR, "corrupt compressed data array\n");
+        return 0;
+    }
+    unshuffle(shuffled.data(), data, count, size);
+
+    if (!littleEndianHost()) {
+        swap_little_endian(data, bytes, data_type);
+    }
+
+    return 1;
+}
+
+//-----------------------------------------------------------------------
+// Record Stream Buffer Sizes
+
+// The xdrrec buffer sets the size of each read and write system call, and a large array passes through it in buffer
+// sized pieces. A stream starts with a small buffer, which suits the many small messages, and after a bulk transfer
+// may be re-created with a larger one, doubled until it is about a sixteenth of the transfer, up to max_size. Smaller
+// transfers leave the buffer as it is, and it never shrinks.
+
+u_int xdr_record_buffer_size(u_int buffer_size, size_t transfer_size, u_int max_size)
+{
+    if (transfer_size / 16 <= buffer_size || buffer_size >= max_size) {
+        return buffer_size;
+    }
+
+    size_t size = buffer_size;
+    while (size < transfer_size / 16 && size < max_size) {
+        size *= 2;
+    }
+
+    return (u_int)std::min(size, (size_t)max_size);
+}
+
+//-----------------------------------------------------------------------
+// Streamed Data Arrays
+//
+// From protocol version 10 a client may ask for data arrays to be streamed (DATA_BLOCK_LIST::stream_data): the data
+// block list is then sent without the data arrays of atomic data blocks, and each such array follows as a sequence of
+// bounded chunks (DATA_CHUNK) ending with an empty chunk. Both sides select the streamed blocks from the data block
+// fields already passed, so no per-block flag is needed. Blocks with error arrays are always sent whole.
+
+int streamedDataBlock(const DATA_BLOCK* data_block)
+{
+    return data_block->data_n > 0
+           && data_block->data_type != UDA_TYPE_UNKNOWN
+           && data_block->data_type != UDA_TYPE_COMPOUND
+           && data_block->data_type != UDA_TYPE_CAPNP
+           && data_block->error_type == UDA_TYPE_UNKNOWN
+           && data_block->error_param_n == 0;
+}
+
+bool_t xdr_data_chunk1(XDR* xdrs, DATA_CHUNK* str, int protocolVersion)
+{
+    return xdr_count(xdrs, &str->count, protocolVersion);
+}
+
+bool_t xdr_data_chunk2(XDR* xdrs, DATA_CHUNK* str)
+{
+    // Chunk elements are encoded as the data array of a data block of the same type
+
+    DATA_BLOCK data_block;
+    initDataBlock(&data_block);
+    data_block.data_type = str->data_type;
+    data_block.data_n = str->count;
+    data_block.data = str->data;
+
+    return xdr_data_block2(xdrs, &data_block, str->native_data, str->compress_data);
+}
+
 //-----------------------------------------------------------------------
 // Strings
 
@@ -223,7 +683,7 @@ bool_t xdr_server1(XDR* xdrs, SERVER_BLOCK* str, int protocolVersion)
 {
 
     int rc = 0;
-    static int serverVersion = 0;
+    static thread_local int serverVersion = 0;
 
     rc = xdr_int(xdrs, &str->version);
 
@@ -347,7 +807,28 @@ bool_t xdr_data_block_list(XDR* xdrs, DATA_BLOCK_LIST* str, int protocolVersion)
         rc = rc && xdr_int(xdrs, &str->count);
     }
 
+    // Native data arrays are raw little-endian bytes: never sent by a big-endian host
+
+    if (protocolVersion >= 10) {
+        if (xdrs->x_op == XDR_ENCODE && !littleEndianHost()) {
+            str->native_data = 0;
+        }
+        rc = rc && xdr_int(xdrs, &str->native_data) && xdr_int(xdrs, &str->stream_data);
+    } else {
+        str->native_data = 0;
+        str->stream_data = 0;
+    }
+
+    if (protocolVersion >= 11) {
+        rc = rc && xdr_int(xdrs, &str->compress_data);
+    } else {
+        str->compress_data = 0;
+    }
+
     UDA_LOG(UDA_LOG_DEBUG, "number of data blocks: %d\n", str->count);
+    UDA_LOG(UDA_LOG_DEBUG, "native data arrays: %d\n", str->native_data);
+    UDA_LOG(UDA_LOG_DEBUG, "streamed data arrays: %d\n", str->stream_data);
+    UDA_LOG(UDA_LOG_DEBUG, "compressed data arrays: %d\n", str->compress_data);
     return rc;
 }
 
@@ -376,53 +857,58 @@ bool_t xdr_putdata_block2(XDR* xdrs, PUTDATA_BLOCK* str)
 {
     int rc = 1;
     if (str->rank > 0) {
-        rc = rc && xdr_vector(xdrs, (char*)str->shape, (int)str->rank, sizeof(int), (xdrproc_t)xdr_int);
+        rc = rc && xdr_bulk_vector(xdrs, (char*)str->shape, (int)str->rank, sizeof(int), (xdrproc_t)xdr_int);
     }
 
     if (str->blockNameLength > 0) rc = rc && WrapXDRString(xdrs, (char*)str->blockName, str->blockNameLength + 1);
 
     switch (str->data_type) {
         case UDA_TYPE_FLOAT:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(float), (xdrproc_t)xdr_float);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(float), (xdrproc_t)xdr_float);
         case UDA_TYPE_DOUBLE:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(double), (xdrproc_t)xdr_double);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(double),
+                                         (xdrproc_t)xdr_double);
         case UDA_TYPE_CHAR:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(char), (xdrproc_t)xdr_char);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(char), (xdrproc_t)xdr_char);
         case UDA_TYPE_SHORT:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(short), (xdrproc_t)xdr_short);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(short), (xdrproc_t)xdr_short);
         case UDA_TYPE_INT:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(int), (xdrproc_t)xdr_int);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(int), (xdrproc_t)xdr_int);
         case UDA_TYPE_LONG:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(long), (xdrproc_t)xdr_long);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(long), (xdrproc_t)xdr_long);
         case UDA_TYPE_LONG64:
             return rc &&
-                   xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(long long int), (xdrproc_t)xdr_int64_t);
+                   xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(long long int),
+                                   (xdrproc_t)xdr_int64_t);
         case UDA_TYPE_UNSIGNED_CHAR:
             return rc &&
-                   xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned char), (xdrproc_t)xdr_u_char);
+                   xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned char),
+                                   (xdrproc_t)xdr_u_char);
         case UDA_TYPE_UNSIGNED_SHORT:
             return rc &&
-                   xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned short), (xdrproc_t)xdr_u_short);
+                   xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned short),
+                                   (xdrproc_t)xdr_u_short);
         case UDA_TYPE_UNSIGNED_INT:
             return rc &&
-                   xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
+                   xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
         case UDA_TYPE_UNSIGNED_LONG:
             return rc &&
-                   xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned long), (xdrproc_t)xdr_u_long);
+                   xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned long),
+                                   (xdrproc_t)xdr_u_long);
         case UDA_TYPE_UNSIGNED_LONG64:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned long long int),
-                                    (xdrproc_t)xdr_uint64_t);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(unsigned long long int),
+                                         (xdrproc_t)xdr_uint64_t);
             // Strings are passed as a regular array of CHARs
 
         case UDA_TYPE_STRING:
-            return rc && xdr_vector(xdrs, (char*)str->data, (int)str->count, sizeof(char), (xdrproc_t)xdr_char);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, (int)str->count, sizeof(char), (xdrproc_t)xdr_char);
 
             // Complex structure is a simple two float combination: => twice the number of element transmitted
 
         case UDA_TYPE_DCOMPLEX:
-            return rc && xdr_vector(xdrs, (char*)str->data, 2 * str->count, sizeof(double), (xdrproc_t)xdr_double);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, 2 * str->count, sizeof(double), (xdrproc_t)xdr_double);
         case UDA_TYPE_COMPLEX:
-            return rc && xdr_vector(xdrs, (char*)str->data, 2 * str->count, sizeof(float), (xdrproc_t)xdr_float);
+            return rc && xdr_bulk_vector(xdrs, (char*)str->data, 2 * str->count, sizeof(float), (xdrproc_t)xdr_float);
 
             // General Data structures are passed using a specialised set of xdr components
 
@@ -465,7 +951,7 @@ xdr_serialise_object(XDR* xdrs, LOGMALLOCLIST* logmalloclist, USERDEFINEDTYPELIS
 
         SARRAY sarray;                                // Structure array carrier structure
         SARRAY* psarray = &sarray;
-        int shape = str->data_n;                            // rank 1 array of dimension lengths
+        int shape = (int)str->data_n;                       // rank 1 array of dimension lengths
         auto udt = (USERDEFINEDTYPE*)str->opaque_block;        // The data's structure definition
         auto u = findUserDefinedType(userdefinedtypelist, "SARRAY",
                                                  0); // Locate the carrier structure definition
@@ -477,7 +963,7 @@ xdr_serialise_object(XDR* xdrs, LOGMALLOCLIST* logmalloclist, USERDEFINEDTYPELIS
         }
 
         initSArray(&sarray);
-        sarray.count = str->data_n;                 // Number of this structure
+        sarray.count = (int)str->data_n;            // Number of this structure
         sarray.rank = 1;                            // Array Data Rank?
         sarray.shape = &shape;                      // Only if rank > 1?
         sarray.data = (void*)str->data;             // Pointer to the data to be passed
@@ -578,9 +1064,32 @@ xdr_serialise_object(XDR* xdrs, LOGMALLOCLIST* logmalloclist, USERDEFINEDTYPELIS
 //-----------------------------------------------------------------------
 // Data from File Source
 
+/**
+ * Array lengths are passed as 64 bit integers from protocol version 10. Earlier versions pass 32 bits, so a count that
+ * does not fit cannot be sent to an older peer.
+ */
+bool_t xdr_count(XDR* xdrs, int64_t* count, int protocolVersion)
+{
+    if (protocolVersion >= 10) {
+        return xdr_int64_t(xdrs, count);
+    }
+
+    if (xdrs->x_op == XDR_ENCODE && (*count > INT_MAX || *count < 0)) {
+        UDA_LOG(UDA_LOG_DEBUG, "Array length %lld requires protocol version 10\n", (long long)*count);
+        return 0;
+    }
+
+    int n = (int)*count;
+    int rc = xdr_int(xdrs, &n);
+    if (xdrs->x_op == XDR_DECODE) {
+        *count = n;
+    }
+    return rc;
+}
+
 bool_t xdr_data_block1(XDR* xdrs, DATA_BLOCK* str, int protocolVersion)
 {
-    int rc = xdr_int(xdrs, &str->data_n);
+    int rc = xdr_count(xdrs, &str->data_n, protocolVersion);
     rc = rc && xdr_u_int(xdrs, &str->rank);
     rc = rc && xdr_int(xdrs, &str->order);
     rc = rc && xdr_int(xdrs, &str->data_type);
@@ -613,45 +1122,59 @@ bool_t xdr_data_block1(XDR* xdrs, DATA_BLOCK* str, int protocolVersion)
     return rc;
 }
 
-bool_t xdr_data_block2(XDR* xdrs, DATA_BLOCK* str)
+bool_t xdr_data_block2(XDR* xdrs, DATA_BLOCK* str, bool native, bool compress)
 {
+    if (compress && nativeArrayType(str->data_type)) {
+        int compressed = 0;
+        if (!xdr_compressed_array(xdrs, str->data, str->data_n, str->data_type, &compressed)) {
+            return 0;
+        }
+        if (compressed) {
+            return 1;
+        }
+    }
+
+    if (native && nativeArrayType(str->data_type)) {
+        return xdr_native_array(xdrs, str->data, str->data_n, str->data_type);
+    }
+
     switch (str->data_type) {
         case UDA_TYPE_FLOAT:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(float), (xdrproc_t)xdr_float);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(float), (xdrproc_t)xdr_float);
         case UDA_TYPE_DOUBLE:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(double), (xdrproc_t)xdr_double);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(double), (xdrproc_t)xdr_double);
         case UDA_TYPE_CHAR:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(char), (xdrproc_t)xdr_char);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(char), (xdrproc_t)xdr_char);
         case UDA_TYPE_SHORT:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(short), (xdrproc_t)xdr_short);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(short), (xdrproc_t)xdr_short);
         case UDA_TYPE_INT:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(int), (xdrproc_t)xdr_int);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(int), (xdrproc_t)xdr_int);
         case UDA_TYPE_LONG:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(long), (xdrproc_t)xdr_long);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(long), (xdrproc_t)xdr_long);
         case UDA_TYPE_LONG64:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(long long int), (xdrproc_t)xdr_int64_t);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(long long int), (xdrproc_t)xdr_int64_t);
         case UDA_TYPE_UNSIGNED_CHAR:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(unsigned char), (xdrproc_t)xdr_u_char);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(unsigned char), (xdrproc_t)xdr_u_char);
         case UDA_TYPE_UNSIGNED_SHORT:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(unsigned short), (xdrproc_t)xdr_u_short);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(unsigned short), (xdrproc_t)xdr_u_short);
         case UDA_TYPE_UNSIGNED_INT:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
         case UDA_TYPE_UNSIGNED_LONG:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(unsigned long), (xdrproc_t)xdr_u_long);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(unsigned long), (xdrproc_t)xdr_u_long);
         case UDA_TYPE_UNSIGNED_LONG64:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(unsigned long long int),
-                              (xdrproc_t)xdr_uint64_t);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(unsigned long long int),
+                                   (xdrproc_t)xdr_uint64_t);
             // Strings are passed as a regular array of CHARs
 
         case UDA_TYPE_STRING:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(char), (xdrproc_t)xdr_char);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(char), (xdrproc_t)xdr_char);
 
             // Complex structure is a simple two float combination: => twice the number of element transmitted
 
         case UDA_TYPE_DCOMPLEX:
-            return xdr_vector(xdrs, str->data, 2 * (u_int)str->data_n, sizeof(double), (xdrproc_t)xdr_double);
+            return xdr_bulk_vector(xdrs, str->data, 2 * str->data_n, sizeof(double), (xdrproc_t)xdr_double);
         case UDA_TYPE_COMPLEX:
-            return xdr_vector(xdrs, str->data, 2 * (u_int)str->data_n, sizeof(float), (xdrproc_t)xdr_float);
+            return xdr_bulk_vector(xdrs, str->data, 2 * str->data_n, sizeof(float), (xdrproc_t)xdr_float);
 
             // General Data structures are passed using a specialised set of xdr components
 
@@ -659,105 +1182,135 @@ bool_t xdr_data_block2(XDR* xdrs, DATA_BLOCK* str)
             return 1;    // Nothing to send so retain good return code
 
         case UDA_TYPE_CAPNP:
-            return xdr_vector(xdrs, str->data, (u_int)str->data_n, sizeof(char), (xdrproc_t)xdr_char);
+            return xdr_bulk_vector(xdrs, str->data, str->data_n, sizeof(char), (xdrproc_t)xdr_char);
 
         default:
             return 0;
     }
 }
 
-bool_t xdr_data_block3(XDR* xdrs, DATA_BLOCK* str)
+bool_t xdr_data_block3(XDR* xdrs, DATA_BLOCK* str, bool native, bool compress)
 {
 
     if (str->error_param_n > 0) {
-        xdr_vector(xdrs, (char*)str->errparams, (u_int)str->error_param_n, sizeof(float), (xdrproc_t)xdr_float);
+        xdr_bulk_vector(xdrs, (char*)str->errparams, (u_int)str->error_param_n, sizeof(float), (xdrproc_t)xdr_float);
     }
 
     // Data Errors
 
+    if (compress && nativeArrayType(str->error_type)) {
+        int compressed = 0;
+        if (!xdr_compressed_array(xdrs, str->errhi, str->data_n, str->error_type, &compressed)) {
+            return 0;
+        }
+        if (compressed) {
+            return 1;
+        }
+    }
+
+    if (native && nativeArrayType(str->error_type)) {
+        return xdr_native_array(xdrs, str->errhi, str->data_n, str->error_type);
+    }
+
     switch (str->error_type) {
         case UDA_TYPE_FLOAT:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(float), (xdrproc_t)xdr_float);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(float), (xdrproc_t)xdr_float);
         case UDA_TYPE_DOUBLE:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(double), (xdrproc_t)xdr_double);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(double), (xdrproc_t)xdr_double);
         case UDA_TYPE_CHAR:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(char), (xdrproc_t)xdr_char);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(char), (xdrproc_t)xdr_char);
         case UDA_TYPE_SHORT:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(short), (xdrproc_t)xdr_short);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(short), (xdrproc_t)xdr_short);
         case UDA_TYPE_INT:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(int), (xdrproc_t)xdr_int);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(int), (xdrproc_t)xdr_int);
         case UDA_TYPE_LONG:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(long), (xdrproc_t)xdr_long);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(long), (xdrproc_t)xdr_long);
         case UDA_TYPE_LONG64:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(long long int), (xdrproc_t)xdr_int64_t);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(long long int), (xdrproc_t)xdr_int64_t);
         case UDA_TYPE_UNSIGNED_CHAR:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(unsigned char), (xdrproc_t)xdr_u_char);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(unsigned char), (xdrproc_t)xdr_u_char);
         case UDA_TYPE_UNSIGNED_SHORT:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(unsigned short), (xdrproc_t)xdr_u_short);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(unsigned short),
+                                   (xdrproc_t)xdr_u_short);
         case UDA_TYPE_UNSIGNED_INT:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
         case UDA_TYPE_UNSIGNED_LONG:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(unsigned long), (xdrproc_t)xdr_u_long);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(unsigned long), (xdrproc_t)xdr_u_long);
         case UDA_TYPE_UNSIGNED_LONG64:
-            return xdr_vector(xdrs, str->errhi, (u_int)str->data_n, sizeof(unsigned long long int),
-                              (xdrproc_t)xdr_uint64_t);
+            return xdr_bulk_vector(xdrs, str->errhi, str->data_n, sizeof(unsigned long long int),
+                                   (xdrproc_t)xdr_uint64_t);
             // Complex structure is a simple two float combination: => twice the number of element transmitted
 
         case UDA_TYPE_DCOMPLEX:
-            return xdr_vector(xdrs, str->errhi, 2 * (u_int)str->data_n, sizeof(double), (xdrproc_t)xdr_double);
+            return xdr_bulk_vector(xdrs, str->errhi, 2 * str->data_n, sizeof(double), (xdrproc_t)xdr_double);
         case UDA_TYPE_COMPLEX:
-            return xdr_vector(xdrs, str->errhi, 2 * (u_int)str->data_n, sizeof(float), (xdrproc_t)xdr_float);
+            return xdr_bulk_vector(xdrs, str->errhi, 2 * str->data_n, sizeof(float), (xdrproc_t)xdr_float);
 
         default:
             return 1;
     }
 }
 
-bool_t xdr_data_block4(XDR* xdrs, DATA_BLOCK* str)
+bool_t xdr_data_block4(XDR* xdrs, DATA_BLOCK* str, bool native, bool compress)
 {
     if (!str->errasymmetry) return 1;    // Nothing New to Pass or Receive (same as errhi!)
 
+    if (compress && nativeArrayType(str->error_type)) {
+        int compressed = 0;
+        if (!xdr_compressed_array(xdrs, str->errlo, str->data_n, str->error_type, &compressed)) {
+            return 0;
+        }
+        if (compressed) {
+            return 1;
+        }
+    }
+
+    if (native && nativeArrayType(str->error_type)) {
+        return xdr_native_array(xdrs, str->errlo, str->data_n, str->error_type);
+    }
+
     // Asymmetric Data Errors
 
     switch (str->error_type) {
         case UDA_TYPE_FLOAT:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(float), (xdrproc_t)xdr_float);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(float), (xdrproc_t)xdr_float);
         case UDA_TYPE_DOUBLE:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(double), (xdrproc_t)xdr_double);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(double), (xdrproc_t)xdr_double);
         case UDA_TYPE_CHAR:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(char), (xdrproc_t)xdr_char);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(char), (xdrproc_t)xdr_char);
         case UDA_TYPE_SHORT:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(short), (xdrproc_t)xdr_short);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(short), (xdrproc_t)xdr_short);
         case UDA_TYPE_INT:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(int), (xdrproc_t)xdr_int);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(int), (xdrproc_t)xdr_int);
         case UDA_TYPE_LONG:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(long), (xdrproc_t)xdr_long);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(long), (xdrproc_t)xdr_long);
         case UDA_TYPE_LONG64:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(long long int), (xdrproc_t)xdr_int64_t);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(long long int), (xdrproc_t)xdr_int64_t);
         case UDA_TYPE_UNSIGNED_CHAR:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(unsigned char), (xdrproc_t)xdr_u_char);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(unsigned char), (xdrproc_t)xdr_u_char);
         case UDA_TYPE_UNSIGNED_SHORT:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(unsigned short), (xdrproc_t)xdr_u_short);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(unsigned short),
+                                   (xdrproc_t)xdr_u_short);
         case UDA_TYPE_UNSIGNED_INT:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(unsigned int), (xdrproc_t)xdr_u_int);
         case UDA_TYPE_UNSIGNED_LONG:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(unsigned long), (xdrproc_t)xdr_u_long);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(unsigned long), (xdrproc_t)xdr_u_long);
         case UDA_TYPE_UNSIGNED_LONG64:
-            return xdr_vector(xdrs, str->errlo, (u_int)str->data_n, sizeof(unsigned long long int),
-                              (xdrproc_t)xdr_uint64_t);
+            return xdr_bulk_vector(xdrs, str->errlo, str->data_n, sizeof(unsigned long long int),
+                                   (xdrproc_t)xdr_uint64_t);
             // Complex structure is a simple two float combination: => twice the number of element transmitted
 
         case UDA_TYPE_DCOMPLEX:
-            return xdr_vector(xdrs, str->errlo, 2 * (u_int)str->data_n, sizeof(double), (xdrproc_t)xdr_double);
+            return xdr_bulk_vector(xdrs, str->errlo, 2 * str->data_n, sizeof(double), (xdrproc_t)xdr_double);
         case UDA_TYPE_COMPLEX:
-            return xdr_vector(xdrs, str->errlo, 2 * (u_int)str->data_n, sizeof(float), (xdrproc_t)xdr_float);
+            return xdr_bulk_vector(xdrs, str->errlo, 2 * str->data_n, sizeof(float), (xdrproc_t)xdr_float);
 
         default:
             return 1;
     }
 }
 
-bool_t xdr_data_dim1(XDR* xdrs, DATA_BLOCK* str)
+bool_t xdr_data_dim1(XDR* xdrs, DATA_BLOCK* str, int protocolVersion)
 {
     int rc = 1;
     for (unsigned int i = 0; i < str->rank; i++) {
@@ -766,7 +1319,7 @@ bool_t xdr_data_dim1(XDR* xdrs, DATA_BLOCK* str)
              && xdr_int(xdrs, &str->dims[i].error_model)
              && xdr_int(xdrs, &str->dims[i].errasymmetry)
              && xdr_int(xdrs, &str->dims[i].error_param_n)
-             && xdr_int(xdrs, &str->dims[i].dim_n)
+             && xdr_count(xdrs, &str->dims[i].dim_n, protocolVersion)
              && xdr_int(xdrs, &str->dims[i].compressed)
              && xdr_double(xdrs, &str->dims[i].dim0)
              && xdr_double(xdrs, &str->dims[i].diff)
@@ -779,91 +1332,98 @@ bool_t xdr_data_dim1(XDR* xdrs, DATA_BLOCK* str)
     return rc;
 }
 
-bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
+bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str, bool native)
 {
     for (unsigned int i = 0; i < str->rank; i++) {
         if (str->dims[i].compressed == 0) {
+            if (native && nativeArrayType(str->dims[i].data_type)) {
+                if (!xdr_native_array(xdrs, str->dims[i].dim, str->dims[i].dim_n, str->dims[i].data_type)) {
+                    return 0;
+                }
+                continue;
+            }
+
             switch (str->dims[i].data_type) {
 
                 case UDA_TYPE_FLOAT:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(float), (xdrproc_t)xdr_float)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(float), (xdrproc_t)xdr_float)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_DOUBLE:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(double), (xdrproc_t)xdr_double)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(double), (xdrproc_t)xdr_double)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_CHAR:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(char), (xdrproc_t)xdr_char)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(char), (xdrproc_t)xdr_char)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_SHORT:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(short), (xdrproc_t)xdr_short)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(short), (xdrproc_t)xdr_short)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_INT:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(int), (xdrproc_t)xdr_int)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(int), (xdrproc_t)xdr_int)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_LONG:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(long), (xdrproc_t)xdr_long)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(long), (xdrproc_t)xdr_long)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_LONG64:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(long long int), (xdrproc_t)xdr_int64_t)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(long long int), (xdrproc_t)xdr_int64_t)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_UNSIGNED_CHAR:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(unsigned char), (xdrproc_t)xdr_u_char)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(unsigned char), (xdrproc_t)xdr_u_char)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_UNSIGNED_SHORT:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(unsigned short), (xdrproc_t)xdr_u_short)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(unsigned short), (xdrproc_t)xdr_u_short)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_UNSIGNED_INT:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(unsigned int), (xdrproc_t)xdr_u_int)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(unsigned int), (xdrproc_t)xdr_u_int)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_UNSIGNED_LONG:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(unsigned long), (xdrproc_t)xdr_u_long)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(unsigned long), (xdrproc_t)xdr_u_long)) {
                         return 0;
                     }
                     break;
                 case UDA_TYPE_UNSIGNED_LONG64:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, (u_int)str->dims[i].dim_n,
-                                    sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, str->dims[i].dim_n,
+                                         sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t)) {
                         return 0;
                     }
                     break;
@@ -871,15 +1431,15 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     // Complex structure is a simple two float combination: => twice the number of element transmitted
 
                 case UDA_TYPE_DCOMPLEX:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, 2 * (u_int)str->dims[i].dim_n,
-                                    sizeof(double), (xdrproc_t)xdr_double)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, 2 * str->dims[i].dim_n,
+                                         sizeof(double), (xdrproc_t)xdr_double)) {
                         return 0;
                     }
                     break;
 
                 case UDA_TYPE_COMPLEX:
-                    if (!xdr_vector(xdrs, str->dims[i].dim, 2 * (u_int)str->dims[i].dim_n,
-                                    sizeof(float), (xdrproc_t)xdr_float)) {
+                    if (!xdr_bulk_vector(xdrs, str->dims[i].dim, 2 * str->dims[i].dim_n,
+                                         sizeof(float), (xdrproc_t)xdr_float)) {
                         return 0;
                     }
                     break;
@@ -893,24 +1453,25 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_FLOAT:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(float), (xdrproc_t)xdr_float)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(float), (xdrproc_t)xdr_float))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(float), (xdrproc_t)xdr_float)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(float), (xdrproc_t)xdr_float))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(float), (xdrproc_t)xdr_float)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(float), (xdrproc_t)xdr_float)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(float), (xdrproc_t)xdr_float)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(float), (xdrproc_t)xdr_float))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(float), (xdrproc_t)xdr_float)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(float),
+                                                         (xdrproc_t)xdr_float))) {
                                     return 0;
                                 }
                                 break;
@@ -920,25 +1481,26 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_DOUBLE:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, str->dims[i].udoms,
-                                                    sizeof(double), (xdrproc_t)xdr_double)
-                                      && xdr_vector(xdrs, str->dims[i].ints, str->dims[i].udoms,
-                                                    sizeof(double), (xdrproc_t)xdr_double))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, str->dims[i].udoms,
+                                                         sizeof(double), (xdrproc_t)xdr_double)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, str->dims[i].udoms,
+                                                         sizeof(double), (xdrproc_t)xdr_double))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, str->dims[i].udoms,
-                                                sizeof(double), (xdrproc_t)xdr_double)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, str->dims[i].udoms,
+                                                     sizeof(double), (xdrproc_t)xdr_double)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(double), (xdrproc_t)xdr_double)
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(double), (xdrproc_t)xdr_double)
                                       &&
-                                      xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(double), (xdrproc_t)xdr_double))) {
+                                      xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(double),
+                                                      (xdrproc_t)xdr_double))) {
                                     return 0;
                                 }
                                 break;
@@ -948,24 +1510,25 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_CHAR:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(char), (xdrproc_t)xdr_char)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(char), (xdrproc_t)xdr_char))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(char), (xdrproc_t)xdr_char)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(char), (xdrproc_t)xdr_char))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(char), (xdrproc_t)xdr_char)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(char), (xdrproc_t)xdr_char)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(char), (xdrproc_t)xdr_char)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(char), (xdrproc_t)xdr_char))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(char), (xdrproc_t)xdr_char)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(char),
+                                                         (xdrproc_t)xdr_char))) {
                                     return 0;
                                 }
                                 break;
@@ -975,24 +1538,25 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_SHORT:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(short), (xdrproc_t)xdr_short)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(short), (xdrproc_t)xdr_short))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(short), (xdrproc_t)xdr_short)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(short), (xdrproc_t)xdr_short))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(short), (xdrproc_t)xdr_short)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(short), (xdrproc_t)xdr_short)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(short), (xdrproc_t)xdr_short)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(short), (xdrproc_t)xdr_short))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(short), (xdrproc_t)xdr_short)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(short),
+                                                         (xdrproc_t)xdr_short))) {
                                     return 0;
                                 }
                                 break;
@@ -1002,24 +1566,25 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_INT:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(int), (xdrproc_t)xdr_int))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(int), (xdrproc_t)xdr_int))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(int), (xdrproc_t)xdr_int)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(int), (xdrproc_t)xdr_int)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(int), (xdrproc_t)xdr_int))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(int),
+                                                         (xdrproc_t)xdr_int))) {
                                     return 0;
                                 }
                                 break;
@@ -1029,24 +1594,25 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_LONG:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(long), (xdrproc_t)xdr_long)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(long), (xdrproc_t)xdr_long))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(long), (xdrproc_t)xdr_long)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(long), (xdrproc_t)xdr_long))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(long), (xdrproc_t)xdr_long)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(long), (xdrproc_t)xdr_long)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(long), (xdrproc_t)xdr_long)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(long), (xdrproc_t)xdr_long))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(long), (xdrproc_t)xdr_long)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(long),
+                                                         (xdrproc_t)xdr_long))) {
                                     return 0;
                                 }
                                 break;
@@ -1056,26 +1622,26 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_LONG64:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(long long int), (xdrproc_t)xdr_int64_t)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(long long int), (xdrproc_t)xdr_int64_t))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(long long int), (xdrproc_t)xdr_int64_t)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(long long int), (xdrproc_t)xdr_int64_t))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(long long int), (xdrproc_t)xdr_int64_t)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(long long int), (xdrproc_t)xdr_int64_t)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(long long int),
-                                                 (xdrproc_t)xdr_int64_t)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(long long int),
-                                                    (xdrproc_t)xdr_int64_t))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(long long int),
+                                                      (xdrproc_t)xdr_int64_t)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(long long int),
+                                                         (xdrproc_t)xdr_int64_t))) {
                                     return 0;
                                 }
                                 break;
@@ -1085,26 +1651,26 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_UNSIGNED_CHAR:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned char), (xdrproc_t)xdr_u_char)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned char), (xdrproc_t)xdr_u_char))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned char), (xdrproc_t)xdr_u_char)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned char), (xdrproc_t)xdr_u_char))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(unsigned char), (xdrproc_t)xdr_u_char)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(unsigned char), (xdrproc_t)xdr_u_char)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned char),
-                                                 (xdrproc_t)xdr_u_char)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned char),
-                                                    (xdrproc_t)xdr_u_char))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned char),
+                                                      (xdrproc_t)xdr_u_char)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned char),
+                                                         (xdrproc_t)xdr_u_char))) {
                                     return 0;
                                 }
                                 break;
@@ -1114,26 +1680,26 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_UNSIGNED_SHORT:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned short), (xdrproc_t)xdr_u_short)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned short), (xdrproc_t)xdr_u_short))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned short), (xdrproc_t)xdr_u_short)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned short), (xdrproc_t)xdr_u_short))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(unsigned short), (xdrproc_t)xdr_u_short)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(unsigned short), (xdrproc_t)xdr_u_short)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned short),
-                                                 (xdrproc_t)xdr_u_short)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned short),
-                                                    (xdrproc_t)xdr_u_short))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned short),
+                                                      (xdrproc_t)xdr_u_short)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned short),
+                                                         (xdrproc_t)xdr_u_short))) {
                                     return 0;
                                 }
                                 break;
@@ -1143,25 +1709,26 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_UNSIGNED_INT:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned int), (xdrproc_t)xdr_u_int)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned int), (xdrproc_t)xdr_u_int))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned int), (xdrproc_t)xdr_u_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned int), (xdrproc_t)xdr_u_int))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(unsigned int), (xdrproc_t)xdr_u_int)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(unsigned int), (xdrproc_t)xdr_u_int)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned int), (xdrproc_t)xdr_u_int)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned int),
-                                                    (xdrproc_t)xdr_u_int))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned int),
+                                                      (xdrproc_t)xdr_u_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned int),
+                                                         (xdrproc_t)xdr_u_int))) {
                                     return 0;
                                 }
                                 break;
@@ -1171,26 +1738,26 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_UNSIGNED_LONG:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned long), (xdrproc_t)xdr_u_long)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned long), (xdrproc_t)xdr_u_long))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned long), (xdrproc_t)xdr_u_long)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned long), (xdrproc_t)xdr_u_long))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(unsigned long), (xdrproc_t)xdr_u_long)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(unsigned long), (xdrproc_t)xdr_u_long)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned long),
-                                                 (xdrproc_t)xdr_u_long)
-                                      && xdr_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned long),
-                                                    (xdrproc_t)xdr_u_long))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, 1, sizeof(unsigned long),
+                                                      (xdrproc_t)xdr_u_long)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, 1, sizeof(unsigned long),
+                                                         (xdrproc_t)xdr_u_long))) {
                                     return 0;
                                 }
                                 break;
@@ -1199,26 +1766,26 @@ bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str)
                     case UDA_TYPE_UNSIGNED_LONG64:
                         switch (str->dims[i].method) {
                             case 1:
-                                if (!(xdr_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
-                                                 sizeof(int), (xdrproc_t)xdr_int)
-                                      && xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
-                                                    sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t))) {
+                                if (!(xdr_bulk_vector(xdrs, (char*)str->dims[i].sams, (int)str->dims[i].udoms,
+                                                      sizeof(int), (xdrproc_t)xdr_int)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)str->dims[i].udoms,
+                                                         sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t))) {
                                     return 0;
                                 }
                                 break;
                             case 2:
-                                if (!xdr_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
-                                                sizeof(unsigned long), (xdrproc_t)xdr_uint64_t)) {
+                                if (!xdr_bulk_vector(xdrs, str->dims[i].offs, (int)str->dims[i].udoms,
+                                                     sizeof(unsigned long), (xdrproc_t)xdr_uint64_t)) {
                                     return 0;
                                 }
                                 break;
                             case 3:
-                                if (!(xdr_vector(xdrs, str->dims[i].offs, (int)1,
-                                                 sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t)
-                                      && xdr_vector(xdrs, str->dims[i].ints, (int)1,
-                                                    sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t))) {
+                                if (!(xdr_bulk_vector(xdrs, str->dims[i].offs, (int)1,
+                                                      sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t)
+                                      && xdr_bulk_vector(xdrs, str->dims[i].ints, (int)1,
+                                                         sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t))) {
                                     return 0;
                                 }
                                 break;
@@ -1243,69 +1810,69 @@ bool_t xdr_data_dim3(XDR* xdrs, DATA_BLOCK* str)
     for (unsigned int i = 0; i < str->rank; i++) {
 
         if (str->dims[i].error_param_n > 0) {
-            xdr_vector(xdrs, (char*)str->dims[i].errparams, (unsigned int)str->dims[i].error_param_n,
-                       sizeof(float), (xdrproc_t)xdr_float);
+            xdr_bulk_vector(xdrs, (char*)str->dims[i].errparams, (unsigned int)str->dims[i].error_param_n,
+                            sizeof(float), (xdrproc_t)xdr_float);
         }
 
         switch (str->dims[i].error_type) {
             case UDA_TYPE_FLOAT:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(float),
-                                (xdrproc_t)xdr_float);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(float),
+                                     (xdrproc_t)xdr_float);
                 break;
             case UDA_TYPE_DOUBLE:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(double),
-                                (xdrproc_t)xdr_double);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(double),
+                                     (xdrproc_t)xdr_double);
                 break;
             case UDA_TYPE_CHAR:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(char),
-                                (xdrproc_t)xdr_char);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(char),
+                                     (xdrproc_t)xdr_char);
                 break;
             case UDA_TYPE_SHORT:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(short),
-                                (xdrproc_t)xdr_short);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(short),
+                                     (xdrproc_t)xdr_short);
                 break;
             case UDA_TYPE_INT:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(int),
-                                (xdrproc_t)xdr_int);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(int),
+                                     (xdrproc_t)xdr_int);
                 break;
             case UDA_TYPE_LONG:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(long),
-                                (xdrproc_t)xdr_long);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(long),
+                                     (xdrproc_t)xdr_long);
                 break;
             case UDA_TYPE_LONG64:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(long long int),
-                                (xdrproc_t)xdr_int64_t);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(long long int),
+                                     (xdrproc_t)xdr_int64_t);
                 break;
             case UDA_TYPE_UNSIGNED_CHAR:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(unsigned char),
-                                (xdrproc_t)xdr_u_char);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(unsigned char),
+                                     (xdrproc_t)xdr_u_char);
                 break;
             case UDA_TYPE_UNSIGNED_SHORT:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(unsigned short),
-                                (xdrproc_t)xdr_u_short);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(unsigned short),
+                                     (xdrproc_t)xdr_u_short);
                 break;
             case UDA_TYPE_UNSIGNED_INT:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(unsigned int),
-                                (xdrproc_t)xdr_u_int);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(unsigned int),
+                                     (xdrproc_t)xdr_u_int);
                 break;
             case UDA_TYPE_UNSIGNED_LONG:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n, sizeof(unsigned long),
-                                (xdrproc_t)xdr_u_long);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n, sizeof(unsigned long),
+                                     (xdrproc_t)xdr_u_long);
                 break;
             case UDA_TYPE_UNSIGNED_LONG64:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, (u_int)str->dims[i].dim_n,
-                                sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, str->dims[i].dim_n,
+                                     sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t);
                 break;
 
                 // Complex structure is a simple two float combination: => twice the number of element transmitted
 
             case UDA_TYPE_DCOMPLEX:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, 2 * (u_int)str->dims[i].dim_n, sizeof(double),
-                                (xdrproc_t)xdr_double);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, 2 * str->dims[i].dim_n, sizeof(double),
+                                     (xdrproc_t)xdr_double);
                 break;
             case UDA_TYPE_COMPLEX:
-                rc = xdr_vector(xdrs, str->dims[i].errhi, 2 * (u_int)str->dims[i].dim_n, sizeof(float),
-                                (xdrproc_t)xdr_float);
+                rc = xdr_bulk_vector(xdrs, str->dims[i].errhi, 2 * str->dims[i].dim_n, sizeof(float),
+                                     (xdrproc_t)xdr_float);
                 break;
 
             default:
@@ -1326,63 +1893,63 @@ bool_t xdr_data_dim4(XDR* xdrs, DATA_BLOCK* str)
         if (str->dims[i].errasymmetry) {
             switch (str->dims[i].error_type) {
                 case UDA_TYPE_FLOAT:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(float),
-                                    (xdrproc_t)xdr_float);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(float),
+                                         (xdrproc_t)xdr_float);
                     break;
                 case UDA_TYPE_DOUBLE:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(double),
-                                    (xdrproc_t)xdr_double);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(double),
+                                         (xdrproc_t)xdr_double);
                     break;
                 case UDA_TYPE_CHAR:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(char),
-                                    (xdrproc_t)xdr_char);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(char),
+                                         (xdrproc_t)xdr_char);
                     break;
                 case UDA_TYPE_SHORT:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(short),
-                                    (xdrproc_t)xdr_short);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(short),
+                                         (xdrproc_t)xdr_short);
                     break;
                 case UDA_TYPE_INT:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(int),
-                                    (xdrproc_t)xdr_int);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(int),
+                                         (xdrproc_t)xdr_int);
                     break;
                 case UDA_TYPE_LONG:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(long),
-                                    (xdrproc_t)xdr_long);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(long),
+                                         (xdrproc_t)xdr_long);
                     break;
                 case UDA_TYPE_LONG64:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(long long int),
-                                    (xdrproc_t)xdr_int64_t);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(long long int),
+                                         (xdrproc_t)xdr_int64_t);
                     break;
                 case UDA_TYPE_UNSIGNED_CHAR:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(unsigned char),
-                                    (xdrproc_t)xdr_u_char);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(unsigned char),
+                                         (xdrproc_t)xdr_u_char);
                     break;
                 case UDA_TYPE_UNSIGNED_SHORT:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(unsigned short),
-                                    (xdrproc_t)xdr_u_short);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(unsigned short),
+                                         (xdrproc_t)xdr_u_short);
                     break;
                 case UDA_TYPE_UNSIGNED_INT:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(unsigned int),
-                                    (xdrproc_t)xdr_u_int);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(unsigned int),
+                                         (xdrproc_t)xdr_u_int);
                     break;
                 case UDA_TYPE_UNSIGNED_LONG:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n, sizeof(unsigned long),
-                                    (xdrproc_t)xdr_u_long);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n, sizeof(unsigned long),
+                                         (xdrproc_t)xdr_u_long);
                     break;
                 case UDA_TYPE_UNSIGNED_LONG64:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, (u_int)str->dims[i].dim_n,
-                                    sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, str->dims[i].dim_n,
+                                         sizeof(unsigned long long int), (xdrproc_t)xdr_uint64_t);
                     break;
 
                     // Complex structure is a simple two float combination: => twice the number of element transmitted
 
                 case UDA_TYPE_DCOMPLEX:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, 2 * (u_int)str->dims[i].dim_n, sizeof(double),
-                                    (xdrproc_t)xdr_double);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, 2 * str->dims[i].dim_n, sizeof(double),
+                                         (xdrproc_t)xdr_double);
                     break;
                 case UDA_TYPE_COMPLEX:
-                    rc = xdr_vector(xdrs, str->dims[i].errlo, 2 * (u_int)str->dims[i].dim_n, sizeof(float),
-                                    (xdrproc_t)xdr_float);
+                    rc = xdr_bulk_vector(xdrs, str->dims[i].errlo, 2 * str->dims[i].dim_n, sizeof(float),
+                                         (xdrproc_t)xdr_float);
                     break;
 
                 default:
@@ -1520,6 +2087,6 @@ bool_t xdr_hdc_buffer_length(XDR* xdrs, uint64_t* n)
 
 bool_t xdr_hdc_buffer(XDR* xdrs, char* buffer, uint64_t n)
 {
-    int rc = xdr_vector(xdrs, buffer, n, sizeof(char), (xdrproc_t)xdr_char);
+    int rc = xdr_bulk_vector(xdrs, buffer, n, sizeof(char), (xdrproc_t)xdr_char);
     return rc;
 }
\ No newline at end of file
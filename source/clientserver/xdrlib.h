@@ -25,6 +25,35 @@
 
 int protocolVersionTypeTest(int protocolVersion, int type);
 
+//-----------------------------------------------------------------------
+// Arrays of atomic types: same encoding as xdr_vector, converted in bulk where the stream allows
+
+bool_t xdr_bulk_vector(XDR* xdrs, char* data, uint64_t count, u_int size, xdrproc_t xdr_element);
+
+//-----------------------------------------------------------------------
+// Arrays passed as raw little-endian bytes (protocol version 10+)
+
+int littleEndianHost();
+int nativeArrayType(int data_type);
+bool_t xdr_native_array(XDR* xdrs, char* data, uint64_t count, int data_type);
+
+//-----------------------------------------------------------------------
+// Data and error arrays shuffled and deflated (protocol version 11+)
+
+bool_t xdr_compressed_array(XDR* xdrs, char* data, uint64_t count, int data_type, int* compressed);
+
+//-----------------------------------------------------------------------
+// Record stream buffer size after a transfer of transfer_size bytes
+
+u_int xdr_record_buffer_size(u_int buffer_size, size_t transfer_size, u_int max_size);
+
+//-----------------------------------------------------------------------
+// Data arrays streamed as bounded chunks (protocol version 10+)
+
+int streamedDataBlock(const DATA_BLOCK* data_block);
+bool_t xdr_data_chunk1(XDR* xdrs, DATA_CHUNK* str, int protocolVersion);
+bool_t xdr_data_chunk2(XDR* xdrs, DATA_CHUNK* str);
+
 int wrap_string(XDR* xdrs, char* sp);
 
 int WrapXDRString(XDR* xdrs, const char* sp, int maxlen);
@@ -42,12 +71,13 @@ bool_t xdr_putdatablocklist_block(XDR* xdrs, PUTDATA_BLOCK_LIST* str);
 bool_t xdr_putdata_block1(XDR* xdrs, PUTDATA_BLOCK* str);
 bool_t xdr_putdata_block2(XDR* xdrs, PUTDATA_BLOCK* str);
 bool_t xdr_data_block_list(XDR* xdrs, DATA_BLOCK_LIST* str, int protocolVersion);
+bool_t xdr_count(XDR* xdrs, int64_t* count, int protocolVersion);
 bool_t xdr_data_block1(XDR* xdrs, DATA_BLOCK* str, int protocolVersion);
-bool_t xdr_data_block2(XDR* xdrs, DATA_BLOCK* str);
-bool_t xdr_data_block3(XDR* xdrs, DATA_BLOCK* str);
-bool_t xdr_data_block4(XDR* xdrs, DATA_BLOCK* str);
-bool_t xdr_data_dim1(XDR* xdrs, DATA_BLOCK* str);
-bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str);
+bool_t xdr_data_block2(XDR* xdrs, DATA_BLOCK* str, bool native, bool compress);
+bool_t xdr_data_block3(XDR* xdrs, DATA_BLOCK* str, bool native, bool compress);
+bool_t xdr_data_block4(XDR* xdrs, DATA_BLOCK* str, bool native, bool compress);
+bool_t xdr_data_dim1(XDR* xdrs, DATA_BLOCK* str, int protocolVersion);
+bool_t xdr_data_dim2(XDR* xdrs, DATA_BLOCK* str, bool native);
 bool_t xdr_data_dim3(XDR* xdrs, DATA_BLOCK* str);
 bool_t xdr_data_dim4(XDR* xdrs, DATA_BLOCK* str);
 bool_t xdr_data_object1(XDR* xdrs, DATA_OBJECT* str);
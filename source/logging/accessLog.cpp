@@ -31,28 +31,28 @@
 
 #endif
 
-unsigned int countDataBlockListSize(const DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block)
+size_t countDataBlockListSize(const DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block)
 {
-    unsigned int total = 0;
+    size_t total = 0;
     for (int i = 0; i < data_block_list->count; ++i) {
         total += countDataBlockSize(&data_block_list->data[i], client_block);
     }
     return total;
 }
 
-unsigned int countDataBlockSize(const DATA_BLOCK* data_block, CLIENT_BLOCK* client_block)
+size_t countDataBlockSize(const DATA_BLOCK* data_block, CLIENT_BLOCK* client_block)
 {
     int factor;
     DIMS dim;
-    unsigned int count = sizeof(DATA_BLOCK);
+    size_t count = sizeof(DATA_BLOCK);
 
-    count += (unsigned int)(getSizeOf((UDA_TYPE)data_block->data_type) * data_block->data_n);
+    count += (size_t)(getSizeOf((UDA_TYPE)data_block->data_type) * data_block->data_n);
 
     if (data_block->error_type != UDA_TYPE_UNKNOWN) {
-        count += (unsigned int)(getSizeOf((UDA_TYPE)data_block->error_type) * data_block->data_n);
+        count += (size_t)(getSizeOf((UDA_TYPE)data_block->error_type) * data_block->data_n);
     }
     if (data_block->errasymmetry) {
-        count += (unsigned int)(getSizeOf((UDA_TYPE)data_block->error_type) * data_block->data_n);
+        count += (size_t)(getSizeOf((UDA_TYPE)data_block->error_type) * data_block->data_n);
     }
 
     if (data_block->rank > 0) {
@@ -60,11 +60,11 @@ unsigned int countDataBlockSize(const DATA_BLOCK* data_block, CLIENT_BLOCK* clie
             count += sizeof(DIMS);
             dim = data_block->dims[k];
             if (!dim.compressed) {
-                count += (unsigned int)(getSizeOf((UDA_TYPE)dim.data_type) * dim.dim_n);
+                count += (size_t)(getSizeOf((UDA_TYPE)dim.data_type) * dim.dim_n);
                 factor = 1;
                 if (dim.errasymmetry) factor = 2;
                 if (dim.error_type != UDA_TYPE_UNKNOWN) {
-                    count += (unsigned int)(factor * getSizeOf((UDA_TYPE)dim.error_type) * dim.dim_n);
+                    count += (size_t)(factor * getSizeOf((UDA_TYPE)dim.error_type) * dim.dim_n);
                 }
             } else {;
                 switch (dim.method) {
@@ -73,7 +73,7 @@ unsigned int countDataBlockSize(const DATA_BLOCK* data_block, CLIENT_BLOCK* clie
                         break;
                     case 1:
                         for (unsigned int i = 0; i < dim.udoms; i++) {
-                            count += (unsigned int)(*((long*)dim.sams + i) * getSizeOf((UDA_TYPE)dim.data_type));
+                            count += (size_t)(*((long*)dim.sams + i) * getSizeOf((UDA_TYPE)dim.data_type));
                         }
                         break;
                     case 2:
@@ -98,7 +98,7 @@ unsigned int countDataBlockSize(const DATA_BLOCK* data_block, CLIENT_BLOCK* clie
 #if defined(SERVERBUILD) || defined(FATCLIENT)
 
 void udaAccessLog(int init, CLIENT_BLOCK client_block, REQUEST_BLOCK request_block, SERVER_BLOCK server_block,
-                  unsigned int total_datablock_size)
+                  size_t total_datablock_size)
 {
     int err = 0;
 
@@ -11,12 +11,12 @@
 extern "C" {
 #endif
 
-LIBRARY_API unsigned int countDataBlockListSize(const DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block);
-LIBRARY_API unsigned int countDataBlockSize(const DATA_BLOCK* data_block, CLIENT_BLOCK* client_block);
+LIBRARY_API size_t countDataBlockListSize(const DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block);
+LIBRARY_API size_t countDataBlockSize(const DATA_BLOCK* data_block, CLIENT_BLOCK* client_block);
 
 LIBRARY_API void
 udaAccessLog(int init, CLIENT_BLOCK client_block, REQUEST_BLOCK request_block, SERVER_BLOCK server_block,
-             unsigned int total_datablock_size);
+             size_t total_datablock_size);
 
 #ifdef __cplusplus
 }
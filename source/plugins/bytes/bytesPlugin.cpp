@@ -95,7 +95,10 @@ int bytesPlugin(IDAM_PLUGIN_INTERFACE* idam_plugin_interface)
  */
 int do_help(IDAM_PLUGIN_INTERFACE* idam_plugin_interface)
 {
-    const char* help = "\nbytes: data reader to access files as a block of bytes without interpretation\n\n";
+    const char* help = "\nbytes: data reader to access files as a block of bytes without interpretation\n\n"
+                       "read(path=path [, offset=offset] [, length=length] [, checksum=md5|sha256|crc32c|xxh64])\n"
+                       "\tRead length bytes (default to the end of the file) from offset (default 0). With a checksum\n"
+                       "\tthe data label is the algorithm and the data description the checksum in hexadecimal\n\n";
     const char* desc = "bytes: help = description of this plugin";
 
     return setReturnDataString(idam_plugin_interface->data_block, help, desc);
@@ -156,5 +159,18 @@ int do_read(IDAM_PLUGIN_INTERFACE* idam_plugin_interface)
     UDA_LOG(UDA_LOG_DEBUG, "expandEnvironmentvariables! \n");
     expand_environment_variables(data_source->path);
 
-    return readBytes(*data_source, *signal_desc, data_block, idam_plugin_interface->environment);
+    // Optional byte range: offset=, length= (default the whole file)
+    long offset = 0;
+    FIND_LONG_VALUE(idam_plugin_interface->request_data->nameValueList, offset);
+
+    long length = -1;
+    FIND_LONG_VALUE(idam_plugin_interface->request_data->nameValueList, length);
+
+    // Optional checksum of the bytes read: checksum=md5|sha256|crc32c|xxh64. The checksum is returned in the data
+    // description and its algorithm in the data label
+    const char* checksum = nullptr;
+    FIND_STRING_VALUE(idam_plugin_interface->request_data->nameValueList, checksum);
+
+    return readBytes(*data_source, *signal_desc, data_block, idam_plugin_interface->environment, offset, length,
+                     checksum);
 }
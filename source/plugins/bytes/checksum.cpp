@@ -0,0 +1,309 @@
+#include "checksum.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <openssl/evp.h>
+#include <strings.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#  include <nmmintrin.h>
+#  define CRC32C_SSE42
+#endif
+
+namespace {
+
+std::string to_hex(const unsigned char* bytes, size_t size)
+{
+    std::string hex(2 * size, '0');
+    for (size_t i = 0; i < size; ++i) {
+        snprintf(&hex[2 * i], 3, "%02x", bytes[i]);
+    }
+    return hex;
+}
+
+//--------------------------------------------------------------------------------------------
+// Cryptographic digests from OpenSSL
+
+class DigestChecksum : public Checksum
+{
+public:
+    DigestChecksum(const char* name, const EVP_MD* md) : name_{ name }, context_{ EVP_MD_CTX_new() }
+    {
+        EVP_DigestInit_ex(context_, md, nullptr);
+    }
+
+    ~DigestChecksum() override
+    {
+        EVP_MD_CTX_free(context_);
+    }
+
+    const char* name() const override { return name_; }
+
+    void update(const char* data, size_t size) override
+    {
+        EVP_DigestUpdate(context_, data, size);
+    }
+
+    std::string hex() override
+    {
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int size = 0;
+        EVP_DigestFinal_ex(context_, digest, &size);
+        return to_hex(digest, size);
+    }
+
+private:
+    const char* name_;
+    EVP_MD_CTX* context_;
+};
+
+//--------------------------------------------------------------------------------------------
+// CRC-32C (Castagnoli): SSE4.2 crc32 instruction where available, otherwise slice-by-8 tables
+
+class Crc32cChecksum : public Checksum
+{
+public:
+    Crc32cChecksum()
+    {
+#ifdef CRC32C_SSE42
+        hardware_ = __builtin_cpu_supports("sse4.2");
+#endif
+    }
+
+    const char* name() const override { return "crc32c"; }
+
+    void update(const char* data, size_t size) override
+    {
+#ifdef CRC32C_SSE42
+        if (hardware_) {
+            crc_ = update_sse42(crc_, (const unsigned char*)data, size);
+            return;
+        }
+#endif
+        crc_ = update_tables(crc_, (const unsigned char*)data, size);
+    }
+
+    std::string hex() override
+    {
+        uint32_t crc = ~crc_;
+        unsigned char bytes[4] = { (unsigned char)(crc >> 24), (unsigned char)(crc >> 16),
+                                   (unsigned char)(crc >> 8), (unsigned char)crc };
+        return to_hex(bytes, sizeof(bytes));
+    }
+
+private:
+    using Tables = uint32_t[8][256];
+
+    static const Tables& tables()
+    {
+        static Tables tables = {};
+        static bool initialised = [] {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int j = 0; j < 8; ++j) {
+                    crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+                }
+                tables[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int k = 1; k < 8; ++k) {
+                    tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+                }
+            }
+            return true;
+        }();
+        (void)initialised;
+        return tables;
+    }
+
+    static uint32_t update_tables(uint32_t crc, const unsigned char* data, size_t size)
+    {
+        const Tables& t = tables();
+
+        while (size >= 8) {
+            uint32_t lo = crc ^ ((uint32_t)data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16
+                                 | (uint32_t)data[3] << 24);
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+                  ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+            data += 8;
+            size -= 8;
+        }
+        while (size-- > 0) {
+            crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+        }
+        return crc;
+    }
+
+#ifdef CRC32C_SSE42
+    __attribute__((target("sse4.2")))
+    static uint32_t update_sse42(uint32_t crc, const unsigned char* data, size_t size)
+    {
+        uint64_t crc64 = crc;
+        while (size >= 8) {
+            uint64_t word;
+            memcpy(&word, data, 8);
+            crc64 = _mm_crc32_u64(crc64, word);
+            data += 8;
+            size -= 8;
+        }
+        crc = (uint32_t)crc64;
+        while (size-- > 0) {
+            crc = _mm_crc32_u8(crc, *data++);
+        }
+        return crc;
+    }
+
+    bool hardware_ = false;
+#endif
+
+    uint32_t crc_ = 0xFFFFFFFFu;
+};
+
+//--------------------------------------------------------------------------------------------
+// XXH64 (seed 0) streaming implementation
+
+class Xxh64Checksum : public Checksum
+{
+public:
+    const char* name() const override { return "xxh64"; }
+
+    void update(const char* data, size_t size) override
+    {
+        auto p = (const unsigned char*)data;
+        total_ += size;
+
+        if (buffered_ + size < 32) {
+            memcpy(buffer_ + buffered_, p, size);
+            buffered_ += size;
+            return;
+        }
+
+        if (buffered_ > 0) {
+            size_t fill = 32 - buffered_;
+            memcpy(buffer_ + buffered_, p, fill);
+            consume(buffer_);
+            p += fill;
+            size -= fill;
+            buffered_ = 0;
+        }
+
+        while (size >= 32) {
+            consume(p);
+            p += 32;
+            size -= 32;
+        }
+
+        memcpy(buffer_, p, size);
+        buffered_ = size;
+    }
+
+    std::string hex() override
+    {
+        uint64_t h;
+        if (total_ >= 32) {
+            h = rotl(v_[0], 1) + rotl(v_[1], 7) + rotl(v_[2], 12) + rotl(v_[3], 18);
+            for (uint64_t v : v_) {
+                h ^= round(0, v);
+                h = h * Prime1 + Prime4;
+            }
+        } else {
+            h = Prime5;
+        }
+
+        h += total_;
+
+        const unsigned char* p = buffer_;
+        size_t size = buffered_;
+
+        while (size >= 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * Prime1 + Prime4;
+            p += 8;
+            size -= 8;
+        }
+        if (size >= 4) {
+            h ^= (uint64_t)read32(p) * Prime1;
+            h = rotl(h, 23) * Prime2 + Prime3;
+            p += 4;
+            size -= 4;
+        }
+        while (size-- > 0) {
+            h ^= (uint64_t)(*p++) * Prime5;
+            h = rotl(h, 11) * Prime1;
+        }
+
+        h ^= h >> 33;
+        h *= Prime2;
+        h ^= h >> 29;
+        h *= Prime3;
+        h ^= h >> 32;
+
+        unsigned char bytes[8];
+        for (int i = 0; i < 8; ++i) {
+            bytes[i] = (unsigned char)(h >> (56 - 8 * i));
+        }
+        return to_hex(bytes, sizeof(bytes));
+    }
+
+private:
+    static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t Prime4 = 0x85EBCA77C2B2CA63ULL;
+    static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    static uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * Prime2;
+        acc = rotl(acc, 31);
+        return acc * Prime1;
+    }
+
+    static uint64_t read64(const unsigned char* p)
+    {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | p[i];
+        }
+        return value;
+    }
+
+    static uint32_t read32(const unsigned char* p)
+    {
+        return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+    }
+
+    void consume(const unsigned char* p)
+    {
+        for (int i = 0; i < 4; ++i) {
+            v_[i] = round(v_[i], read64(p + 8 * i));
+        }
+    }
+
+    uint64_t v_[4] = { Prime1 + Prime2, Prime2, 0, 0 - Prime1 };
+    unsigned char buffer_[32] = {};
+    size_t buffered_ = 0;
+    uint64_t total_ = 0;
+};
+
+} // anon namespace
+
+/**
+ * Create the named checksum (case insensitive), or return nullptr if the algorithm is not known.
+ */
+std::unique_ptr<Checksum> Checksum::create(const std::string& name)
+{
+    if (strcasecmp(name.c_str(), "md5") == 0) {
+        return std::make_unique<DigestChecksum>("md5", EVP_md5());
+    } else if (strcasecmp(name.c_str(), "sha256") == 0) {
+        return std::make_unique<DigestChecksum>("sha256", EVP_sha256());
+    } else if (strcasecmp(name.c_str(), "crc32c") == 0) {
+        return std::make_unique<Crc32cChecksum>();
+    } else if (strcasecmp(name.c_str(), "xxh64") == 0) {
+        return std::make_unique<Xxh64Checksum>();
+    }
+    return nullptr;
+}
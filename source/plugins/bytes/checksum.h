@@ -0,0 +1,26 @@
+#ifndef UDA_PLUGIN_BYTES_CHECKSUM_H
+#define UDA_PLUGIN_BYTES_CHECKSUM_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+//--------------------------------------------------------------------------------------------
+// Checksums of a block of bytes computed incrementally as the block is read
+//
+// Algorithms: md5, sha256, crc32c and xxh64. The checksum is returned as a lower case hexadecimal string, the
+// integer checksums (crc32c, xxh64) in their canonical big-endian form.
+
+class Checksum
+{
+public:
+    virtual ~Checksum() = default;
+
+    static std::unique_ptr<Checksum> create(const std::string& name);
+
+    virtual const char* name() const = 0;
+    virtual void update(const char* data, size_t size) = 0;
+    virtual std::string hex() = 0;
+};
+
+#endif // UDA_PLUGIN_BYTES_CHECKSUM_H
@@ -3,6 +3,9 @@
 *
 * Input Arguments:    DATA_SOURCE data_source
 *            SIGNAL_DESC signal_desc
+*            long offset    First Byte to read
+*            long length    Number of Bytes to read (-1 => to the end of the File)
+*            const char* checksum    Checksum algorithm (md5, sha256, crc32c, xxh64; nullptr or "" => none)
 *
 * Returns:        readBytes    0 if read was successful
 *                    otherwise an Error Code is returned
@@ -15,7 +18,10 @@
 *        by the passed DATA_BLOCK structure. Local memory allocations
 *        are freed on exit. However, the blocks reserved for data are
 *        not and MUST BE FREED by the calling routine.
-**
+*
+*        The block is allocated once from the File size and filled using pread.
+*        The checksum of each chunk read is computed while the next is read.
+*
 * ToDo:
 *
 *-----------------------------------------------------------------------------*/
@@ -23,20 +29,25 @@
 
 #include <cerrno>
 #include <cstdlib>
+#include <fcntl.h>
+#include <future>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <logging/logging.h>
 #include <clientserver/errorLog.h>
 #include <clientserver/stringUtils.h>
-#include <plugins/bytes/md5Sum.h>
+#include <plugins/bytes/checksum.h>
 #include <clientserver/udaTypes.h>
 #include <clientserver/initStructs.h>
 
-int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_block, const ENVIRONMENT* environment)
+int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_block, const ENVIRONMENT* environment,
+              long offset, long length, const char* checksum)
 {
     int err = 0;
 
-    char md5file[2 * MD5_SIZE + 1] = "";
-    char md5check[2 * MD5_SIZE + 1] = "";
+    // Number of bytes read by each pread, and hashed while the next chunk is read
+    constexpr int64_t ChunkSize = 8 * 1024 * 1024;
 
     //----------------------------------------------------------------------
     // Block Access to External Users
@@ -59,34 +70,37 @@ int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data
     }
 
     //----------------------------------------------------------------------
-    // Data Source Details
+    // Checksum algorithm
 
-    err = 0;
+    std::unique_ptr<Checksum> hash = nullptr;
 
-    UDA_LOG(UDA_LOG_DEBUG, "File Name  : %s \n", data_source.path);
+    if (checksum != nullptr && checksum[0] != '\0' && (hash = Checksum::create(checksum)) == nullptr) {
+        err = BYTEFILECHECKSUMERROR;
+        addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "Unknown Checksum Algorithm: use md5, sha256, crc32c or xxh64");
+        return err;
+    }
 
     //----------------------------------------------------------------------
-    // File Attributes
+    // Data Source Details
 
-    errno = 0;
+    err = 0;
+
+    UDA_LOG(UDA_LOG_DEBUG, "File Name  : %s \n", data_source.path);
 
     //----------------------------------------------------------------------
-    // Open the File as a Binary Stream
+    // Open the File and check its Attributes
 
     errno = 0;
-    FILE* fh = fopen(data_source.path, "rb");
+    int fd = open(data_source.path, O_RDONLY);
 
     int serrno = errno;
 
-    if (fh == nullptr || ferror(fh) || serrno != 0) {
+    if (fd < 0) {
         err = BYTEFILEOPENERROR;
         if (serrno != 0) {
             addIdamError(UDA_SYSTEM_ERROR_TYPE, "readBytes", serrno, "");
         }
         addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "Unable to Open the File for Read Access");
-        if (fh != nullptr) {
-            fclose(fh);
-        }
         return err;
     }
 
@@ -95,46 +109,102 @@ int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data
 
     do {
 
-        // Read File (Consider using memory mapped I/O & new type to avoid heap free at end if this is too slow!)
+        struct stat file_stat = {};
+
+        if (fstat(fd, &file_stat) != 0) {
+            err = BYTEFILEATTRIBUTEERROR;
+            addIdamError(UDA_SYSTEM_ERROR_TYPE, "readBytes", errno, "");
+            addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "Unable to read the File Attributes");
+            break;
+        }
+
+        if (!S_ISREG(file_stat.st_mode)) {
+            err = BYTEFILEISNOTREGULAR;
+            addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "The File is not a Regular File");
+            break;
+        }
 
-        int nchar = 0;
-        int offset = 0;
-        int bufsize = 100 * 1024;
-        data_block->data_n = bufsize;    // 1 less than no. bytes read: Last Byte is an EOF
+        // Byte range requested: the whole file by default
 
-        char* bp = nullptr;
-        while (!feof(fh)) {
-            if ((bp = (char*)realloc(bp, (size_t)data_block->data_n)) == nullptr) {
-                err = BYTEFILEHEAPERROR;
-                addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "Unable to Allocate Heap Memory for the File");
-                break;
+        if (offset < 0 || offset > file_stat.st_size) {
+            err = BYTEFILERANGEERROR;
+            addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "The Byte Offset is outside the File");
+            break;
+        }
+
+        int64_t count = file_stat.st_size - offset;
+        if (length >= 0 && length < count) {
+            count = length;
+        }
+
+        // Read the range into a single block sized from the file attributes
+
+        char* bp = (char*)malloc(count > 0 ? (size_t)count : 1);
+
+        if (bp == nullptr) {
+            err = BYTEFILEHEAPERROR;
+            addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "Unable to Allocate Heap Memory for the File");
+            break;
+        }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd, offset, count, POSIX_FADV_SEQUENTIAL);
+#endif
+
+        int64_t nchar = 0;
+        errno = 0;
+
+        std::future<void> hashing;
+
+        while (nchar < count) {
+            int64_t size = count - nchar < ChunkSize ? count - nchar : ChunkSize;
+            ssize_t nread = pread(fd, bp + nchar, (size_t)size, (off_t)(offset + nchar));
+            if (nread < 0 && errno == EINTR) {
+                continue;
+            }
+            if (nread <= 0) {
+                break;                  // Error or the File has been truncated
             }
-            int nread = (int)fread(bp + offset, sizeof(char), (size_t)bufsize, fh);
-            nchar = nchar + nread;
-            offset = nchar;
-            data_block->data_n = nchar + bufsize + 1;
+            if (hash != nullptr) {
+                if (hashing.valid()) {
+                    hashing.get();
+                }
+                const char* chunk = bp + nchar;
+                if (nchar + nread < count) {
+                    hashing = std::async(std::launch::async, [&hash, chunk, nread] { hash->update(chunk, nread); });
+                } else {
+                    hash->update(chunk, nread);
+                }
+            }
+            nchar += nread;
         }
 
-        if (err != 0) {
+        if (hashing.valid()) {
+            hashing.get();
+        }
+
+        if (nchar < count && errno != 0) {
+            err = BYTEFILEREADERROR;
+            addIdamError(UDA_SYSTEM_ERROR_TYPE, "readBytes", errno, "");
+            addIdamError(UDA_CODE_ERROR_TYPE, "readBytes", err, "Unable to Read the File");
+            free(bp);
             break;
         }
 
-        //nchar--;                     // Remove EOF Character from end of Byte Block
         data_block->data_n = nchar;
         data_block->data = bp;
 
         //----------------------------------------------------------------------
-        // MD5 Checksum
-
-        md5Sum(bp, data_block->data_n, md5check);
+        // Pass back the Checksum and its Algorithm to the Client
 
-        strcpy(data_block->data_desc, md5check);    // Pass back the Checksum to the Client
-
-        UDA_LOG(UDA_LOG_DEBUG, "File Size          : %d \n", nchar);
-        UDA_LOG(UDA_LOG_DEBUG, "File Checksum      : %s \n", md5file);
-        UDA_LOG(UDA_LOG_DEBUG, "Read Checksum      : %s \n", md5check);
+        if (hash != nullptr) {
+            StringCopy(data_block->data_desc, hash->hex().c_str(), STRING_LENGTH);
+            StringCopy(data_block->data_label, hash->name(), STRING_LENGTH);
+        }
 
-        // MD5 Difference?
+        UDA_LOG(UDA_LOG_DEBUG, "File Size          : %ld \n", (long)file_stat.st_size);
+        UDA_LOG(UDA_LOG_DEBUG, "Bytes Read         : %ld from %ld \n", (long)nchar, offset);
+        UDA_LOG(UDA_LOG_DEBUG, "Read Checksum      : %s %s \n", data_block->data_label, data_block->data_desc);
 
         //----------------------------------------------------------------------
         // Fetch Dimensional Data
@@ -146,7 +216,7 @@ int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data
         data_block->dims[0].data_type = UDA_TYPE_UNSIGNED_INT;
         data_block->dims[0].dim_n = data_block->data_n;
         data_block->dims[0].compressed = 1;
-        data_block->dims[0].dim0 = 0.0;
+        data_block->dims[0].dim0 = (double)offset;
         data_block->dims[0].diff = 1.0;
         data_block->dims[0].method = 0;
 
@@ -162,7 +232,7 @@ int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data
 //        freeDataBlock(data_block);
 //    }
 
-    fclose(fh); // Close the File
+    close(fd); // Close the File
 
     return err;
 }
@@ -8,7 +8,8 @@
 extern "C" {
 #endif
 
-LIBRARY_API int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK *data_block, const ENVIRONMENT* environment);
+LIBRARY_API int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK *data_block, const ENVIRONMENT* environment,
+                          long offset, long length, const char* checksum);
 
 #ifndef NOBINARYPLUGIN
 
@@ -19,6 +20,9 @@ LIBRARY_API int readBytes(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA
 #define BYTEFILEHEAPERROR         100005
 #define BYTEFILEMD5ERROR        100006
 #define BYTEFILEMD5DIFF            100007
+#define BYTEFILERANGEERROR        100008
+#define BYTEFILEREADERROR         100009
+#define BYTEFILECHECKSUMERROR     100010
 
 #endif
 
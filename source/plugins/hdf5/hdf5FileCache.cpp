@@ -0,0 +1,171 @@
+#include "hdf5FileCache.h"
+
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+
+#include <logging/logging.h>
+
+namespace {
+
+constexpr size_t DefaultMaxFiles = 16;
+constexpr size_t DefaultMaxDatasets = 128;
+constexpr size_t DefaultChunkCacheMBytes = 4;
+constexpr size_t ChunkCacheSlots = 12421;       // Prime, ~100 times the chunks held for typical chunk sizes
+constexpr double ChunkCachePreemption = 0.75;
+
+struct Config {
+    size_t max_files;
+    size_t max_datasets;
+    size_t chunk_cache;
+};
+
+struct CachedFile {
+    std::string path;
+    dev_t device;
+    ino_t inode;
+    off_t size;
+    time_t mtime;
+    hid_t file_id;
+};
+
+struct CachedDataset {
+    hid_t file_id;
+    std::string name;
+    hid_t dataset_id;
+};
+
+using DatasetKey = std::pair<hid_t, std::string>;
+
+std::list<CachedFile> files;            // Most recently used first
+std::list<CachedDataset> datasets;      // Most recently used first
+std::map<DatasetKey, std::list<CachedDataset>::iterator> dataset_index;
+
+size_t env_size(const char* name, size_t default_value)
+{
+    const char* env = getenv(name);
+    return env != nullptr ? (size_t)strtoul(env, nullptr, 10) : default_value;
+}
+
+const Config& config()
+{
+    static const Config config = {
+            env_size("UDA_PLUGIN_HDF5_MAX_FILES", DefaultMaxFiles),
+            env_size("UDA_PLUGIN_HDF5_MAX_DATASETS", DefaultMaxDatasets),
+            env_size("UDA_PLUGIN_HDF5_CHUNK_CACHE", DefaultChunkCacheMBytes) * 1024 * 1024,
+    };
+    return config;
+}
+
+void close_dataset(std::list<CachedDataset>::iterator dataset)
+{
+    H5Dclose(dataset->dataset_id);
+    dataset_index.erase({ dataset->file_id, dataset->name });
+    datasets.erase(dataset);
+}
+
+void close_file(std::list<CachedFile>::iterator file)
+{
+    UDA_LOG(UDA_LOG_DEBUG, "Closing HDF5 file %s\n", file->path.c_str());
+
+    for (auto dataset = datasets.begin(); dataset != datasets.end();) {
+        auto next = std::next(dataset);
+        if (dataset->file_id == file->file_id) {
+            close_dataset(dataset);
+        }
+        dataset = next;
+    }
+
+    H5Fclose(file->file_id);
+    files.erase(file);
+}
+
+bool is_unchanged(const CachedFile& file, const struct stat& file_stat)
+{
+    return file.device == file_stat.st_dev && file.inode == file_stat.st_ino
+           && file.size == file_stat.st_size && file.mtime == file_stat.st_mtime;
+}
+
+} // anon namespace
+
+/**
+ * Return an open read only handle to the HDF5 file, reusing the handle from a previous request if the file has not
+ * been replaced or modified since.
+ */
+hid_t openHDF5File(const char* path)
+{
+    struct stat file_stat = {};
+    bool found = stat(path, &file_stat) == 0;
+
+    for (auto file = files.begin(); file != files.end(); ++file) {
+        if (file->path != path) {
+            continue;
+        }
+        if (found && is_unchanged(*file, file_stat)) {
+            files.splice(files.begin(), files, file);
+            return file->file_id;
+        }
+        UDA_LOG(UDA_LOG_DEBUG, "HDF5 file %s has changed since it was opened\n", path);
+        close_file(file);
+        break;
+    }
+
+    hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_cache(fapl_id, 0, ChunkCacheSlots, config().chunk_cache, ChunkCachePreemption);
+
+    hid_t file_id = H5Fopen(path, H5F_ACC_RDONLY, fapl_id);
+    H5Pclose(fapl_id);
+
+    if (file_id < 0) {
+        return file_id;
+    }
+
+    files.push_front({ path, file_stat.st_dev, file_stat.st_ino, file_stat.st_size, file_stat.st_mtime, file_id });
+
+    return file_id;
+}
+
+/**
+ * Return an open handle to the named dataset of a file opened with openHDF5File.
+ */
+hid_t openHDF5Dataset(hid_t file_id, const char* name)
+{
+    auto found = dataset_index.find({ file_id, name });
+    if (found != dataset_index.end()) {
+        datasets.splice(datasets.begin(), datasets, found->second);
+        return found->second->dataset_id;
+    }
+
+    hid_t dataset_id = H5Dopen2(file_id, name, H5P_DEFAULT);
+    if (dataset_id < 0) {
+        return dataset_id;
+    }
+
+    datasets.push_front({ file_id, name, dataset_id });
+    dataset_index[{ file_id, name }] = datasets.begin();
+
+    return dataset_id;
+}
+
+/**
+ * Close the least recently used files and datasets in excess of the configured limits. Called once a request has
+ * finished with its handles.
+ */
+void trimHDF5FileCache()
+{
+    while (files.size() > config().max_files) {
+        close_file(std::prev(files.end()));
+    }
+    while (datasets.size() > config().max_datasets) {
+        close_dataset(std::prev(datasets.end()));
+    }
+}
+
+void closeHDF5FileCache()
+{
+    while (!files.empty()) {
+        close_file(files.begin());
+    }
+}
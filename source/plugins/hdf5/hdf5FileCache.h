@@ -0,0 +1,21 @@
+#ifndef UDA_PLUGIN_HDF5FILECACHE_H
+#define UDA_PLUGIN_HDF5FILECACHE_H
+
+#include <hdf5.h>
+
+//--------------------------------------------------------------------------------------------
+// Open HDF5 file and dataset handles retained between requests by a long running server.
+//
+// Files are validated against the device, inode, size and modification time of the path before reuse and the least
+// recently used are closed once more than UDA_PLUGIN_HDF5_MAX_FILES are open (default 16, 0 disables the cache).
+// At most UDA_PLUGIN_HDF5_MAX_DATASETS dataset handles are retained (default 128). The raw data chunk cache of each
+// file is UDA_PLUGIN_HDF5_CHUNK_CACHE MBytes (default 4).
+//
+// Handles returned are owned by the cache and must not be closed by the caller.
+
+hid_t openHDF5File(const char* path);
+hid_t openHDF5Dataset(hid_t file_id, const char* name);
+void trimHDF5FileCache();
+void closeHDF5FileCache();
+
+#endif // UDA_PLUGIN_HDF5FILECACHE_H
@@ -24,6 +24,7 @@
 #include <plugins/managePluginFiles.h>
 
 #include "readHDF58.h"
+#include "hdf5FileCache.h"
 
 UDA_PLUGIN_FILE_LIST pluginFileList;    // Private list of open data file handles
 
@@ -65,6 +66,7 @@ extern int udaHDF5(IDAM_PLUGIN_INTERFACE* idam_plugin_interface)
         // Free Heap & reset counters
 
         closeIdamPluginFiles(&pluginFileList);    // Close all open files
+        closeHDF5FileCache();
 
         init = 0;
 
@@ -181,8 +183,8 @@ int do_read(IDAM_PLUGIN_INTERFACE* idam_plugin_interface)
     strcpy(data_source->path, file_path);
     strcpy(signal_desc->signal_name, cdf_path);
 
-    // Legacy data reader!
-    int err = readHDF5(*data_source, *signal_desc, data_block);
+    // Legacy data reader! Index range subsets are read directly from the file
+    int err = readHDF5(*data_source, *signal_desc, &request->datasubset, data_block);
 
     return err;
 }
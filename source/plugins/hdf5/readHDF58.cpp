@@ -32,6 +32,7 @@
 
 int readHDF5(DATA_SOURCE data_source,
              SIGNAL_DESC signal_desc,
+             SUBSET *subset,
              DATA_BLOCK *data_block) {
     int err = 999;
     addIdamError(UDA_CODE_ERROR_TYPE, "readHDF5", err, "Cannot Read HDF5 Files - PLUGIN NOT ENABLED");
@@ -52,6 +53,8 @@ void H5Fclose(int fh) {
 #include <cerrno>
 #include <clientserver/stringUtils.h>
 
+#include "hdf5FileCache.h"
+
 // #define H5TEST
 
 #define HDF5_ERROR_OPENING_FILE             200
@@ -264,13 +267,72 @@ int readHDF5Att(hid_t file_id, char* object, hid_t att_id, char* attname, DATA_B
     return 0;
 }
 
-int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_block)
+//--------------------------------------------------------------------------------------------
+// Select the client's subset on the Dataspace of a Dataset so that only the subset is read from the File
+//
+// Subset operation j is applied to data_block->dims[dimid[j]], which is HDF5 axis rank-1-dimid[j]. Only index
+// ranges [start:end:stride] with a positive stride (and * for a whole dimension) are translated into a hyperslab:
+// anything else returns 0 and the whole Dataset is read and subset by the server as before.
+
+static int selectHDF5Subset(hid_t space_id, int rank, const hsize_t* shape, const SUBSET* subset,
+                            hsize_t* start, hsize_t* stride, hsize_t* count)
+{
+    if (subset == NULL || subset->nbound <= 0 || rank <= 0 || subset->member[0] != '\0') {
+        return 0;
+    }
+
+    for (int i = 0; i < rank; i++) {
+        start[i] = 0;
+        stride[i] = 1;
+        count[i] = shape[i];
+    }
+
+    for (int j = 0; j < subset->nbound; j++) {
+        int dim_id = subset->dimid[j];
+        if (dim_id < 0 || dim_id >= rank) {
+            return 0;
+        }
+
+        if (STR_EQUALS(subset->operation[j], "*")) {
+            continue;
+        }
+        if (!STR_EQUALS(subset->operation[j], ":")) {
+            return 0;        // Value based operations need the dimension data
+        }
+
+        int axis = rank - dim_id - 1;
+        long dim_n = (long)shape[axis];
+
+        long first = subset->lbindex[j].init ? subset->lbindex[j].value : 0;
+        long last = subset->ubindex[j].init ? subset->ubindex[j].value : dim_n;
+        long step = subset->stride[j].init ? subset->stride[j].value : 1;
+
+        if (first < 0) first += dim_n;
+        if (last < 0) last += dim_n;
+
+        if (step <= 0 || first < 0 || first >= last || last > dim_n) {
+            return 0;        // Reversals and out of range errors are left to the server
+        }
+
+        start[axis] = (hsize_t)first;
+        stride[axis] = (hsize_t)step;
+        count[axis] = (hsize_t)((last - first + step - 1) / step);
+    }
+
+    return H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, stride, count, NULL) >= 0;
+}
+
+int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, SUBSET* subset, DATA_BLOCK* data_block)
 {
 
     hid_t file_id = -1, dataset_id = -1, space_id = -1, datatype_id = -1, att_id = -1, grp_id = -1;
+    hid_t mem_space_id = -1;
+    bool is_cached_dataset = false;
     hid_t classtype;
     herr_t status;
     hsize_t shape[64];
+    hsize_t start[64], stride[64], count[64];
+    int is_subset = 0;
 #ifdef H5TEST
     hid_t       nativetype;
     int         typesize = 0;
@@ -302,7 +364,7 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
         //----------------------------------------------------------------------
         // Is the HDF5 File Already open for Reading? If Not then Open
 
-        file_id = H5Fopen(data_source.path, H5F_ACC_RDONLY, H5P_DEFAULT);
+        file_id = openHDF5File(data_source.path);
         int serrno = errno;
 
         if ((int)file_id < 0 || serrno != 0) {
@@ -317,7 +379,7 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
         //----------------------------------------------------------------------
         // Open the Dataset
 
-        if ((dataset_id = H5Dopen2(file_id, signal_desc.signal_name, H5P_DEFAULT)) < 0) {
+        if ((dataset_id = openHDF5Dataset(file_id, signal_desc.signal_name)) < 0) {
 
             // Check it's not a group level attribute
 
@@ -364,6 +426,8 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
             break;
         }
 
+        is_cached_dataset = true;
+
         //----------------------------------------------------------------------
         // Identify the Dataset Type
 
@@ -403,7 +467,6 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
 #endif
             classtype = H5Tget_class(datatype_id);            // Class
             is_signed = H5Tget_sign(datatype_id) != H5T_SGN_NONE;    // Whether or Not the Type is Signed
-            H5Sclose(space_id);
         } else {                                // Assume an Attribute Object
             if ((space_id = H5Aget_space(dataset_id)) < 0) {
                 err = HDF5_ERROR_OPENING_DATASPACE;
@@ -422,6 +485,7 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
             classtype = H5Tget_class(datatype_id);            // Class
             is_signed = H5Tget_sign(datatype_id) != H5T_SGN_NONE;    // Whether or Not the Type is Signed
             H5Sclose(space_id);
+            space_id = -1;
         }
 
 #ifdef H5TEST
@@ -471,6 +535,16 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
             break;
         }
 
+        //----------------------------------------------------------------------
+        // Read only the requested subset of a Dataset
+
+        if (dataset_type == H5O_TYPE_DATASET) {
+            is_subset = selectHDF5Subset(space_id, (int)data_block->rank, shape, subset, start, stride, count);
+            if (is_subset) {
+                mem_space_id = H5Screate_simple((int)data_block->rank, count, NULL);
+            }
+        }
+
         //----------------------------------------------------------------------
         // Allocate & Initialise Dimensional Structures
 
@@ -493,11 +567,12 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
 
         {
             for (unsigned int i = 0; i < data_block->rank; i++) {
+                unsigned int axis = data_block->rank - i - 1;
                 data_block->dims[i].compressed = 1;
                 data_block->dims[i].method = 0;
-                data_block->dims[i].dim_n = (int)shape[data_block->rank - i - 1];
-                data_block->dims[i].dim0 = 0;
-                data_block->dims[i].diff = 1;
+                data_block->dims[i].dim_n = (int)(is_subset ? count[axis] : shape[axis]);
+                data_block->dims[i].dim0 = is_subset ? (double)start[axis] : 0;
+                data_block->dims[i].diff = is_subset ? (double)stride[axis] : 1;
                 data_block->dims[i].data_type = UDA_TYPE_INT;        // No Standard to enable identification of the dims
                 data_block->dims[i].dim = NULL;
                 strcpy(data_block->dims[i].dim_label, "array index");
@@ -642,83 +717,72 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
         //--------------------------------------------------------------------------------------------
         // Allocate Heap for the Data and Read the Data
 
-        hsize_t ndata = 0;
+        hid_t native_type = -1;
+        size_t type_size = 0;
 
         switch (data_block->data_type) {
             case UDA_TYPE_FLOAT:
-                ndata = size / sizeof(float);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_FLOAT;
+                type_size = sizeof(float);
                 break;
             case UDA_TYPE_DOUBLE:
-                ndata = size / sizeof(double);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_DOUBLE;
+                type_size = sizeof(double);
                 break;
             case UDA_TYPE_UNSIGNED_CHAR:
-                ndata = size / sizeof(unsigned char);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_UCHAR;
+                type_size = sizeof(unsigned char);
                 break;
             case UDA_TYPE_CHAR:
-                ndata = size / sizeof(char);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_CHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_CHAR;
+                type_size = sizeof(char);
                 break;
             case UDA_TYPE_UNSIGNED_SHORT:
-                ndata = size / sizeof(unsigned short);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_USHORT, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_USHORT;
+                type_size = sizeof(unsigned short);
                 break;
             case UDA_TYPE_SHORT:
-                ndata = size / sizeof(short);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_SHORT, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_SHORT;
+                type_size = sizeof(short);
                 break;
             case UDA_TYPE_UNSIGNED_INT:
-                ndata = size / sizeof(unsigned int);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_UINT;
+                type_size = sizeof(unsigned int);
                 break;
             case UDA_TYPE_INT:
-                ndata = size / sizeof(int);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_INT;
+                type_size = sizeof(int);
                 break;
             case UDA_TYPE_UNSIGNED_LONG64:
-                ndata = size / sizeof(unsigned long long int);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_ULLONG;
+                type_size = sizeof(unsigned long long int);
                 break;
             case UDA_TYPE_LONG64:
-                ndata = size / sizeof(long long int);
-                data = (char*)malloc(size);
-                if (data != NULL) {
-                    status = H5Dread(dataset_id, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, (void*)data);
-                }
+                native_type = H5T_NATIVE_LLONG;
+                type_size = sizeof(long long int);
                 break;
             default:
                 break;
         }
 
+        hsize_t ndata = type_size > 0 ? size / type_size : 0;
+
+        if (is_subset) {
+            ndata = 1;
+            for (unsigned int i = 0; i < data_block->rank; i++) {
+                ndata = ndata * count[i];
+            }
+        }
+
+        if (type_size > 0) {
+            data = (char*)malloc(ndata * type_size);
+        }
+
+        if (data != NULL) {
+            status = H5Dread(dataset_id, native_type, is_subset ? mem_space_id : H5S_ALL,
+                             is_subset ? space_id : H5S_ALL, H5P_DEFAULT, (void*)data);
+        }
+
         if (data == NULL) {
             err = HDF5_ERROR_ALLOCATING_DATA_HEAP;
             addIdamError(UDA_CODE_ERROR_TYPE, "readHDF5", err, "Problem Allocating Data Heap Memory");
@@ -734,6 +798,17 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
         data_block->data_n = (unsigned int)ndata;
         data_block->data = data;
 
+        // The selected operations are now no-ops: leave any reform, function or order for the server to apply
+
+        if (is_subset) {
+            for (int j = 0; j < subset->nbound; j++) {
+                strcpy(subset->operation[j], "*");
+            }
+            if (!subset->reform && subset->function[0] == '\0' && subset->order < 0) {
+                subset->nbound = 0;
+            }
+        }
+
         //----------------------------------------------------------------------
         // XML containing all simple Attributes within the Scope of the dataset
 
@@ -756,16 +831,17 @@ int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_
     // Housekeeping
 
     if (datatype_id >= 0) H5Tclose(datatype_id);
-    if (dataset_id >= 0) H5Dclose(dataset_id);
+    if (dataset_id >= 0 && !is_cached_dataset) H5Dclose(dataset_id);
     if (space_id >= 0) H5Sclose(space_id);
+    if (mem_space_id >= 0) H5Sclose(mem_space_id);
     if (grp_id >= 0) H5Gclose(grp_id);
     if (att_id >= 0) H5Aclose(att_id);
 
     H5garbage_collect();
 
-    if (file_id >= 0) {
-        H5Fclose(file_id);
-    }
+    // File and Dataset handles are retained for following requests
+
+    trimHDF5FileCache();
 
     return err;
 }
@@ -8,7 +8,7 @@
 extern "C" {
 #endif
 
-LIBRARY_API int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, DATA_BLOCK* data_block);
+LIBRARY_API int readHDF5(DATA_SOURCE data_source, SIGNAL_DESC signal_desc, SUBSET* subset, DATA_BLOCK* data_block);
 
 #ifdef NOHDF5PLUGIN
 
@@ -466,6 +466,26 @@ bool findIntValue(const NAMEVALUELIST* namevaluelist, int* value, const char* na
     return found;
 }
 
+/**
+ * Look for an argument with the given name in the provided NAMEVALUELIST and return it's associate value as a long.
+ *
+ * If the argument is found the value associated with the argument is provided via the value parameter and the function
+ * returns 1. Otherwise value is not set and the function returns 0.
+ * @param namevaluelist
+ * @param value
+ * @param name
+ * @return
+ */
+bool findLongValue(const NAMEVALUELIST* namevaluelist, long* value, const char* name)
+{
+    const char* str;
+    bool found = findStringValue(namevaluelist, &str, name);
+    if (found) {
+        *value = atol(str);
+    }
+    return found;
+}
+
 /**
  * Look for an argument with the given name in the provided NAMEVALUELIST and return it's associate value as a short.
  *
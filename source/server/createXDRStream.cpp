@@ -2,6 +2,7 @@
 
 #include <server/udaServer.h>
 
+#include "getServerEnvironment.h"
 #include "writer.h"
 
 #if !defined(FATCLIENT) && defined(SSLAUTHENTICATION)
@@ -16,40 +17,42 @@ std::pair<XDR*, XDR*> serverCreateXDRStream(IoData* io_data)
     server_output.x_ops = nullptr;
     server_input.x_ops = nullptr;
 
+    u_int buffer_size = (u_int)getServerEnvironment()->xdr_buffer_size;
+
 #if !defined(FATCLIENT) && defined(SSLAUTHENTICATION)
     if (getUdaServerSSLDisabled()) {
 #if defined (__APPLE__) || defined(__TIRPC__)
-       xdrrec_create( &server_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+       xdrrec_create( &server_output, buffer_size, buffer_size, io_data,
                       reinterpret_cast<int (*)(void *, void *, int)>(server_read),
                       reinterpret_cast<int (*)(void *, void *, int)>(server_write));
 
-       xdrrec_create( &server_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+       xdrrec_create( &server_input, buffer_size, buffer_size, io_data,
                       reinterpret_cast<int (*)(void *, void *, int)>(server_read),
                       reinterpret_cast<int (*)(void *, void *, int)>(server_write));
 #else
-       xdrrec_create( &server_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+       xdrrec_create( &server_output, buffer_size, buffer_size, (char*)io_data,
                       reinterpret_cast<int (*)(char *, char *, int)>(server_read),
                       reinterpret_cast<int (*)(char *, char *, int)>(server_write));
 
-       xdrrec_create( &server_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+       xdrrec_create( &server_input, buffer_size, buffer_size, (char*)io_data,
                       reinterpret_cast<int (*)(char *, char *, int)>(server_read),
                       reinterpret_cast<int (*)(char *, char *, int)>(server_write));
 #endif     
     } else { 
 #if defined (__APPLE__) || defined(__TIRPC__)
-       xdrrec_create( &server_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+       xdrrec_create( &server_output, buffer_size, buffer_size, io_data,
                       reinterpret_cast<int (*)(void *, void *, int)>(readUdaServerSSL),
                       reinterpret_cast<int (*)(void *, void *, int)>(writeUdaServerSSL));
 
-       xdrrec_create( &server_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+       xdrrec_create( &server_input, buffer_size, buffer_size, io_data,
                       reinterpret_cast<int (*)(void *, void *, int)>(readUdaServerSSL),
                       reinterpret_cast<int (*)(void *, void *, int)>(writeUdaServerSSL));
 #else
-       xdrrec_create( &server_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+       xdrrec_create( &server_output, buffer_size, buffer_size, (char*)io_data,
                       reinterpret_cast<int (*)(char *, char *, int)>(readUdaServerSSL),
                       reinterpret_cast<int (*)(char *, char *, int)>(writeUdaServerSSL));
 
-       xdrrec_create( &server_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+       xdrrec_create( &server_input, buffer_size, buffer_size, (char*)io_data,
                       reinterpret_cast<int (*)(char *, char *, int)>(readUdaServerSSL),
                       reinterpret_cast<int (*)(char *, char *, int)>(writeUdaServerSSL));
 #endif
@@ -57,19 +60,19 @@ std::pair<XDR*, XDR*> serverCreateXDRStream(IoData* io_data)
 #else // SSLAUTHENTICATION
 
 #if defined (__APPLE__) || defined(__TIRPC__)
-    xdrrec_create(&server_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+    xdrrec_create(&server_output, buffer_size, buffer_size, io_data,
                   reinterpret_cast<int (*)(void*, void*, int)>(server_read),
                   reinterpret_cast<int (*)(void*, void*, int)>(server_write));
 
-    xdrrec_create(&server_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, io_data,
+    xdrrec_create(&server_input, buffer_size, buffer_size, io_data,
                   reinterpret_cast<int (*)(void*, void*, int)>(server_read),
                   reinterpret_cast<int (*)(void*, void*, int)>(server_write));
 #else
-    xdrrec_create(&server_output, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+    xdrrec_create(&server_output, buffer_size, buffer_size, (char*)io_data,
                   reinterpret_cast<int (*)(char *, char *, int)>(server_read),
                   reinterpret_cast<int (*)(char *, char *, int)>(server_write));
 
-    xdrrec_create(&server_input, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)io_data,
+    xdrrec_create(&server_input, buffer_size, buffer_size, (char*)io_data,
                   reinterpret_cast<int (*)(char *, char *, int)>(server_read),
                   reinterpret_cast<int (*)(char *, char *, int)>(server_write));
 #endif
@@ -114,7 +114,7 @@ fatServer(CLIENT_BLOCK client_block, SERVER_BLOCK* server_block, REQUEST_BLOCK*
     io_data.server_tot_block_time = &server_tot_block_time;
     io_data.server_timeout = &server_timeout;
 
-    static unsigned int total_datablock_size = 0;
+    static size_t total_datablock_size = 0;
 
     //-------------------------------------------------------------------------
     // Initialise the Error Stack & the Server Status Structure
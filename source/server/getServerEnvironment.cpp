@@ -3,6 +3,7 @@
 #include <cstdlib>
 
 #include <logging/logging.h>
+#include <clientserver/udaDefines.h>
 
 // 2019-07-04 Herve Ancher (CEA): Add prefix "g_" to avoid conflict with internal MinGW varaible
 static ENVIRONMENT g_environ;
@@ -18,6 +19,7 @@ void printServerEnvironment(const ENVIRONMENT* environment)
     UDA_LOG(UDA_LOG_INFO, "UDA This Host   : %s\n", environment->server_this);
     UDA_LOG(UDA_LOG_INFO, "Private File Path Target    : %s\n", environment->private_path_target);
     UDA_LOG(UDA_LOG_INFO, "Private File Path Substitute: %s\n", environment->private_path_substitute);
+    UDA_LOG(UDA_LOG_INFO, "XDR Buffer Size : %d\n", environment->xdr_buffer_size);
 }
 
 ENVIRONMENT* getServerEnvironment()
@@ -134,6 +136,14 @@ ENVIRONMENT* getServerEnvironment()
         g_environ.private_path_substitute[0] = '\0';
     }
 
+    //-------------------------------------------------------------------------------------------
+    // XDR record stream buffer size (bytes): fixed for the connection, the legacy server does not grow the buffers
+
+    g_environ.xdr_buffer_size = DB_READ_BLOCK_SIZE;
+    if ((env = getenv("UDA_XDR_BUFFER_SIZE")) != nullptr && atoi(env) > 0) {
+        g_environ.xdr_buffer_size = atoi(env);
+    }
+
     g_environ.initialised = 1;
 
     return &g_environ;
@@ -14,6 +14,7 @@
 #include <cmath>
 #include <cfloat>
 #include <cerrno>
+#include <cstring>
 #include <vector>
 #include <string>
 #if defined(__GNUC__)
@@ -30,6 +31,7 @@
 #include <clientserver/initStructs.h>
 #include <clientserver/compressDim.h>
 #include <clientserver/stringUtils.h>
+#include <clientserver/subsetArray.h>
 #include <boost/algorithm/string.hpp>
 
 //----------------------------------------------------------------------------------------------------------------------------
@@ -52,9 +54,11 @@
 
 static int get_subset_indices(const std::string& operation, DIMS* dim, double value, unsigned int* subset_indices);
 
-int apply_sub_setting(DIMS* dims, int rank, int dim_id,
-                      char* data, int ndata, int data_type, int not_operation,
-                      int start, int end, int start1, int end1, int stride, int* n, void** new_data);
+namespace {
+
+using Selection = uda::SubsetSelection;
+
+} // anon namespace
 
 int number_of_subsetting_operations(const ACTION* action) {
     switch (action->actionType) {
@@ -90,6 +94,8 @@ int process_subset_operation(int ii, SUBSET subset, DATA_BLOCK* data_block, LOGM
         return 0;
     }
 
+    std::vector<Selection> selections;              // Indices selected along each dimension of the data
+
     for (int j = 0; j < n_bound; j++) {                        // Process each operation separately
 
         double value = subset.bound[j];
@@ -454,15 +460,19 @@ int process_subset_operation(int ii, SUBSET subset, DATA_BLOCK* data_block, LOGM
             if (start > end) {
                 UDA_THROW_ERROR(999, "start must be before end")
             }
+            if (start < 0 || end > dim->dim_n) {
+                UDA_THROW_ERROR(999, "index range is outside the dimension")
+            }
+            if (stride == 0) {
+                UDA_THROW_ERROR(999, "stride must not be zero")
+            }
             reshape = 1;
-            dim_n = abs((end - start) / stride);
         }
 
         if (operation[0] == '#') {            // Reshape Operation - Highest array position (last value)
             start = dim->dim_n - 1;
             end = dim->dim_n;
             reshape = 1;
-            dim_n = 1;
         }
 
         // Create an Array of Indices satisfying the criteria
@@ -522,6 +532,33 @@ int process_subset_operation(int ii, SUBSET subset, DATA_BLOCK* data_block, LOGM
             free(subset_indices);
         }
 
+        // Indices selected along the dimension: an exclusive index range with stride (negative strides run backwards
+        // from the end), or the inclusive range(s) satisfying the operation
+
+        std::vector<int> indices;
+
+        if (reshape) {
+            if (stride > 0) {
+                for (int i = start; i < end; i += stride) {
+                    indices.push_back(i);
+                }
+            } else {
+                for (int i = end - 1; i >= start; i += stride) {
+                    indices.push_back(i);
+                }
+            }
+        } else {
+            for (int i = start; i <= end; i++) {
+                indices.push_back(i);
+            }
+            if (not_operation && start1 >= 0) {           // A NOT operation may have found a second range
+                for (int i = start1; i <= end1; i++) {
+                    indices.push_back(i);
+                }
+            }
+        }
+
+        dim_n = (int)indices.size();
         new_dim.dim_n = dim_n;
 
         //----------------------------------------------------------------------------------------------------------------------------
@@ -532,72 +569,50 @@ int process_subset_operation(int ii, SUBSET subset, DATA_BLOCK* data_block, LOGM
         UDA_LOG(UDA_LOG_DEBUG, "\n\n\n*** dim->errhi != nullptr: %d\n\n\n", dim->errhi != nullptr);
         UDA_LOG(UDA_LOG_DEBUG, "\n\n\n*** dim->errlo != nullptr: %d\n\n\n", dim->errlo != nullptr);
 
-        int n;
+        std::vector<Selection> dim_selection = { { dim->dim_n, false, indices } };
+
+        int64_t n;
         int ierr = 0;
 
-        if ((ierr = apply_sub_setting(dim, 1, dim_id, dim->dim, dim_n, dim->data_type, not_operation,
-                                        start, end, start1, end1, stride, &n, (void**)&new_dim.dim)) != 0) {
+        if ((ierr = uda::subsetArray(dim_selection, dim->dim, dim->data_type, &n, &new_dim.dim)) != 0) {
             return ierr;
         }
 
         if (dim->errhi != nullptr && dim->error_type != UDA_TYPE_UNKNOWN) {
-            if ((ierr = apply_sub_setting(dim, 1, dim_id, dim->errhi, dim_n, dim->error_type, not_operation,
-                                            start, end, start1, end1, stride, &n, (void**)&new_dim.errhi)) != 0)
+            if ((ierr = uda::subsetArray(dim_selection, dim->errhi, dim->error_type, &n, &new_dim.errhi)) != 0) {
                 return ierr;
+            }
         }
 
         if (dim->errlo != nullptr && dim->error_type != UDA_TYPE_UNKNOWN) {
-            if ((ierr = apply_sub_setting(dim, 1, dim_id, dim->errlo, dim_n, dim->error_type, not_operation,
-                                            start, end, start1, end1, stride, &n, (void**)&new_dim.errlo)) != 0)
+            if ((ierr = uda::subsetArray(dim_selection, dim->errlo, dim->error_type, &n, &new_dim.errlo)) != 0) {
                 return ierr;
+            }
         }
 
         //-----------------------------------------------------------------------------------------------------------------------
-        // Reshape and Save the Subsetted Data
-
-        printDataBlock(*data_block);
-
-        int n_data;
-        char* new_data;
-
-        if ((ierr = apply_sub_setting(data_block->dims, data_block->rank, dim_id, data_block->data,
-                                        data_block->data_n, data_block->data_type, not_operation,
-                                        start, end, start1, end1, stride, &n_data, (void**)&new_data)) != 0) {
-            return ierr;
-        }
+        // Record the selection: the data are sub-set once all operations have been processed. A further operation on
+        // an already sub-setted dimension selects from the previous selection.
 
-        char* new_errhi;
-
-        if (data_block->error_type != UDA_TYPE_UNKNOWN && data_block->errhi != nullptr) {
-            if ((ierr = apply_sub_setting(data_block->dims, data_block->rank, dim_id, data_block->errhi,
-                                            data_block->data_n, data_block->error_type, not_operation,
-                                            start, end, start1, end1, stride, &n, (void**)&new_errhi)) != 0) {
-                return ierr;
+        if (selections.empty()) {
+            for (unsigned int k = 0; k < data_block->rank; k++) {
+                selections.push_back({ data_block->dims[k].dim_n, true, {} });
             }
-            free(data_block->errhi);                // Free Original Heap
-            data_block->errhi = new_errhi;                // Replace with the Reshaped Array
         }
 
-        char* new_errlo;
-
-        if (data_block->error_type != UDA_TYPE_UNKNOWN && dim->errlo != nullptr) {
-            if ((ierr = apply_sub_setting(data_block->dims, data_block->rank, dim_id, data_block->errlo,
-                                            data_block->data_n, data_block->error_type, not_operation,
-                                            start, end, start1, end1, stride, &n, (void**)&new_errlo)) != 0) {
-                return ierr;
+        auto& selection = selections[dim_id];
+        if (selection.all) {
+            selection.all = false;
+            selection.indices = indices;
+        } else {
+            std::vector<int> composed;
+            composed.reserve(indices.size());
+            for (int index : indices) {
+                composed.push_back(selection.indices[index]);
             }
-            free(data_block->errlo);                // Free Original Heap
-            data_block->errlo = new_errlo;                // Replace with the Reshaped Array
+            selection.indices = composed;
         }
 
-        data_block->data_n = n_data;
-
-        free(data_block->data);                // Free Original Heap
-        data_block->data = new_data;                    // Replace with the Reshaped Array
-
-        // replace the Original Dimensional Structure with the New Subsetted Structure unless a
-        // REFORM [Rank Reduction] has been requested and the dimension length is 1 (this has no effect on the Data Array items)
-
         // Free Heap associated with the original Dimensional Structure Array
 
         free(dim->dim);
@@ -613,6 +628,53 @@ int process_subset_operation(int ii, SUBSET subset, DATA_BLOCK* data_block, LOGM
         data_block->dims[dim_id] = new_dim;                            // Replace with the subsetted dimension
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------
+    // Reshape and Save the Subsetted Data: all dimensions in a single pass
+
+    if (selections.empty()) {
+        return 0;
+    }
+
+    printDataBlock(*data_block);
+
+    int64_t n;
+    int ierr = 0;
+
+    int64_t n_data;
+    char* new_data = nullptr;
+    char* new_errhi = nullptr;
+    char* new_errlo = nullptr;
+
+    // All the arrays are gathered before any is replaced, so a failure leaves the data block unchanged
+
+    bool errors = data_block->error_type != UDA_TYPE_UNKNOWN;
+
+    if ((ierr = uda::subsetArray(selections, data_block->data, data_block->data_type, &n_data, &new_data)) != 0
+        || (errors && data_block->errhi != nullptr
+            && (ierr = uda::subsetArray(selections, data_block->errhi, data_block->error_type, &n, &new_errhi)) != 0)
+        || (errors && data_block->errlo != nullptr
+            && (ierr = uda::subsetArray(selections, data_block->errlo, data_block->error_type, &n, &new_errlo)) != 0)) {
+        free(new_data);
+        free(new_errhi);
+        free(new_errlo);
+        return ierr;
+    }
+
+    if (new_errhi != nullptr) {
+        free(data_block->errhi);                // Free Original Heap
+        data_block->errhi = new_errhi;                // Replace with the Reshaped Array
+    }
+
+    if (new_errlo != nullptr) {
+        free(data_block->errlo);
+        data_block->errlo = new_errlo;
+    }
+
+    data_block->data_n = n_data;
+
+    free(data_block->data);                // Free Original Heap
+    data_block->data = new_data;                    // Replace with the Reshaped Array
+
     return 0;
 }
 
@@ -1330,11 +1392,11 @@ int serverSubsetData(DATA_BLOCK* data_block, const ACTION& action, LOGMALLOCLIST
     int n_subsets = number_of_subsetting_operations(&action);
 
     //-----------------------------------------------------------------------------------------------------------------------
-    // Check Rank
+    // Check Rank: any rank may be subset but the functions are limited to rank 2 or less
 
-    if (data_block->rank > 2 &&
-        !(action.actionType == UDA_SUBSET_TYPE && !strncasecmp(action.subset.function, "rotateRZ", 8))) {
-        UDA_THROW_ERROR(9999, "Not Configured to Subset Data with Rank Higher than 2");
+    if (data_block->rank > 2 && action.actionType == UDA_SUBSET_TYPE && action.subset.function[0] != '\0'
+            && strncasecmp(action.subset.function, "rotateRZ", 8) != 0) {
+        UDA_THROW_ERROR(9999, "Not Configured to Apply Functions to Data with Rank Higher than 2");
     }
 
     //-----------------------------------------------------------------------------------------------------------------------
@@ -1781,198 +1843,3 @@ int get_subset_indices(const std::string& operation, DIMS* dim, double value, un
 
     return count;
 }
-
-
-template <typename T>
-int apply_sub_setting_for_type(DIMS* dims, int rank, int dim_id,
-                      const char* data, int ndata, int data_type, int not_operation,
-                      int start, int end, int start1, int end1, int stride, int* n, void** new_data)
-{
-    // Allocate heap for the reshaped array
-
-    T* p = nullptr;
-    if ((p = (T*)malloc(ndata * sizeof(T))) == nullptr) {
-        UDA_THROW_ERROR(9999, "Unable to Allocate Heap memory");
-    }
-
-    auto dp = (T*)data;        // the Originating Data Array
-
-    // Reshape
-
-    switch (rank) {
-        case 1: {
-            int k = 0;
-            if (stride > 0) {
-                for (int i = start; i < end; i += stride) {
-                    p[k++] = dp[i];
-                }
-            } else {
-                for (int i = end - 1; i >= start; i += stride) {
-                    p[k++] = dp[i];
-                }
-            }
-            *n = k;
-            *new_data = (void*)p;
-            break;
-        }
-
-        case 2: {
-
-            // Original Data
-
-            int rows = dims[1].dim_n;
-            int columns = dims[0].dim_n;
-            auto dpa = (T**)malloc(rows * sizeof(T*));
-            for (int j = 0; j < rows; j++) {
-                dpa[j] = &dp[j * columns];
-            }
-
-            // Array for Reshaped Data
-
-            int new_rows = 0;
-            int new_cols = 0;
-
-            if (dim_id == 0) {
-                new_rows = dims[1].dim_n;
-                new_cols = end - start + 1;
-                if (not_operation) new_cols = new_cols + end1 - start1 + 1;
-            } else {
-                new_cols = dims[0].dim_n;
-                new_rows = end - start + 1;
-                if (not_operation) new_rows = new_rows + end1 - start1 + 1;
-            }
-
-            auto pa = (T**)malloc(new_rows * sizeof(T*));
-            for (int j = 0; j < new_rows; j++) {
-                pa[j] = &p[j * new_cols];
-            }
-
-            // Reshape the Data
-
-            int count = 0;
-
-            if (dim_id == 0) {
-                for (int j = 0; j < rows; j++) {
-                    int k = 0;
-                    if (stride > 0) {
-                        for (int i = start; i < end; i += stride) {
-                            pa[j][k++] = dpa[j][i];
-                            count++;
-                        }
-                        if (not_operation) {
-                            for (int i = start1; i < end1; i += stride) {
-                                pa[j][k++] = dpa[j][i];
-                                count++;
-                            }
-                        }
-                    } else {
-                        if (not_operation) {
-                            for (int i = end1 - 1; i >= start1; i += stride) {
-                                pa[j][k++] = dpa[j][i];
-                                count++;
-                            }
-                        }
-                        for (int i = end; i >= start; i += stride) {
-                            pa[j][k++] = dpa[j][i];
-                            count++;
-                        }
-                    }
-                }
-            } else {
-                int k = 0;
-                if (stride > 0) {
-                    for (int j = start; j < end; j += stride) {
-                        for (int i = 0; i < columns; i++) {
-                            pa[k][i] = dpa[j][i];
-                            count++;
-                        }
-                        k++;
-                    }
-                    if (not_operation) {
-                        for (int j = start1; j < end1; j += stride) {
-                            for (int i = 0; i < columns; i++) {
-                                pa[k][i] = dpa[j][i];
-                                count++;
-                            }
-                            k++;
-                        }
-                    }
-                } else {
-                    if (not_operation) {
-                        for (int j = end1 - 1; j >= start1; j += stride) {
-                            for (int i = 0; i < columns; i++) {
-                                pa[k][i] = dpa[j][i];
-                                count++;
-                            }
-                            k++;
-                        }
-                    }
-                    for (int j = end - 1; j >= start; j += stride) {
-                        for (int i = 0; i < columns; i++) {
-                            pa[k][i] = dpa[j][i];
-                            count++;
-                        }
-                        k++;
-                    }
-                }
-            }
-
-            *new_data = (void*)&pa[0][0];
-            *n = count;
-            break;
-        }
-    }
-
-    return 0;
-}
-
-int apply_sub_setting(DIMS* dims, int rank, int dim_id,
-                        char* data, int ndata, int data_type, int not_operation,
-                        int start, int end, int start1, int end1, int stride, int* n, void** new_data)
-{
-    UDA_LOG(UDA_LOG_DEBUG, "Data Type: %d    Rank: %d\n", data_type, rank);
-
-    *n = 0;
-
-    switch (data_type) {
-        case UDA_TYPE_FLOAT:
-            return apply_sub_setting_for_type<float>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_DOUBLE:
-            return apply_sub_setting_for_type<double>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_INT:
-            return apply_sub_setting_for_type<int>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_SHORT:
-            return apply_sub_setting_for_type<short>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_LONG:
-            return apply_sub_setting_for_type<long>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_LONG64:
-            return apply_sub_setting_for_type<int64_t>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_UNSIGNED_INT:
-            return apply_sub_setting_for_type<unsigned int>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_UNSIGNED_SHORT:
-            return apply_sub_setting_for_type<unsigned short>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_UNSIGNED_LONG:
-            return apply_sub_setting_for_type<unsigned long>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        case UDA_TYPE_UNSIGNED_LONG64:
-            return apply_sub_setting_for_type<uint64_t>(dims, rank, dim_id, data, ndata, data_type, not_operation, start, end, start1, end1, stride, n, new_data);
-            break;
-        default:
-            UDA_LOG(UDA_LOG_ERROR, "Invalid data type for sub-setting operation!\n");
-            UDA_LOG(UDA_LOG_ERROR, "Data Type: %d    Rank: %d\n", data_type, rank);
-            UDA_THROW_ERROR(9999, "Invalid data type for sub-setting operation!");
-    }
-
-    return 0;
-}
-
-
-
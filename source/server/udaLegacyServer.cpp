@@ -44,7 +44,7 @@ int legacyServer(CLIENT_BLOCK client_block, const PLUGINLIST* pluginlist, LOGMAL
     int protocol_id, next_protocol;
 
     static unsigned short normalLegacyWait = 0;
-    static unsigned int total_datablock_size = 0;
+    static size_t total_datablock_size = 0;
 
     SYSTEM_CONFIG system_config;
     DATA_SYSTEM data_system;
@@ -73,20 +73,20 @@ static int handleRequest(REQUEST_BLOCK* request_block, CLIENT_BLOCK* client_bloc
                          METADATA_BLOCK* metadata_block, ACTIONS* actions_desc, ACTIONS* actions_sig,
                          DATA_BLOCK_LIST* data_block_list, int* fatal, int* server_closedown,
                          uda::cache::UdaCache* cache,
-                         LOGSTRUCTLIST* log_struct_list, XDR* server_input, const unsigned int* total_datablock_size,
+                         LOGSTRUCTLIST* log_struct_list, XDR* server_input, const size_t* total_datablock_size,
                          int server_tot_block_time, int* server_timeout);
 
 static int doServerLoop(REQUEST_BLOCK* request_block, DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block,
                         SERVER_BLOCK* server_block, METADATA_BLOCK* metadata_block, ACTIONS* actions_desc,
                         ACTIONS* actions_sig, int* fatal, uda::cache::UdaCache* cache, LOGSTRUCTLIST* log_struct_list,
-                        XDR* server_input, XDR* server_output, unsigned int* total_datablock_size,
+                        XDR* server_input, XDR* server_output, size_t* total_datablock_size,
                         int server_tot_block_time,
                         int* server_timeout);
 
 static int
 reportToClient(SERVER_BLOCK* server_block, DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block, int trap1Err,
                METADATA_BLOCK* metadata_block, LOGSTRUCTLIST* log_struct_list, XDR* server_input, XDR* server_output,
-               unsigned int* total_datablock_size);
+               size_t* total_datablock_size);
 
 static int doServerClosedown(CLIENT_BLOCK* client_block, REQUEST_BLOCK* request_block, DATA_BLOCK_LIST* data_block_list,
                              int server_tot_block_time, int server_timeout);
@@ -139,7 +139,7 @@ int udaServer(CLIENT_BLOCK client_block)
 
     uda::cache::UdaCache* cache = uda::cache::open_cache();
 
-    static unsigned int total_datablock_size = 0;
+    static size_t total_datablock_size = 0;
 
     if ((err = startupServer(&server_block, server_input, server_output, &io_data)) != 0) return err;
 
@@ -170,7 +170,7 @@ int udaServer(CLIENT_BLOCK client_block)
 int
 reportToClient(SERVER_BLOCK* server_block, DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block, int trap1Err,
                METADATA_BLOCK* metadata_block, LOGSTRUCTLIST* log_struct_list, XDR* server_input, XDR* server_output,
-               unsigned int* total_datablock_size)
+               size_t* total_datablock_size)
 {
     //----------------------------------------------------------------------------
     // Gather Server Error State
@@ -375,7 +375,7 @@ reportToClient(SERVER_BLOCK* server_block, DATA_BLOCK_LIST* data_block_list, CLI
 int handleRequest(REQUEST_BLOCK* request_block, CLIENT_BLOCK* client_block, SERVER_BLOCK* server_block,
                   METADATA_BLOCK* metadata_block, ACTIONS* actions_desc, ACTIONS* actions_sig,
                   DATA_BLOCK_LIST* data_block_list, int* fatal, int* server_closedown, uda::cache::UdaCache* cache,
-                  LOGSTRUCTLIST* log_struct_list, XDR* server_input, const unsigned int* total_datablock_size,
+                  LOGSTRUCTLIST* log_struct_list, XDR* server_input, const size_t* total_datablock_size,
                   int server_tot_block_time, int* server_timeout)
 {
     UDA_LOG(UDA_LOG_DEBUG, "Start of Server Error Trap #1 Loop\n");
@@ -819,7 +819,7 @@ int handleRequest(REQUEST_BLOCK* request_block, CLIENT_BLOCK* client_block, SERV
 int doServerLoop(REQUEST_BLOCK* request_block, DATA_BLOCK_LIST* data_block_list, CLIENT_BLOCK* client_block,
                  SERVER_BLOCK* server_block, METADATA_BLOCK* metadata_block, ACTIONS* actions_desc,
                  ACTIONS* actions_sig, int* fatal, uda::cache::UdaCache* cache, LOGSTRUCTLIST* log_struct_list,
-                 XDR* server_input, XDR* server_output, unsigned int* total_datablock_size, int server_tot_block_time,
+                 XDR* server_input, XDR* server_output, size_t* total_datablock_size, int server_tot_block_time,
                  int* server_timeout)
 {
     int err = 0;
@@ -15,7 +15,14 @@
 #include "apply_XML.hpp"
 
 #include <cmath>
+#include <cstdint>
 #include <memory.h>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#  include <immintrin.h>
+#  define CALIBRATION_SIMD
+#endif
 
 #include <logging/logging.h>
 #include <clientserver/udaTypes.h>
@@ -126,110 +133,309 @@ int uda::server_parse_signal_XML(DATA_SOURCE data_source, SIGNAL signal, SIGNAL_
 
 namespace {
 
-void applyCalibration(int type, int ndata, double factor, double offset, int invert, char* array)
+//----------------------------------------------------------------------------------------------
+// Calibration kernels: factor * x + offset, optionally followed by inversion, applied in place in a
+// single pass. Floating point arrays use AVX vector kernels when the processor supports them, SSE2
+// otherwise. The multiply and add are not fused so the vector and scalar kernels give identical results.
+// Integer arrays are calibrated in their own type, with the factor and offset truncated to it, so the
+// 16 and 32 bit integer kernels (AVX2, else SSE2 or SSE4.1) keep the low bits of the product as the
+// scalar code does. There are no 8 or 64 bit vector multiplies: char and 64 bit arrays stay scalar.
+
+template <typename T>
+void calibrateScalar(T* array, int begin, int ndata, double factor, double offset, bool linear, bool invert)
 {
-    float* fp;
-    double* dp;
-    char* cp;
-    short* sp;
-    int* ip;
-    long* lp;
-    long long* llp;
-    unsigned char* uc;
-    unsigned short* us;
-    unsigned int* up;
-    unsigned long* ul;
-    unsigned long long* ull;
+    T tfactor = (T)factor;
+    T toffset = (T)offset;
 
-    if (array == nullptr) return;                                // No Data
-    if (factor == (double)1.0E0 && offset == (double)0.0E0 && !invert) return;        // Nothing to be applied
+    if (linear) {
+        for (int i = begin; i < ndata; i++) array[i] = tfactor * array[i] + toffset;
+    }
 
+    // Invert floating point number: Integers would all be zero!
 
-    if (factor != (double)1.0E0 || offset != (double)0.0E0) {
-        switch (type) {
+    if constexpr (std::is_floating_point<T>::value) {
+        if (invert) {
+            for (int i = begin; i < ndata; i++) array[i] = array[i] != 0.0 ? (T)1.0 / array[i] : (T)NAN;
+        }
+    }
+}
 
-            case UDA_TYPE_FLOAT:fp = (float*)array;
-                for (int i = 0; i < ndata; i++) fp[i] = (float)factor * fp[i] + (float)offset;
-                break;
+#ifdef CALIBRATION_SIMD
 
-            case UDA_TYPE_DOUBLE:dp = (double*)array;
-                for (int i = 0; i < ndata; i++) dp[i] = factor * dp[i] + offset;
-                break;
+bool hasAVX()
+{
+    static const bool avx = __builtin_cpu_supports("avx");
+    return avx;
+}
 
-            case UDA_TYPE_CHAR:cp = (char*)array;
-                for (int i = 0; i < ndata; i++) cp[i] = (char)factor * cp[i] + (char)offset;
-                break;
+bool hasAVX2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
 
-            case UDA_TYPE_SHORT:sp = (short*)array;
-                for (int i = 0; i < ndata; i++) sp[i] = (short)factor * sp[i] + (short)offset;
-                break;
+bool hasSSE41()
+{
+    static const bool sse41 = __builtin_cpu_supports("sse4.1");
+    return sse41;
+}
 
-            case UDA_TYPE_INT:ip = (int*)array;
-                for (int i = 0; i < ndata; i++) ip[i] = (int)factor * ip[i] + (int)offset;
-                break;
+__attribute__((target("avx")))
+int calibrateAVX(float* array, int ndata, float factor, float offset, bool linear, bool invert)
+{
+    const __m256 vfactor = _mm256_set1_ps(factor);
+    const __m256 voffset = _mm256_set1_ps(offset);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 nan = _mm256_set1_ps(NAN);
+
+    int i = 0;
+    for (; i + 8 <= ndata; i += 8) {
+        __m256 x = _mm256_loadu_ps(array + i);
+        if (linear) x = _mm256_add_ps(_mm256_mul_ps(vfactor, x), voffset);
+        if (invert) x = _mm256_blendv_ps(nan, _mm256_div_ps(one, x), _mm256_cmp_ps(x, zero, _CMP_NEQ_UQ));
+        _mm256_storeu_ps(array + i, x);
+    }
+    return i;
+}
 
-            case UDA_TYPE_LONG:lp = (long*)array;
-                for (int i = 0; i < ndata; i++) lp[i] = (long)factor * lp[i] + (long)offset;
-                break;
+__attribute__((target("avx")))
+int calibrateAVX(double* array, int ndata, double factor, double offset, bool linear, bool invert)
+{
+    const __m256d vfactor = _mm256_set1_pd(factor);
+    const __m256d voffset = _mm256_set1_pd(offset);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d nan = _mm256_set1_pd(NAN);
+
+    int i = 0;
+    for (; i + 4 <= ndata; i += 4) {
+        __m256d x = _mm256_loadu_pd(array + i);
+        if (linear) x = _mm256_add_pd(_mm256_mul_pd(vfactor, x), voffset);
+        if (invert) x = _mm256_blendv_pd(nan, _mm256_div_pd(one, x), _mm256_cmp_pd(x, zero, _CMP_NEQ_UQ));
+        _mm256_storeu_pd(array + i, x);
+    }
+    return i;
+}
 
-// cause a bug: unresolved __fixunsdfdi  - need gcc_s library
-            case UDA_TYPE_LONG64:llp = (long long*)array;
-                for (int i = 0; i < ndata; i++) llp[i] = (long long)factor * llp[i] + (long long)offset;
-                break;
+int calibrateSSE2(float* array, int ndata, float factor, float offset, bool linear, bool invert)
+{
+    const __m128 vfactor = _mm_set1_ps(factor);
+    const __m128 voffset = _mm_set1_ps(offset);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 nan = _mm_set1_ps(NAN);
+
+    int i = 0;
+    for (; i + 4 <= ndata; i += 4) {
+        __m128 x = _mm_loadu_ps(array + i);
+        if (linear) x = _mm_add_ps(_mm_mul_ps(vfactor, x), voffset);
+        if (invert) {
+            __m128 nonzero = _mm_cmpneq_ps(x, zero);
+            x = _mm_or_ps(_mm_and_ps(nonzero, _mm_div_ps(one, x)), _mm_andnot_ps(nonzero, nan));
+        }
+        _mm_storeu_ps(array + i, x);
+    }
+    return i;
+}
 
-            case UDA_TYPE_UNSIGNED_CHAR:uc = (unsigned char*)array;
-                for (int i = 0; i < ndata; i++) uc[i] = (unsigned char)factor * uc[i] + (unsigned char)offset;
-                break;
+int calibrateSSE2(double* array, int ndata, double factor, double offset, bool linear, bool invert)
+{
+    const __m128d vfactor = _mm_set1_pd(factor);
+    const __m128d voffset = _mm_set1_pd(offset);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d nan = _mm_set1_pd(NAN);
+
+    int i = 0;
+    for (; i + 2 <= ndata; i += 2) {
+        __m128d x = _mm_loadu_pd(array + i);
+        if (linear) x = _mm_add_pd(_mm_mul_pd(vfactor, x), voffset);
+        if (invert) {
+            __m128d nonzero = _mm_cmpneq_pd(x, zero);
+            x = _mm_or_pd(_mm_and_pd(nonzero, _mm_div_pd(one, x)), _mm_andnot_pd(nonzero, nan));
+        }
+        _mm_storeu_pd(array + i, x);
+    }
+    return i;
+}
 
-            case UDA_TYPE_UNSIGNED_SHORT:us = (unsigned short*)array;
-                for (int i = 0; i < ndata; i++) us[i] = (unsigned short)factor * us[i] + (unsigned short)offset;
-                break;
+// Signed and unsigned integers of a size share these kernels: the low bits of a product do not depend on the sign
 
-            case UDA_TYPE_UNSIGNED_INT:up = (unsigned int*)array;
-                for (int i = 0; i < ndata; i++) up[i] = (unsigned int)factor * up[i] + (unsigned int)offset;
-                break;
+__attribute__((target("avx2")))
+int calibrateAVX2(uint16_t* array, int ndata, uint16_t factor, uint16_t offset)
+{
+    const __m256i vfactor = _mm256_set1_epi16((short)factor);
+    const __m256i voffset = _mm256_set1_epi16((short)offset);
+
+    int i = 0;
+    for (; i + 16 <= ndata; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(array + i));
+        x = _mm256_add_epi16(_mm256_mullo_epi16(vfactor, x), voffset);
+        _mm256_storeu_si256((__m256i*)(array + i), x);
+    }
+    return i;
+}
 
-            case UDA_TYPE_UNSIGNED_LONG:ul = (unsigned long*)array;
-                for (int i = 0; i < ndata; i++) ul[i] = (unsigned long)factor * ul[i] + (unsigned long)offset;
-                break;
+__attribute__((target("avx2")))
+int calibrateAVX2(uint32_t* array, int ndata, uint32_t factor, uint32_t offset)
+{
+    const __m256i vfactor = _mm256_set1_epi32((int)factor);
+    const __m256i voffset = _mm256_set1_epi32((int)offset);
+
+    int i = 0;
+    for (; i + 8 <= ndata; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(array + i));
+        x = _mm256_add_epi32(_mm256_mullo_epi32(vfactor, x), voffset);
+        _mm256_storeu_si256((__m256i*)(array + i), x);
+    }
+    return i;
+}
 
-            case UDA_TYPE_UNSIGNED_LONG64:ull = (unsigned long long*)array;
-                for (int i = 0; i < ndata; i++)
-                    ull[i] = (unsigned long long)factor * ull[i] +
-                             (unsigned long long)offset;
-                break;
+int calibrateSSE2(uint16_t* array, int ndata, uint16_t factor, uint16_t offset)
+{
+    const __m128i vfactor = _mm_set1_epi16((short)factor);
+    const __m128i voffset = _mm_set1_epi16((short)offset);
+
+    int i = 0;
+    for (; i + 8 <= ndata; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(array + i));
+        x = _mm_add_epi16(_mm_mullo_epi16(vfactor, x), voffset);
+        _mm_storeu_si128((__m128i*)(array + i), x);
+    }
+    return i;
+}
 
-            default:break;
-        }
+__attribute__((target("sse4.1")))
+int calibrateSSE41(uint32_t* array, int ndata, uint32_t factor, uint32_t offset)
+{
+    const __m128i vfactor = _mm_set1_epi32((int)factor);
+    const __m128i voffset = _mm_set1_epi32((int)offset);
+
+    int i = 0;
+    for (; i + 4 <= ndata; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(array + i));
+        x = _mm_add_epi32(_mm_mullo_epi32(vfactor, x), voffset);
+        _mm_storeu_si128((__m128i*)(array + i), x);
     }
+    return i;
+}
 
-    // Invert floating point number: Integers would all be zero!
+template <typename T>
+int calibrateIntegers(T* array, int ndata, T factor, T offset)
+{
+    if constexpr (sizeof(T) == sizeof(uint16_t)) {
+        return hasAVX2() ? calibrateAVX2((uint16_t*)array, ndata, (uint16_t)factor, (uint16_t)offset)
+                         : calibrateSSE2((uint16_t*)array, ndata, (uint16_t)factor, (uint16_t)offset);
+    } else if constexpr (sizeof(T) == sizeof(uint32_t)) {
+        if (hasAVX2()) return calibrateAVX2((uint32_t*)array, ndata, (uint32_t)factor, (uint32_t)offset);
+        if (hasSSE41()) return calibrateSSE41((uint32_t*)array, ndata, (uint32_t)factor, (uint32_t)offset);
+    }
+    return 0;
+}
 
-    if (invert) {
-        switch (type) {
+#endif // CALIBRATION_SIMD
 
-            case UDA_TYPE_FLOAT:fp = (float*)array;
-                for (int i = 0; i < ndata; i++)
-                    if (fp[i] != 0.0) { fp[i] = 1.0f / fp[i]; }
-                    else { fp[i] = NAN; }
-                break;
+template <typename T>
+void calibrate(char* array, int ndata, double factor, double offset, bool linear, bool invert)
+{
+    auto data = (T*)array;
+    int done = 0;
+
+#ifdef CALIBRATION_SIMD
+    if constexpr (std::is_floating_point<T>::value) {
+        done = hasAVX() ? calibrateAVX(data, ndata, (T)factor, (T)offset, linear, invert)
+                        : calibrateSSE2(data, ndata, (T)factor, (T)offset, linear, invert);
+    } else if (linear) {
+        done = calibrateIntegers(data, ndata, (T)factor, (T)offset);
+    }
+#endif
 
-            case UDA_TYPE_DOUBLE:dp = (double*)array;
-                for (int i = 0; i < ndata; i++)
-                    if (dp[i] != 0.0) { dp[i] = 1.0 / dp[i]; }
-                    else { dp[i] = NAN; }
-                break;
+    calibrateScalar(data, done, ndata, factor, offset, linear, invert);
+}
 
-            default:break;
-        }
+void applyCalibration(int type, int ndata, double factor, double offset, int invert, char* array)
+{
+    if (array == nullptr) return;                                // No Data
+    if (factor == (double)1.0E0 && offset == (double)0.0E0 && !invert) return;        // Nothing to be applied
+
+    bool linear = factor != (double)1.0E0 || offset != (double)0.0E0;
+
+    switch (type) {
+        case UDA_TYPE_FLOAT:
+            calibrate<float>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_DOUBLE:
+            calibrate<double>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_CHAR:
+            calibrate<char>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_SHORT:
+            calibrate<short>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_INT:
+            calibrate<int>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_LONG:
+            calibrate<long>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_LONG64:
+            calibrate<long long>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_UNSIGNED_CHAR:
+            calibrate<unsigned char>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_UNSIGNED_SHORT:
+            calibrate<unsigned short>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_UNSIGNED_INT:
+            calibrate<unsigned int>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_UNSIGNED_LONG:
+            calibrate<unsigned long>(array, ndata, factor, offset, linear, invert);
+            break;
+        case UDA_TYPE_UNSIGNED_LONG64:
+            calibrate<unsigned long long>(array, ndata, factor, offset, linear, invert);
+            break;
+        default:
+            break;
     }
 }
 
 } // anon namespace
 
+/**
+ * Apply a sequence of calibrations to an array, skipping any deferred when the array had a different type.
+ */
+void uda::server_apply_calibrations(const std::vector<Calibration>& calibrations, int type, int ndata, char* array)
+{
+    for (const auto& calibration : calibrations) {
+        if (calibration.type == type) {
+            applyCalibration(type, ndata, calibration.factor, calibration.offset, calibration.invert, array);
+        }
+    }
+}
+
+/**
+ * Apply in place any calibrations still pending on the data block, e.g. when no subset was taken.
+ */
+void uda::server_apply_deferred_calibrations(DATA_BLOCK* data_block, DeferredCalibrations* deferred)
+{
+    if (deferred == nullptr) return;
+
+    server_apply_calibrations(deferred->data, data_block->data_type, data_block->data_n, data_block->data);
+    server_apply_calibrations(deferred->errhi, data_block->error_type, data_block->data_n, data_block->errhi);
+    server_apply_calibrations(deferred->errlo, data_block->error_type, data_block->data_n, data_block->errlo);
+
+    deferred->data.clear();
+    deferred->errhi.clear();
+    deferred->errlo.clear();
+}
+
 void uda::server_apply_signal_XML(CLIENT_BLOCK client_block, DATA_SOURCE* data_source, SIGNAL* signal,
                                   SIGNAL_DESC* signal_desc,
-                                  DATA_BLOCK* data_block, ACTIONS actions)
+                                  DATA_BLOCK* data_block, ACTIONS actions, DeferredCalibrations* deferred)
 {
 
     int ndata, dimid;
@@ -612,74 +818,9 @@ void uda::server_apply_signal_XML(CLIENT_BLOCK client_block, DATA_SOURCE* data_s
                         UDA_LOG(UDA_LOG_DEBUG, "Order           = %d\n", data_block->order);
                         UDA_LOG(UDA_LOG_DEBUG, "Timing Offset   = %f\n", (float)actions.action[i].timeoffset.offset);
 
-                        switch (data_block->dims[data_block->order].data_type) {
-                            int ii;
-                            case UDA_TYPE_FLOAT:
-                                UDA_LOG(UDA_LOG_DEBUG, "Correcting Time Dimension\n");
-                                UDA_LOG(UDA_LOG_DEBUG, "Offset ? : %f\n", (float)actions.action[i].timeoffset.offset);
-                                fp = (float*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    fp[ii] = (float)actions.action[i].timeoffset.offset + fp[ii];
-                                }
-                                break;
-                            case UDA_TYPE_DOUBLE:
-                                dp = (double*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    dp[ii] = actions.action[i].timeoffset.offset + dp[ii];
-                                }
-                                break;
-                            case UDA_TYPE_CHAR:
-                                cp = (char*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    cp[ii] = (char)actions.action[i].timeoffset.offset + cp[ii];
-                                }
-                                break;
-                            case UDA_TYPE_SHORT:
-                                sp = (short*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    sp[ii] = (short)actions.action[i].timeoffset.offset + sp[ii];
-                                }
-                                break;
-                            case UDA_TYPE_INT:
-                                ip = (int*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    ip[ii] = (int)actions.action[i].timeoffset.offset + ip[ii];
-                                }
-                                break;
-                            case UDA_TYPE_LONG:
-                                lp = (long*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    lp[ii] = (long)actions.action[i].timeoffset.offset + lp[ii];
-                                }
-                                break;
-                            case UDA_TYPE_UNSIGNED_CHAR:
-                                uc = (unsigned char*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    uc[ii] = (unsigned char)actions.action[i].timeoffset.offset + uc[ii];
-                                }
-                                break;
-                            case UDA_TYPE_UNSIGNED_SHORT:
-                                us = (unsigned short*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    us[ii] = (unsigned short)actions.action[i].timeoffset.offset + us[ii];
-                                }
-                                break;
-                            case UDA_TYPE_UNSIGNED_INT:
-                                up = (unsigned int*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    up[ii] = (unsigned int)actions.action[i].timeoffset.offset + up[ii];
-                                }
-                                break;
-                            case UDA_TYPE_UNSIGNED_LONG:
-                                ul = (unsigned long*)data_block->dims[data_block->order].dim;
-                                for (ii = 0; ii < ndata; ii++) {
-                                    ul[ii] = (unsigned long)actions.action[i].timeoffset.offset + ul[ii];
-                                }
-                                break;
-
-                            default:
-                                break;
-                        }
+                        applyCalibration(data_block->dims[data_block->order].data_type, ndata, 1.0,
+                                         actions.action[i].timeoffset.offset, 0,
+                                         data_block->dims[data_block->order].dim);
                     }
                 }
                 break;
@@ -699,26 +840,44 @@ void uda::server_apply_signal_XML(CLIENT_BLOCK client_block, DATA_SOURCE* data_s
                         if (strlen(actions.action[i].calibration.units) > 0)
                             strcpy(data_block->data_units, actions.action[i].calibration.units);
 
-                        applyCalibration(data_block->data_type, data_block->data_n,
-                                         actions.action[i].calibration.factor,
-                                         actions.action[i].calibration.offset, actions.action[i].calibration.invert,
-                                         data_block->data);
+                        if (deferred != nullptr) {
+                            deferred->data.push_back({ data_block->data_type, actions.action[i].calibration.factor,
+                                                       actions.action[i].calibration.offset,
+                                                       actions.action[i].calibration.invert });
+                        } else {
+                            applyCalibration(data_block->data_type, data_block->data_n,
+                                             actions.action[i].calibration.factor,
+                                             actions.action[i].calibration.offset, actions.action[i].calibration.invert,
+                                             data_block->data);
+                        }
                     }
 
                     if (STR_EQUALS("error", actions.action[i].calibration.target) ||
                         STR_EQUALS("all", actions.action[i].calibration.target)) {
-                        applyCalibration(data_block->error_type, data_block->data_n,
-                                         actions.action[i].calibration.factor,
-                                         actions.action[i].calibration.offset, actions.action[i].calibration.invert,
-                                         data_block->errhi);
+                        if (deferred != nullptr) {
+                            deferred->errhi.push_back({ data_block->error_type, actions.action[i].calibration.factor,
+                                                        actions.action[i].calibration.offset,
+                                                        actions.action[i].calibration.invert });
+                        } else {
+                            applyCalibration(data_block->error_type, data_block->data_n,
+                                             actions.action[i].calibration.factor,
+                                             actions.action[i].calibration.offset, actions.action[i].calibration.invert,
+                                             data_block->errhi);
+                        }
                     }
 
                     if (STR_EQUALS("aserror", actions.action[i].calibration.target) ||
                         STR_EQUALS("all", actions.action[i].calibration.target)) {
-                        applyCalibration(data_block->error_type, data_block->data_n,
-                                         actions.action[i].calibration.factor,
-                                         actions.action[i].calibration.offset, actions.action[i].calibration.invert,
-                                         data_block->errlo);
+                        if (deferred != nullptr) {
+                            deferred->errlo.push_back({ data_block->error_type, actions.action[i].calibration.factor,
+                                                        actions.action[i].calibration.offset,
+                                                        actions.action[i].calibration.invert });
+                        } else {
+                            applyCalibration(data_block->error_type, data_block->data_n,
+                                             actions.action[i].calibration.factor,
+                                             actions.action[i].calibration.offset, actions.action[i].calibration.invert,
+                                             data_block->errlo);
+                        }
                     }
 
                     // Dimension Corrections
@@ -3,17 +3,39 @@
 #ifndef UDA_SERVER_APPLYXML_H
 #define UDA_SERVER_APPLYXML_H
 
+#include <vector>
+
 #include <clientserver/parseXML.h>
 #include <clientserver/udaStructs.h>
 #include <clientserver/export.h>
 
 namespace uda {
 
+// A data calibration deferred by server_apply_signal_XML so that it can be applied as the data are subset
+struct Calibration {
+    int type;           // Type of the array when the calibration was deferred: not applied if the type has changed
+    double factor;
+    double offset;
+    int invert;
+};
+
+// Calibrations pending on the data and its errors, applied in the order given
+struct DeferredCalibrations {
+    std::vector<Calibration> data;
+    std::vector<Calibration> errhi;
+    std::vector<Calibration> errlo;
+};
+
 int server_parse_signal_XML(DATA_SOURCE data_source, SIGNAL signal, SIGNAL_DESC signal_desc,
                             ACTIONS* actions_desc, ACTIONS* actions_sig);
 
 void server_apply_signal_XML(CLIENT_BLOCK client_block, DATA_SOURCE* data_source, SIGNAL* signal,
-                             SIGNAL_DESC* signal_desc, DATA_BLOCK* data_block, ACTIONS actions);
+                             SIGNAL_DESC* signal_desc, DATA_BLOCK* data_block, ACTIONS actions,
+                             DeferredCalibrations* deferred = nullptr);
+
+void server_apply_calibrations(const std::vector<Calibration>& calibrations, int type, int ndata, char* array);
+
+void server_apply_deferred_calibrations(DATA_BLOCK* data_block, DeferredCalibrations* deferred);
 
 void server_deselect_signal_XML(ACTIONS* actions_desc, ACTIONS* actions_sig);
 
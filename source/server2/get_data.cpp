@@ -806,14 +806,20 @@ int uda::Server::get_data(int* depth, RequestData* request_data, DataBlock* data
     UDA_LOG(UDA_LOG_DEBUG, "#Timing Before XML\n");
     printDataBlock(*data_block);
 
+    // Calibration of the data is deferred to the subsetting pass so that only the elements returned are calibrated
+
+    DeferredCalibrations calibrations;
+
     if (!client_block_.get_asis) {
 
         // All Signal Actions have Precedence over Signal_Desc Actions: Deselect if there is a conflict
 
         server_deselect_signal_XML(&actions_desc_, &actions_sig_);
 
-        server_apply_signal_XML(client_block_, data_source, signal_rec, signal_desc, data_block, actions_desc_);
-        server_apply_signal_XML(client_block_, data_source, signal_rec, signal_desc, data_block, actions_sig_);
+        server_apply_signal_XML(client_block_, data_source, signal_rec, signal_desc, data_block, actions_desc_,
+                                &calibrations);
+        server_apply_signal_XML(client_block_, data_source, signal_rec, signal_desc, data_block, actions_sig_,
+                                &calibrations);
     }
 
     UDA_LOG(UDA_LOG_DEBUG, "#Timing After XML\n");
@@ -826,7 +832,8 @@ int uda::Server::get_data(int* depth, RequestData* request_data, DataBlock* data
         UDA_LOG(UDA_LOG_DEBUG, "Calling serverSubsetData (Derived)  %d\n", *depth);
         printDataBlock(*data_block);
 
-        if ((rc = serverSubsetData(data_block, actions_desc_.action[compId], log_malloc_list_)) != 0) {
+        if ((rc = serverSubsetData(data_block, actions_desc_.action[compId], log_malloc_list_,
+                                   &calibrations)) != 0) {
             (*depth)--;
             return rc;
         }
@@ -841,7 +848,8 @@ int uda::Server::get_data(int* depth, RequestData* request_data, DataBlock* data
                 UDA_LOG(UDA_LOG_DEBUG, "Calling serverSubsetData (SUBSET)   %d\n", *depth);
                 printDataBlock(*data_block);
 
-                if ((rc = serverSubsetData(data_block, actions_desc_.action[i], log_malloc_list_)) != 0) {
+                if ((rc = serverSubsetData(data_block, actions_desc_.action[i], log_malloc_list_,
+                                           &calibrations)) != 0) {
                     (*depth)--;
                     return rc;
                 }
@@ -859,7 +867,8 @@ int uda::Server::get_data(int* depth, RequestData* request_data, DataBlock* data
                     UDA_LOG(UDA_LOG_DEBUG, "Calling serverSubsetData (Serverside)   %d\n", *depth);
                     printDataBlock(*data_block);
 
-                    if ((rc = serverSubsetData(data_block, actions_serverside.action[i], log_malloc_list_)) != 0) {
+                    if ((rc = serverSubsetData(data_block, actions_serverside.action[i], log_malloc_list_,
+                                               &calibrations)) != 0) {
                         (*depth)--;
                         return rc;
                     }
@@ -869,6 +878,8 @@ int uda::Server::get_data(int* depth, RequestData* request_data, DataBlock* data
         freeActions(&actions_serverside);
     }
 
+    server_apply_deferred_calibrations(data_block, &calibrations);
+
 //--------------------------------------------------------------------------------------------------------------------------
 
     (*depth)--;
@@ -0,0 +1,218 @@
+#include "server.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <deque>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "cache/cache.h"
+#include "clientserver/errorLog.h"
+#include "clientserver/initStructs.h"
+#include "clientserver/udaTypes.h"
+#include "logging/logging.h"
+#include "plugins/udaPlugin.h"
+#include "structures/struct.h"
+
+namespace {
+
+// Exit status of a request worker whose result cannot be passed back (e.g. structured data): re-run in the server
+constexpr int WorkerFallback = 2;
+
+struct RequestWorker {
+    int index;
+    pid_t pid;
+    FILE* result;
+};
+
+void write_worker_errors(FILE* fp)
+{
+    UDA_ERROR_STACK error_stack = {};
+    concatUdaError(&error_stack);
+
+    fwrite(&error_stack.nerrors, sizeof(error_stack.nerrors), 1, fp);
+    if (error_stack.nerrors > 0) {
+        fwrite(error_stack.idamerror, sizeof(UDA_ERROR), error_stack.nerrors, fp);
+    }
+
+    freeIdamErrorStack(&error_stack);
+}
+
+bool read_worker_errors(FILE* fp)
+{
+    unsigned int nerrors = 0;
+    if (fread(&nerrors, sizeof(nerrors), 1, fp) != 1) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < nerrors; ++i) {
+        UDA_ERROR error = {};
+        if (fread(&error, sizeof(UDA_ERROR), 1, fp) != 1) {
+            return false;
+        }
+        addIdamError(error.type, error.location, error.code, error.msg);
+    }
+
+    return true;
+}
+
+} // anon namespace
+
+/**
+ * Test whether a request may be executed in a separate worker process concurrently with the other requests of the
+ * request block. Only requests served by external file or function plugins that allow their data to be cached are
+ * eligible: plugins that do not permit caching declare that their state depends on previous calls and device/server
+ * plugins share connections, so these are always executed in order within the server process.
+ */
+bool uda::Server::is_parallel_request(const RequestData& request) const
+{
+    if (request.put) {
+        return false;
+    }
+
+    auto maybe_plugin = plugins_.find_by_request(request.request);
+    if (!maybe_plugin) {
+        return false;
+    }
+
+    const PluginData& plugin = maybe_plugin.get();
+
+    return plugin.external == UDA_PLUGIN_EXTERNAL
+           && plugin.status == UDA_PLUGIN_OPERATIONAL
+           && plugin.cachePermission == UDA_PLUGIN_OK_TO_CACHE
+           && (plugin.plugin_class == UDA_PLUGIN_CLASS_FILE || plugin.plugin_class == UDA_PLUGIN_CLASS_FUNCTION);
+}
+
+/**
+ * Read the data for the listed requests into data_blocks_, which must already be sized to the request block.
+ *
+ * Independent requests are fanned out to at most request_workers_ concurrent worker processes, each a fork of the
+ * server holding the initialised plugins. A worker returns its error stack and data block through an XDR temporary
+ * file, written with the same serialisation as the data cache. All other requests, and any the workers could not
+ * return, are read in order by the server. The error of each request is set in errors, which is sized to the request
+ * block; the returned error is that of the last request, as when all are read sequentially.
+ */
+int uda::Server::get_data_blocks(const std::vector<int>& request_indices, int* depth, int protocol_version,
+                                 std::vector<int>& errors)
+{
+    errors.assign(request_block_.num_requests, 0);
+    std::vector<int> serial;
+    std::vector<int> parallel;
+
+    for (int index : request_indices) {
+        if (request_workers_ > 1 && !client_block_.get_meta && is_parallel_request(request_block_.requests[index])) {
+            parallel.push_back(index);
+        } else {
+            serial.push_back(index);
+        }
+    }
+
+    if (parallel.size() < 2) {
+        serial = request_indices;
+        parallel.clear();
+    }
+
+    std::deque<RequestWorker> running;
+    std::vector<int> fallback;
+
+    auto gather = [&]() {
+        RequestWorker worker = running.front();
+        running.pop_front();
+
+        int status = 0;
+        while (waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {}
+
+        bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        DATA_BLOCK* data_block = nullptr;
+        int err = 0;
+
+        if (ok) {
+            rewind(worker.result);
+            ok = fread(&err, sizeof(err), 1, worker.result) == 1 && read_worker_errors(worker.result);
+        }
+
+        if (ok) {
+            LOGSTRUCTLIST log_struct_list;
+            initLogStructList(&log_struct_list);
+            data_block = readCacheData(worker.result, log_malloc_list_, user_defined_type_list_, protocol_version,
+                                       &log_struct_list, 0, malloc_source_);
+            freeLogStructList(&log_struct_list);
+            ok = data_block != nullptr;
+        }
+
+        fclose(worker.result);
+
+        if (ok) {
+            data_blocks_[worker.index] = *data_block;
+            ::free(data_block);
+            errors[worker.index] = err;
+        } else {
+            UDA_LOG(UDA_LOG_DEBUG, "Request %d not returned by worker %d: reading in server\n", worker.index,
+                    (int)worker.pid);
+            fallback.push_back(worker.index);
+        }
+    };
+
+    for (int index : parallel) {
+        if (running.size() >= (size_t)request_workers_) {
+            gather();
+        }
+
+        FILE* result = tmpfile();
+        if (result == nullptr) {
+            fallback.push_back(index);
+            continue;
+        }
+
+        fflush(nullptr);
+        pid_t pid = fork();
+
+        if (pid == 0) {
+            // Worker: errors already on the stack belong to the server
+
+            closeUdaError();
+
+            int worker_depth = *depth;
+            DATA_BLOCK* data_block = &data_blocks_[index];
+            int err = get_data(&worker_depth, &request_block_.requests[index], data_block, protocol_version);
+
+            if (data_block->data_type == UDA_TYPE_COMPOUND || data_block->opaque_type != UDA_OPAQUE_TYPE_UNKNOWN) {
+                fflush(nullptr);
+                _exit(WorkerFallback);
+            }
+
+            fwrite(&err, sizeof(err), 1, result);
+            write_worker_errors(result);
+
+            LOGSTRUCTLIST log_struct_list;
+            initLogStructList(&log_struct_list);
+            writeCacheData(result, log_malloc_list_, user_defined_type_list_, data_block, protocol_version,
+                           &log_struct_list, 0, malloc_source_);
+
+            fflush(nullptr);
+            _exit(0);
+        } else if (pid < 0) {
+            fclose(result);
+            fallback.push_back(index);
+            continue;
+        }
+
+        UDA_LOG(UDA_LOG_DEBUG, "Request %d dispatched to worker %d\n", index, (int)pid);
+        running.push_back({ index, pid, result });
+    }
+
+    while (!running.empty()) {
+        gather();
+    }
+
+    serial.insert(serial.end(), fallback.begin(), fallback.end());
+    std::sort(serial.begin(), serial.end());
+
+    for (int index : serial) {
+        initDataBlock(&data_blocks_[index]);
+        errors[index] = get_data(depth, &request_block_.requests[index], &data_blocks_[index], protocol_version);
+    }
+
+    return request_indices.empty() ? 0 : errors[request_indices.back()];
+}
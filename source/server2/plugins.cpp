@@ -408,7 +408,9 @@ void uda::Plugins::init_serverside_functions()
 void uda::Plugins::close()
 {
     for (auto& plugin : plugins_) {
-        dlclose(plugin.pluginHandle);
+        if (plugin.pluginHandle != nullptr) {
+            dlclose(plugin.pluginHandle);
+        }
     }
     plugins_.clear();
 }
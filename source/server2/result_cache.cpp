@@ -0,0 +1,232 @@
+#include "result_cache.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include <clientserver/initStructs.h>
+#include <clientserver/udaTypes.h>
+#include <logging/logging.h>
+
+namespace {
+
+size_t array_size(int data_type, int64_t count)
+{
+    return count > 0 ? getSizeOf((UDA_TYPE)data_type) * (size_t)count : 0;
+}
+
+char* copy_array(const char* array, size_t size)
+{
+    if (array == nullptr || size == 0) {
+        return nullptr;
+    }
+    auto copy = (char*)malloc(size);
+    if (copy != nullptr) {
+        memcpy(copy, array, size);
+    }
+    return copy;
+}
+
+/**
+ * Number of elements in the domain arrays of a compressed dimension: method 3 holds a single offset and interval.
+ */
+unsigned int domain_count(const DIMS& dim)
+{
+    return dim.method == 3 ? 1 : dim.udoms;
+}
+
+/**
+ * Copy a data block and its data, error and dimension arrays into newly allocated heap, freed with freeDataBlock.
+ * Returns the number of array bytes copied.
+ */
+size_t copy_data_block(DATA_BLOCK* out, const DATA_BLOCK& in)
+{
+    *out = in;
+
+    size_t data_size = array_size(in.data_type, in.data_n);
+    size_t error_size = array_size(in.error_type, in.data_n);
+
+    out->data = copy_array(in.data, data_size);
+    out->errhi = copy_array(in.errhi, error_size);
+    out->errlo = copy_array(in.errlo, error_size);
+    out->synthetic = nullptr;
+
+    out->data_system = nullptr;
+    out->system_config = nullptr;
+    out->data_source = nullptr;
+    out->signal_rec = nullptr;
+    out->signal_desc = nullptr;
+    initClientBlock(&out->client_block, 0, "");
+
+    size_t size = data_size + (in.errhi != nullptr ? error_size : 0) + (in.errlo != nullptr ? error_size : 0);
+
+    if (in.dims == nullptr || in.rank == 0) {
+        out->dims = nullptr;
+        return size;
+    }
+
+    out->dims = (DIMS*)malloc(in.rank * sizeof(DIMS));
+
+    for (unsigned int i = 0; i < in.rank; ++i) {
+        const DIMS& dim = in.dims[i];
+        DIMS& copy = out->dims[i];
+        copy = dim;
+
+        size_t dim_size = array_size(dim.data_type, dim.dim_n);
+        size_t dim_error_size = array_size(dim.error_type, dim.dim_n);
+        size_t domain_size = array_size(dim.data_type, domain_count(dim));
+
+        copy.dim = copy_array(dim.dim, dim_size);
+        copy.errhi = copy_array(dim.errhi, dim_error_size);
+        copy.errlo = copy_array(dim.errlo, dim_error_size);
+        copy.synthetic = nullptr;
+        copy.sams = (int*)copy_array((const char*)dim.sams, domain_count(dim) * sizeof(int));
+        copy.offs = copy_array(dim.offs, domain_size);
+        copy.ints = copy_array(dim.ints, domain_size);
+
+        size += (dim.dim != nullptr ? dim_size : 0)
+                + (dim.errhi != nullptr ? dim_error_size : 0) + (dim.errlo != nullptr ? dim_error_size : 0);
+    }
+
+    return size;
+}
+
+} // anon namespace
+
+uda::server::ResultCache::~ResultCache()
+{
+    clear();
+}
+
+/**
+ * Set the maximum number of bytes of data held, zero disabling the cache, and the lifetime of each entry in seconds,
+ * zero for no expiry.
+ */
+void uda::server::ResultCache::configure(size_t capacity, time_t expiry)
+{
+    capacity_ = capacity;
+    expiry_ = expiry;
+
+    while (!entries_.empty() && size_ > capacity_) {
+        erase(std::prev(entries_.end()));
+        ++evictions_;
+    }
+}
+
+/**
+ * Test whether a data block holds only atomic arrays of known size, so that it can be copied into the cache.
+ */
+bool uda::server::ResultCache::is_cacheable(const DATA_BLOCK& data_block)
+{
+    if (data_block.data_type == UDA_TYPE_COMPOUND || data_block.opaque_type != UDA_OPAQUE_TYPE_UNKNOWN) {
+        return false;
+    }
+
+    if (data_block.data_n > 0 && getSizeOf((UDA_TYPE)data_block.data_type) == 0) {
+        return false;
+    }
+
+    if ((data_block.errhi != nullptr || data_block.errlo != nullptr)
+            && getSizeOf((UDA_TYPE)data_block.error_type) == 0) {
+        return false;
+    }
+
+    for (unsigned int i = 0; data_block.dims != nullptr && i < data_block.rank; ++i) {
+        const DIMS& dim = data_block.dims[i];
+        if (getSizeOf((UDA_TYPE)dim.data_type) == 0) {
+            return false;
+        }
+        if ((dim.errhi != nullptr || dim.errlo != nullptr) && getSizeOf((UDA_TYPE)dim.error_type) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Copy the data block cached for the key into data_block, returning false if the key is not cached or has expired.
+ */
+bool uda::server::ResultCache::get(const std::string& key, DATA_BLOCK* data_block)
+{
+    if (!enabled() || key.empty()) {
+        return false;
+    }
+
+    auto found = index_.find(key);
+    if (found == index_.end()) {
+        ++misses_;
+        return false;
+    }
+
+    auto entry = found->second;
+
+    if (entry->expires > 0 && time(nullptr) > entry->expires) {
+        UDA_LOG(UDA_LOG_DEBUG, "Result cache entry expired: %s\n", key.c_str());
+        erase(entry);
+        ++misses_;
+        return false;
+    }
+
+    entries_.splice(entries_.begin(), entries_, entry);
+    copy_data_block(data_block, entry->data_block);
+    ++hits_;
+
+    UDA_LOG(UDA_LOG_DEBUG, "Result cache hit: %s\n", key.c_str());
+
+    return true;
+}
+
+/**
+ * Cache a copy of the data block under the key, evicting the least recently used entries to make room. Data blocks
+ * larger than the whole cache are not held.
+ */
+void uda::server::ResultCache::put(const std::string& key, const DATA_BLOCK& data_block)
+{
+    if (!enabled() || key.empty() || !is_cacheable(data_block)) {
+        return;
+    }
+
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+        erase(found->second);
+    }
+
+    Entry entry = { key, {}, 0, expiry_ > 0 ? time(nullptr) + expiry_ : 0 };
+    entry.size = copy_data_block(&entry.data_block, data_block);
+
+    if (entry.size > capacity_) {
+        freeDataBlock(&entry.data_block);
+        return;
+    }
+
+    while (!entries_.empty() && size_ + entry.size > capacity_) {
+        UDA_LOG(UDA_LOG_DEBUG, "Result cache eviction: %s\n", entries_.back().key.c_str());
+        erase(std::prev(entries_.end()));
+        ++evictions_;
+    }
+
+    size_ += entry.size;
+    entries_.push_front(std::move(entry));
+    index_[key] = entries_.begin();
+}
+
+void uda::server::ResultCache::clear()
+{
+    while (!entries_.empty()) {
+        erase(entries_.begin());
+    }
+}
+
+void uda::server::ResultCache::print_stats() const
+{
+    UDA_LOG(UDA_LOG_INFO, "Result cache: %zu entries, %zu of %zu bytes, %zu hits, %zu misses, %zu evictions\n",
+            entries_.size(), size_, capacity_, hits_, misses_, evictions_);
+}
+
+void uda::server::ResultCache::erase(EntryList::iterator entry)
+{
+    size_ -= entry->size;
+    freeDataBlock(&entry->data_block);
+    index_.erase(entry->key);
+    entries_.erase(entry);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef UDA_SERVER_RESULT_CACHE_HPP
+#define UDA_SERVER_RESULT_CACHE_HPP
+
+#include <ctime>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include <clientserver/udaStructs.h>
+
+namespace uda {
+namespace server {
+
+/**
+ * In-process cache of the decoded data blocks returned for previous requests, held by each server worker so that
+ * repeated requests are served from memory without calling the plugins again.
+ *
+ * Entries are keyed by the normalised request (see cache::generate_cache_key) and bounded by the total size of the
+ * data arrays they hold: the least recently used entries are evicted when a new entry would exceed the capacity.
+ * Only atomic data blocks are held - compound and opaque data reference heap owned by the request.
+ */
+class ResultCache
+{
+public:
+    ResultCache() = default;
+    ~ResultCache();
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    void configure(size_t capacity, time_t expiry);
+
+    [[nodiscard]] bool enabled() const { return capacity_ > 0; }
+    [[nodiscard]] static bool is_cacheable(const DATA_BLOCK& data_block);
+
+    bool get(const std::string& key, DATA_BLOCK* data_block);
+    void put(const std::string& key, const DATA_BLOCK& data_block);
+    void clear();
+    void print_stats() const;
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] size_t hits() const { return hits_; }
+    [[nodiscard]] size_t misses() const { return misses_; }
+    [[nodiscard]] size_t evictions() const { return evictions_; }
+
+private:
+    struct Entry {
+        std::string key;
+        DATA_BLOCK data_block;
+        size_t size;
+        time_t expires;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void erase(EntryList::iterator entry);
+
+    EntryList entries_;         // Most recently used first
+    std::unordered_map<std::string, EntryList::iterator> index_;
+    size_t capacity_ = 0;
+    time_t expiry_ = 0;
+    size_t size_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    size_t evictions_ = 0;
+};
+
+} // namespace server
+} // namespace uda
+
+#endif // UDA_SERVER_RESULT_CACHE_HPP
@@ -1,7 +1,13 @@
 #include "server.hpp"
 
+#include <algorithm>
+#include <csignal>
 #include <string>
 #include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
 #include <fmt/format.h>
 
 #include "clientserver/initStructs.h"
@@ -21,6 +27,9 @@
 #  include "authentication/udaServerSSL.h"
 #endif
 
+// Default lifetime of an entry in the in-process result cache (secs)
+constexpr time_t DefaultResultCacheExpiry = 86400;
+
 void free_data_blocks(std::vector<DataBlock>& data_blocks)
 {
     for (auto& data_block : data_blocks) {
@@ -131,10 +140,6 @@ void uda::Server::startup()
 
     UDA_LOG(UDA_LOG_DEBUG, "New Server Instance\n");
 
-    //-------------------------------------------------------------------------
-    // Create the XDR Record Streams
-    protocol_.create();
-
     //-------------------------------------------------------------------------
     // Initialise the plugins
     plugins_.init();
@@ -155,15 +160,318 @@ void uda::Server::startup()
     if ((env = getenv("UDA_SERVER_DOI")) != nullptr) {
         strcpy(server_block_.DOI, env);
     }
+
+    // Maximum number of worker processes reading the requests of a request block concurrently
+
+    if ((env = getenv("UDA_SERVER_REQUEST_WORKERS")) != nullptr && atoi(env) > 0) {
+        request_workers_ = atoi(env);
+    }
+
+    // In-process cache of the data returned for repeated requests: capacity in MB (disabled by default) and the
+    // lifetime of each entry in seconds
+
+    size_t result_cache_size = 0;
+    time_t result_cache_expiry = DefaultResultCacheExpiry;
+
+    if ((env = getenv("UDA_SERVER_RESULT_CACHE_SIZE")) != nullptr && atoi(env) > 0) {
+        result_cache_size = (size_t)atoi(env) * 1024 * 1024;
+    }
+
+    if ((env = getenv("UDA_SERVER_RESULT_CACHE_EXPIRY")) != nullptr && atoi(env) >= 0) {
+        result_cache_expiry = (time_t)atoi(env);
+    }
+
+    result_cache_.configure(result_cache_size, result_cache_expiry);
+
+    // Requests may modify the environment (e.g. external user) so keep a copy to restore for each new session
+
+    startup_environment_ = environment_;
 }
 
 void uda::Server::run()
 {
     startup();
+    session(STDIN_FILENO);
+    close();
+}
+
+void uda::Server::session(int socket)
+{
+    //-------------------------------------------------------------------------
+    // Reset the per-client state: plugins, logs and configuration remain initialised
+
+    environment_ = startup_environment_;
+    server_closedown_ = false;
+    fatal_error_ = false;
+    server_timeout_ = TIMEOUT;
+    server_tot_block_time_ = 0;
+    initServerBlock(&server_block_, ServerVersion);
+    initRequestBlock(&request_block_);
+
+    //-------------------------------------------------------------------------
+    // Create the XDR Record Streams
+
+    protocol_.set_socket(socket);
+    protocol_.set_version(ServerVersion);
+    protocol_.set_native_data(false);
+    protocol_.set_stream_data(false);
+    protocol_.set_compress_data(false);
+    protocol_.set_buffer_sizes(environment_->xdr_buffer_size, environment_->xdr_buffer_max);
+    protocol_.create();
+
     handshake_client();
     if (!server_closedown_) {
         loop();
     }
+}
+
+void uda::Server::end_session()
+{
+    //----------------------------------------------------------------------------
+    // Write the Error Log Record & Free Error Stack Heap
+
+    udaErrorLog(client_block_, request_block_, nullptr);
+    closeUdaError();
+
+    free_data_blocks(data_blocks_);
+    close_sockets(sockets_);
+
+    if (result_cache_.enabled()) {
+        result_cache_.print_stats();
+    }
+
+    // A CLOSEDOWN request leaves the wait loop before the per-request heap is freed
+
+    if (user_defined_type_list_ != nullptr) {
+        freeUserDefinedTypeList(user_defined_type_list_);
+        user_defined_type_list_ = nullptr;
+    }
+
+    if (log_malloc_list_ != nullptr) {
+        freeMallocLogList(log_malloc_list_);
+        ::free(log_malloc_list_);
+        log_malloc_list_ = nullptr;
+    }
+
+    fflush(nullptr);
+}
+
+namespace {
+
+volatile sig_atomic_t g_server_shutdown = 0;
+
+// Bounds of a worker's wait between attempts to accept while out of descriptors or memory (microseconds)
+constexpr useconds_t AcceptRetryMin = 10000;
+constexpr useconds_t AcceptRetryMax = 1000000;
+
+/**
+ * Corks the protocol for the lifetime of a response, and uncorks it on every way out: a response abandoned on an
+ * error must not leave its segments held back, nor the socket corked for the next response.
+ */
+class CorkedResponse
+{
+public:
+    explicit CorkedResponse(uda::XdrProtocol& protocol)
+        : protocol_(protocol)
+    {
+        protocol_.cork();
+    }
+
+    ~CorkedResponse()
+    {
+        protocol_.uncork();
+    }
+
+    CorkedResponse(const CorkedResponse&) = delete;
+    CorkedResponse& operator=(const CorkedResponse&) = delete;
+
+private:
+    uda::XdrProtocol& protocol_;
+};
+
+void server_shutdown_handler(int)
+{
+    g_server_shutdown = 1;
+}
+
+int open_listening_socket(int port)
+{
+    int listen_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_socket < 0) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "");
+        throw uda::server::StartupException("Failed to create listening socket");
+    }
+
+    int on = 1;
+    setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+
+    if (bind(listen_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+            || listen(listen_socket, SOMAXCONN) < 0) {
+        addIdamError(UDA_SYSTEM_ERROR_TYPE, __func__, errno, "");
+        ::close(listen_socket);
+        throw uda::server::StartupException("Failed to bind listening socket");
+    }
+
+    return listen_socket;
+}
+
+} // anon namespace
+
+/**
+ * Key of the request in the in-process result cache, or an empty key if the data may not be cached.
+ *
+ * The data are cached only for get requests, without metadata, served by plugins that permit caching. The key
+ * extends the normalised signal and source with the request fields and client properties that change the data read.
+ */
+std::string uda::Server::result_cache_key(const RequestData& request) const
+{
+    if (!result_cache_.enabled() || request.put || client_block_.get_meta) {
+        return {};
+    }
+
+    auto maybe_plugin = plugins_.find_by_request(request.request);
+    if (!maybe_plugin || maybe_plugin.get().cachePermission != UDA_PLUGIN_OK_TO_CACHE) {
+        return {};
+    }
+
+    auto key = cache::generate_cache_key(&request, *environment_.p_env(), CLIENTFLAG_CACHE,
+                                         client_block_.privateFlags);
+
+    return fmt::format("{}&&{}&&{}&&{}&&{}&&{}{}{}{}{}&&{}", key, request.request, request.archive, request.device_name,
+                       request.subset, client_block_.get_asis, client_block_.get_uncal, client_block_.get_notoff,
+                       client_block_.get_bad, client_block_.get_bytes, client_block_.altRank);
+}
+
+void uda::Server::worker(int listen_socket)
+{
+    // Workers die with the parent's SIGTERM and survive clients disconnecting mid-write
+
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGPIPE, SIG_IGN);
+
+    useconds_t retry_delay = AcceptRetryMin;
+
+    while (true) {
+        int client_socket = accept(listen_socket, nullptr, nullptr);
+        if (client_socket < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // Out of descriptors or memory: exiting would only have the parent fork a replacement that fails the
+                // same way, so wait, backing off, for resources to be released
+                UDA_LOG(UDA_LOG_WARN, "Server worker accept failed, retrying: %s\n", strerror(errno));
+                usleep(retry_delay);
+                retry_delay = std::min(2 * retry_delay, AcceptRetryMax);
+                continue;
+            }
+            UDA_LOG(UDA_LOG_ERROR, "Server worker accept failed: %s\n", strerror(errno));
+            break;
+        }
+        retry_delay = AcceptRetryMin;
+
+        int on = 1;
+        setsockopt(client_socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        setsockopt(client_socket, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+
+        int window_size = environment_->socket_buffer_size;
+        if (window_size > 0) {
+            setsockopt(client_socket, SOL_SOCKET, SO_SNDBUF, &window_size, sizeof(window_size));
+            setsockopt(client_socket, SOL_SOCKET, SO_RCVBUF, &window_size, sizeof(window_size));
+        }
+
+        UDA_LOG(UDA_LOG_DEBUG, "Server worker %d accepted client connection\n", (int)getpid());
+
+        try {
+            session(client_socket);
+        } catch (uda::server::Exception& ex) {
+            UDA_LOG(UDA_LOG_ERROR, "Client session terminated: %s\n", ex.what());
+        }
+
+        end_session();
+        ::close(client_socket);
+    }
+}
+
+void uda::Server::serve(int port, int num_workers)
+{
+    startup();
+
+    int listen_socket = open_listening_socket(port);
+
+    UDA_LOG(UDA_LOG_INFO, "Server listening on port %d with %d workers\n", port, num_workers);
+
+    struct sigaction action = {};
+    action.sa_handler = server_shutdown_handler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGINT, &action, nullptr);
+
+    //-------------------------------------------------------------------------
+    // Pre-fork the workers: each inherits the initialised plugins and configuration and serves client sessions
+    // accepted on the shared listening socket until it dies, when it is replaced
+
+    std::vector<pid_t> workers;
+
+    auto spawn_worker = [&]() {
+        fflush(nullptr);
+        pid_t pid = fork();
+        if (pid == 0) {
+            worker(listen_socket);
+            close();
+            _exit(0);
+        } else if (pid < 0) {
+            UDA_LOG(UDA_LOG_ERROR, "Failed to fork server worker: %s\n", strerror(errno));
+        } else {
+            workers.push_back(pid);
+        }
+    };
+
+    for (int i = 0; i < num_workers; ++i) {
+        spawn_worker();
+    }
+
+    time_t last_respawn = 0;
+
+    while (!g_server_shutdown) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        workers.erase(std::remove(workers.begin(), workers.end(), pid), workers.end());
+        if (!g_server_shutdown) {
+            UDA_LOG(UDA_LOG_WARN, "Server worker %d exited (status %d): respawning\n", (int)pid, status);
+            if (time(nullptr) - last_respawn < 1) {
+                // Workers are dying as fast as they are started: limit the respawn rate rather than fork in a loop
+                sleep(1);
+            }
+            last_respawn = time(nullptr);
+            if (!g_server_shutdown) {
+                spawn_worker();
+            }
+        }
+    }
+
+    UDA_LOG(UDA_LOG_INFO, "Server shutting down workers\n");
+
+    for (auto pid : workers) {
+        kill(pid, SIGTERM);
+    }
+    for (auto pid : workers) {
+        waitpid(pid, nullptr, 0);
+    }
+
+    ::close(listen_socket);
     close();
 }
 
@@ -338,6 +646,9 @@ int uda::Server::handle_request()
         protocol_version = client_block_.version;
     }
     protocol_.set_version(protocol_version);
+    protocol_.set_native_data(clientFlags & CLIENTFLAG_NATIVEDATA);
+    protocol_.set_stream_data(clientFlags & CLIENTFLAG_STREAMDATA);
+    protocol_.set_compress_data(clientFlags & CLIENTFLAG_COMPRESSDATA);
 
     // The client request may originate from a server.
     // Is the Originating server an externally facing server? If so then switch to this mode: preserve local access policy
@@ -609,21 +920,39 @@ int uda::Server::handle_request()
 
     int depth = 0;
 
+    data_blocks_.resize(request_block_.num_requests);
+    std::vector<int> uncached;
+
+    std::vector<std::string> result_keys(request_block_.num_requests);
+
     for (int i = 0; i < request_block_.num_requests; ++i) {
         auto request = &request_block_.requests[i];
 
+        result_keys[i] = result_cache_key(*request);
+        if (result_cache_.get(result_keys[i], &data_blocks_[i])) {
+            continue;
+        }
+
         auto cache_block = protocol_.read_from_cache(cache_, request, environment_, log_malloc_list_, user_defined_type_list_);
         if (cache_block != nullptr) {
-            data_blocks_.push_back(*cache_block);
+            data_blocks_[i] = *cache_block;
+            result_cache_.put(result_keys[i], data_blocks_[i]);
             continue;
         }
 
-        data_blocks_.push_back({});
-        DATA_BLOCK* data_block = &data_blocks_.back();
+        initDataBlock(&data_blocks_[i]);
+        uncached.push_back(i);
+    }
 
-        err = get_data(&depth, request, data_block, protocol_version);
+    std::vector<int> errors;
+    err = get_data_blocks(uncached, &depth, protocol_version, errors);
 
-        protocol_.write_to_cache(cache_, request, environment_, data_block, log_malloc_list_, user_defined_type_list_);
+    for (int i : uncached) {
+        protocol_.write_to_cache(cache_, &request_block_.requests[i], environment_, &data_blocks_[i], log_malloc_list_,
+                                 user_defined_type_list_);
+        if (errors[i] == 0) {       // A failed request must not be served from the cache as a success
+            result_cache_.put(result_keys[i], data_blocks_[i]);
+        }
     }
 
     for (int i = 0; i < request_block_.num_requests; ++i) {
@@ -702,9 +1031,9 @@ int uda::Server::handle_request()
     return err;
 }
 
-unsigned int count_data_block_list_size(const std::vector<DataBlock>& data_blocks, ClientBlock* client_block)
+size_t count_data_block_list_size(const std::vector<DataBlock>& data_blocks, ClientBlock* client_block)
 {
-    unsigned int total = 0;
+    size_t total = 0;
     for (const auto& data_block : data_blocks) {
         total += countDataBlockSize(&data_block, client_block);
     }
@@ -749,6 +1078,7 @@ int uda::Server::report_to_client()
     //------------------------------------------------------------------------------------------------
     // Send the server block and all data in a single (minimal number) tcp packet
 
+    CorkedResponse corked_response(protocol_);
     err = protocol_.send_server_block(server_block_, log_malloc_list_, user_defined_type_list_);
 
     if (server_block_.idamerrorstack.nerrors > 0) {
@@ -793,15 +1123,21 @@ int uda::Server::report_to_client()
     protocol_.flush();
 
     //------------------------------------------------------------------------------
-    // Legacy Hierarchical Data Structures
+    // Streamed Data Arrays and Legacy Hierarchical Data Structures, in data block order
 
     for (const auto& data_block : data_blocks_) {
+        err = protocol_.send_data_stream(data_block, log_malloc_list_, user_defined_type_list_);
+        if (err != 0) {
+            return err;
+        }
         err = protocol_.send_hierachical_data(data_block, log_malloc_list_, user_defined_type_list_);
         if (err != 0) {
             return err;
         }
     }
 
+    protocol_.adapt_output_buffer(total_datablock_size_);
+
     return err;
 }
 
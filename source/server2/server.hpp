@@ -9,6 +9,7 @@
 #include "plugins.hpp"
 #include "get_data.hpp"
 #include "server_environment.hpp"
+#include "result_cache.hpp"
 
 #include "clientserver/parseXML.h"
 #include "clientserver/socketStructs.h"
@@ -26,21 +27,29 @@ struct MetadataBlock {
 
 class Server {
 public:
-    constexpr static int ServerVersion = 8;
+    constexpr static int ServerVersion = 11;
     constexpr static int LegacyServerVersion = 6;
 
     Server();
     void run();
+    void serve(int port, int num_workers);
     void close();
 
 private:
     void startup();
+    void session(int socket);
+    void end_session();
+    void worker(int listen_socket);
     void loop();
     int handle_request();
     int report_to_client();
     void handshake_client();
     void start_logs();
     int get_data(int* depth, RequestData* request_data, DataBlock* data_block, int protocol_version);
+    int get_data_blocks(const std::vector<int>& request_indices, int* depth, int protocol_version,
+                        std::vector<int>& errors);
+    [[nodiscard]] bool is_parallel_request(const RequestData& request) const;
+    [[nodiscard]] std::string result_cache_key(const RequestData& request) const;
     int read_data(RequestData* request, DATA_BLOCK* data_block);
 
     std::vector<UDA_ERROR> error_stack_;
@@ -50,7 +59,9 @@ private:
     Actions actions_desc_;
     Actions actions_sig_;
     cache::UdaCache* cache_;
+    server::ResultCache result_cache_;
     server::Environment environment_;
+    server::Environment startup_environment_;
     XdrProtocol protocol_;
     std::vector<Sockets> sockets_;
     Plugins plugins_;
@@ -60,6 +71,7 @@ private:
     size_t total_datablock_size_;
     MetadataBlock metadata_block_;
     int server_timeout_ = TIMEOUT;
+    int request_workers_ = 1;
     int server_tot_block_time_;
     bool fatal_error_ = false;
     LogMallocList* log_malloc_list_ = nullptr;
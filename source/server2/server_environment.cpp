@@ -5,6 +5,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <logging/logging.h>
+#include <clientserver/udaDefines.h>
 
 void uda::server::Environment::print()
 {
@@ -17,6 +18,8 @@ void uda::server::Environment::print()
     UDA_LOG(UDA_LOG_INFO, "UDA This Host   : %s\n", environment_.server_this);
     UDA_LOG(UDA_LOG_INFO, "Private File Path Target    : %s\n", environment_.private_path_target);
     UDA_LOG(UDA_LOG_INFO, "Private File Path Substitute: %s\n", environment_.private_path_substitute);
+    UDA_LOG(UDA_LOG_INFO, "XDR Buffer Size : %d (max %d)\n", environment_.xdr_buffer_size, environment_.xdr_buffer_max);
+    UDA_LOG(UDA_LOG_INFO, "Socket Buffer   : %d\n", environment_.socket_buffer_size);
 }
 
 uda::server::Environment::Environment()
@@ -131,5 +134,26 @@ uda::server::Environment::Environment()
         environment_.private_path_substitute[0] = '\0';
     }
 
+    //-------------------------------------------------------------------------------------------
+    // XDR record stream and socket buffer sizes (bytes)
+
+    environment_.xdr_buffer_size = DB_READ_BLOCK_SIZE;
+    if ((env = getenv("UDA_XDR_BUFFER_SIZE")) != nullptr && atoi(env) > 0) {
+        environment_.xdr_buffer_size = atoi(env);
+    }
+
+    environment_.xdr_buffer_max = DB_MAX_BLOCK_SIZE;
+    if ((env = getenv("UDA_XDR_BUFFER_MAX")) != nullptr && atoi(env) > 0) {
+        environment_.xdr_buffer_max = atoi(env);
+    }
+    if (environment_.xdr_buffer_max < environment_.xdr_buffer_size) {
+        environment_.xdr_buffer_max = environment_.xdr_buffer_size;
+    }
+
+    environment_.socket_buffer_size = 0;
+    if ((env = getenv("UDA_SOCKET_BUFFER_SIZE")) != nullptr) {
+        environment_.socket_buffer_size = atoi(env);
+    }
+
     environment_.initialised = 1;
 }
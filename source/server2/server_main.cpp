@@ -9,6 +9,8 @@
 #include "server.hpp"
 #include "server_exceptions.h"
 
+constexpr int DefaultServerWorkers = 8;
+
 int main()
 {
     // Optional sleep at startup
@@ -18,11 +20,28 @@ int main()
         sleep((unsigned int)atoi(env));
     }
 
+    // Daemon mode: listen on a port and serve many clients from warm worker processes rather than
+    // serving a single client over stdin/stdout (xinetd)
+
+    int listen_port = 0;
+    if ((env = getenv("UDA_SERVER_LISTEN_PORT")) != nullptr) {
+        listen_port = atoi(env);
+    }
+
+    int num_workers = DefaultServerWorkers;
+    if ((env = getenv("UDA_SERVER_WORKERS")) != nullptr && atoi(env) > 0) {
+        num_workers = atoi(env);
+    }
+
     // Run server
 
     try {
         uda::Server server;
-        server.run();
+        if (listen_port > 0) {
+            server.serve(listen_port, num_workers);
+        } else {
+            server.run();
+        }
     } catch (uda::server::Exception& ex) {
         return ex.code();
     }
@@ -11,6 +11,10 @@
 #include <math.h>
 #include <float.h>
 #include <cerrno>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
 #if defined(__GNUC__)
 #  include <strings.h>
 #else
@@ -25,6 +29,7 @@
 #include <clientserver/initStructs.h>
 #include <clientserver/compressDim.h>
 #include <clientserver/stringUtils.h>
+#include <clientserver/subsetArray.h>
 
 //----------------------------------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------------------------------
@@ -48,13 +53,17 @@ namespace {
 
 int serverSubsetIndices(char* operation, DIMS* dim, double value, unsigned int* subsetindices);
 
-int serverNewDataArray2(DIMS* dims, int rank, int dimid,
-                               char* data, int ndata, int data_type, int notoperation, int reverse,
-                               int start, int end, int start1, int end1, int* n, void** newdata);
+bool serverSubsetRange(const char* operation, const DIMS* dim, double value, int* start, int* end);
+
+using Selection = uda::SubsetSelection;
+
+int serverSubsetArray(const std::vector<Selection>& selections, const char* data, int data_type, int64_t* n,
+                      char** newdata, const std::vector<uda::Calibration>* calibrations = nullptr);
 
 } // anon namespace
 
-int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST* logmalloclist)
+int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST* logmalloclist,
+                          DeferredCalibrations* deferred)
 {
     DIMS* dim;
     DIMS newdim;
@@ -62,7 +71,8 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
     char* operation;
 
     char* newdata, * newerrhi, * newerrlo;
-    int nsubsets, nbound, dimid, start, end, start1, end1, dim_n, ndata, n, reshape, reverse, notoperation, ierr = 0;
+    int nsubsets, nbound, dimid, start, end, start1, end1, stride, dim_n, reshape, reverse, notoperation, ierr = 0;
+    int64_t ndata, n;
 
     printAction(action);
     printDataBlock(*data_block);
@@ -87,11 +97,11 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
     }
 
     //-----------------------------------------------------------------------------------------------------------------------
-    // Check Rank
+    // Check Rank: any rank may be subset but the functions are limited to rank 2 or less
 
-    if (data_block->rank > 2 &&
-        !(action.actionType == UDA_SUBSET_TYPE && !strncasecmp(action.subset.function, "rotateRZ", 8))) {
-        UDA_THROW_ERROR(9999, "Not Configured to Subset Data with Rank Higher than 2");
+    if (data_block->rank > 2 && action.actionType == UDA_SUBSET_TYPE && action.subset.function[0] != '\0'
+        && strncasecmp(action.subset.function, "rotateRZ", 8) != 0) {
+        UDA_THROW_ERROR(9999, "Not Configured to Apply Functions to Data with Rank Higher than 2");
     }
 
     //-----------------------------------------------------------------------------------------------------------------------
@@ -99,6 +109,8 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
 
     for (int i = 0; i < nsubsets; i++) {                        // the number of sets of Subset Operations
 
+        std::vector<Selection> selections;                      // Indices selected along each dimension of the data
+
         if (action.actionType == UDA_COMPOSITE_TYPE) {
             subset = action.composite.subsets[i];                // the set of Subset Operations
         } else {
@@ -402,35 +414,10 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
                 continue;    // subset spans the complete dimension
             }
 
-            //----------------------------------------------------------------------------------------------------------------------------
-            // Decompress the dimensional data if necessary & free Heap Associated with Compression
-
             initDimBlock(&newdim);                    // Holder for the Subsetted Dimension (part copy of the original)
 
             dim = &(data_block->dims[dimid]);                // the original dimension to be subset
 
-            if (dim->compressed) {
-                uncompressDim(dim);
-                dim->compressed = 0;                    // Can't preserve this status after the subset has been applied
-                dim->method = 0;
-
-                if (dim->sams != nullptr) free(dim->sams);
-                if (dim->offs != nullptr) free(dim->offs);
-                if (dim->ints != nullptr) free(dim->ints);
-
-                dim->udoms = 0;
-                dim->sams = nullptr;        // Avoid double freeing of Heap
-                dim->offs = nullptr;
-                dim->ints = nullptr;
-            }
-
-            //----------------------------------------------------------------------------------------------------------------------------
-            // Copy all existing Dimension Information to working structure
-
-            newdim = *dim;
-            newdim.dim_n = 0;
-            newdim.dim = nullptr;
-
             //----------------------------------------------------------------------------------------------------------------------------
             // Subset Operations: Identify subset indicies
 
@@ -440,6 +427,7 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
             end = -1;                    // Ending Index
             start1 = -1;
             end1 = -1;
+            stride = 1;
 
             // Test for Array Reshaping Operations
 
@@ -457,6 +445,7 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
                 if (start == -1) start = 0;
                 if (start == -2) start = dim->dim_n - 1;    // Final array element requested
                 if (end == -1) end = dim->dim_n - 1;
+                if (subset.stride[j].init) stride = (int)subset.stride[j].value;
 
                 if (start > end) {                // Check Ordering (Allow for Reversing?)
                     int startcpy = start;
@@ -464,28 +453,73 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
                     start = end;        // Swap indices
                     end = startcpy;
                 }
+                if (start < 0 || end >= dim->dim_n) {
+                    UDA_THROW_ERROR(9999, "The Index Range is outside the Dimension: Unable to Subset");
+                }
+                if (stride < 1) {
+                    UDA_THROW_ERROR(9999, "The Index Stride must be Positive: Unable to Subset");
+                }
                 reshape = 1;
-                dim_n = end - start + 1;
             }
 
             if (operation[0] == '#') {            // Reshape Operation - Highest array position (last value)
                 start = dim->dim_n - 1;
                 end = dim->dim_n - 1;
                 reshape = 1;
-                dim_n = 1;
             }
 
+            if (STR_EQUALS(operation, "!<")) strcpy(operation, ">=");
+            if (STR_EQUALS(operation, "!>")) strcpy(operation, "<=");
+            if (STR_EQUALS(operation, "!<=")) strcpy(operation, ">");
+            if (STR_EQUALS(operation, "!>=")) strcpy(operation, "<");
+
+            // Monotonic dimensions: locate the single range by binary search, compressed dimensions are not decompressed
+
+            bool ranged = false;
+
+            if (!reshape && !notoperation && serverSubsetRange(operation, dim, value, &start, &end)) {
+                if (end < start) {
+                    UDA_THROW_ERROR(9999, "No Data were found that satisfies a subset");
+                }
+                ranged = true;
+                dim_n = end - start + 1;
+            }
+
+            // A regular dimension remains compressed after a single contiguous range is selected
+
+            bool keep_compressed = dim->compressed && dim->method == 0 && (reshape || ranged) && !notoperation;
+
+            //----------------------------------------------------------------------------------------------------------------------------
+            // Decompress the dimensional data if necessary & free Heap Associated with Compression
+
+            if (dim->compressed && !keep_compressed) {
+                uncompressDim(dim);
+                dim->compressed = 0;                    // Can't preserve this status after the subset has been applied
+                dim->method = 0;
+
+                if (dim->sams != nullptr) free(dim->sams);
+                if (dim->offs != nullptr) free(dim->offs);
+                if (dim->ints != nullptr) free(dim->ints);
+
+                dim->udoms = 0;
+                dim->sams = nullptr;        // Avoid double freeing of Heap
+                dim->offs = nullptr;
+                dim->ints = nullptr;
+            }
+
+            //----------------------------------------------------------------------------------------------------------------------------
+            // Copy all existing Dimension Information to working structure
+
+            newdim = *dim;
+            newdim.dim_n = 0;
+            newdim.dim = nullptr;
+
             // Create an Array of Indices satisfying the criteria
 
-            if (!reshape) {
+            if (!reshape && !ranged) {
 
                 auto subsetindices = (unsigned int*)malloc(dim->dim_n * sizeof(unsigned int));
 
-                if (STR_EQUALS(operation, "!<")) strcpy(operation, ">=");
-                if (STR_EQUALS(operation, "!>")) strcpy(operation, "<=");
-                if (STR_EQUALS(operation, "!<=")) strcpy(operation, ">");
-                if (STR_EQUALS(operation, "!>=")) strcpy(operation, "<");
-
                 if ((dim_n = serverSubsetIndices(operation, dim, value, subsetindices)) == 0) {
                     free(subsetindices);
                     UDA_THROW_ERROR(9999, "No Data were found that satisfies a subset");
@@ -524,6 +558,21 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
                 free(subsetindices);
             }
 
+            // Indices selected along the dimension: inclusive range(s), reversed if requested, with the index stride
+
+            std::vector<int> indices;
+
+            bool range2 = notoperation && start1 >= 0;      // A NOT operation may have found a second range
+
+            if (!reverse) {
+                for (int k = start; k <= end; k += stride) indices.push_back(k);
+                if (range2) for (int k = start1; k <= end1; k++) indices.push_back(k);
+            } else {
+                if (range2) for (int k = end1; k >= start1; k--) indices.push_back(k);
+                for (int k = end; k >= start; k -= stride) indices.push_back(k);
+            }
+
+            dim_n = (int)indices.size();
             newdim.dim_n = dim_n;
 
             //----------------------------------------------------------------------------------------------------------------------------
@@ -534,61 +583,50 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
             UDA_LOG(UDA_LOG_DEBUG, "\n\n\n*** dim->errhi != nullptr: %d\n\n\n", dim->errhi != nullptr);
             UDA_LOG(UDA_LOG_DEBUG, "\n\n\n*** dim->errlo != nullptr: %d\n\n\n", dim->errlo != nullptr);
 
-            if ((ierr = serverNewDataArray2(dim, 1, dimid, dim->dim, dim_n, dim->data_type, notoperation, reverse,
-                                            start, end, start1, end1, &n, (void**)&newdim.dim)) != 0) {
+            std::vector<Selection> dim_selection = { { dim->dim_n, false, indices } };
+
+            if (keep_compressed) {
+                newdim.dim0 = dim->dim0 + indices[0] * dim->diff;
+                newdim.diff = dim_n > 1 ? (indices[1] - indices[0]) * dim->diff : dim->diff;
+            } else if ((ierr = serverSubsetArray(dim_selection, dim->dim, dim->data_type, &n, &newdim.dim)) != 0) {
                 return ierr;
             }
 
             if (dim->errhi != nullptr && dim->error_type != UDA_TYPE_UNKNOWN) {
-                if ((ierr = serverNewDataArray2(dim, 1, dimid, dim->errhi, dim_n, dim->error_type, notoperation,
-                                                reverse,
-                                                start, end, start1, end1, &n, (void**)&newdim.errhi)) != 0)
+                if ((ierr = serverSubsetArray(dim_selection, dim->errhi, dim->error_type, &n, &newdim.errhi)) != 0) {
                     return ierr;
+                }
             }
 
             if (dim->errlo != nullptr && dim->error_type != UDA_TYPE_UNKNOWN) {
-                if ((ierr = serverNewDataArray2(dim, 1, dimid, dim->errlo, dim_n, dim->error_type, notoperation,
-                                                reverse,
-                                                start, end, start1, end1, &n, (void**)&newdim.errlo)) != 0)
+                if ((ierr = serverSubsetArray(dim_selection, dim->errlo, dim->error_type, &n, &newdim.errlo)) != 0) {
                     return ierr;
+                }
             }
 
             //-----------------------------------------------------------------------------------------------------------------------
-            // Reshape and Save the Subsetted Data
-
-            printDataBlock(*data_block);
+            // Record the selection: the data are subset once all operations in the set have been processed. A further
+            // operation on an already subsetted dimension selects from the previous selection.
 
-            if ((ierr = serverNewDataArray2(data_block->dims, data_block->rank, dimid, data_block->data,
-                                            data_block->data_n, data_block->data_type, notoperation, reverse,
-                                            start, end, start1, end1, &ndata, (void**)&newdata)) != 0) {
-                return ierr;
-            }
-
-            if (data_block->error_type != UDA_TYPE_UNKNOWN && data_block->errhi != nullptr) {
-                if ((ierr = serverNewDataArray2(data_block->dims, data_block->rank, dimid, data_block->errhi,
-                                                data_block->data_n, data_block->error_type, notoperation, reverse,
-                                                start, end, start1, end1, &n, (void**)&newerrhi)) != 0) {
-                    return ierr;
+            if (selections.empty()) {
+                for (unsigned int k = 0; k < data_block->rank; k++) {
+                    selections.push_back({ data_block->dims[k].dim_n, true, {} });
                 }
-                free(data_block->errhi);                // Free Original Heap
-                data_block->errhi = newerrhi;                // Replace with the Reshaped Array
             }
 
-            if (data_block->error_type != UDA_TYPE_UNKNOWN && dim->errlo != nullptr) {
-                if ((ierr = serverNewDataArray2(data_block->dims, data_block->rank, dimid, data_block->errlo,
-                                                data_block->data_n, data_block->error_type, notoperation, reverse,
-                                                start, end, start1, end1, &n, (void**)&newerrlo)) != 0) {
-                    return ierr;
+            auto& selection = selections[dimid];
+            if (selection.all) {
+                selection.all = false;
+                selection.indices = indices;
+            } else {
+                std::vector<int> composed;
+                composed.reserve(indices.size());
+                for (int index : indices) {
+                    composed.push_back(selection.indices[index]);
                 }
-                free(data_block->errlo);                // Free Original Heap
-                data_block->errlo = newerrlo;                // Replace with the Reshaped Array
+                selection.indices = composed;
             }
 
-            data_block->data_n = ndata;
-
-            free(data_block->data);                // Free Original Heap
-            data_block->data = newdata;                    // Replace with the Reshaped Array
-
             // replace the Original Dimensional Structure with the New Subsetted Structure unless a
             // REFORM [Rank Reduction] has been requested and the dimension length is 1 (this has no effect on the Data Array items)
 
@@ -606,8 +644,65 @@ int uda::serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST*
 
             data_block->dims[dimid] = newdim;                            // Replace with the subsetted dimension
         }
+
+        //-----------------------------------------------------------------------------------------------------------------------
+        // Reshape and Save the Subsetted Data: all dimensions in a single pass
+
+        if (selections.empty()) {
+            continue;
+        }
+
+        printDataBlock(*data_block);
+
+        // Deferred calibrations are applied as the data are gathered: only the elements selected are calibrated
+
+        DeferredCalibrations none;
+        DeferredCalibrations& calibrations = deferred != nullptr ? *deferred : none;
+
+        // All the arrays are gathered before any is replaced, so a failure leaves the data block unchanged
+
+        bool errors = data_block->error_type != UDA_TYPE_UNKNOWN;
+        newerrhi = nullptr;
+        newerrlo = nullptr;
+
+        if ((ierr = serverSubsetArray(selections, data_block->data, data_block->data_type, &ndata, &newdata,
+                                      &calibrations.data)) != 0
+            || (errors && data_block->errhi != nullptr
+                && (ierr = serverSubsetArray(selections, data_block->errhi, data_block->error_type, &n, &newerrhi,
+                                             &calibrations.errhi)) != 0)
+            || (errors && data_block->errlo != nullptr
+                && (ierr = serverSubsetArray(selections, data_block->errlo, data_block->error_type, &n, &newerrlo,
+                                             &calibrations.errlo)) != 0)) {
+            free(newdata);
+            free(newerrhi);
+            free(newerrlo);
+            return ierr;
+        }
+
+        if (newerrhi != nullptr) {
+            free(data_block->errhi);                // Free Original Heap
+            data_block->errhi = newerrhi;                // Replace with the Reshaped Array
+        }
+
+        if (newerrlo != nullptr) {
+            free(data_block->errlo);
+            data_block->errlo = newerrlo;
+        }
+
+        data_block->data_n = ndata;
+
+        free(data_block->data);                // Free Original Heap
+        data_block->data = newdata;                    // Replace with the Reshaped Array
+
+        calibrations.data.clear();
+        calibrations.errhi.clear();
+        calibrations.errlo.clear();
     }
 
+    // Calibrations not taken up by a subset must precede the reform and functions
+
+    server_apply_deferred_calibrations(data_block, deferred);
+
     //-------------------------------------------------------------------------------------------------------------
     // Reform the Data if requested
 
@@ -1417,6 +1512,172 @@ int uda::serverParseServerSide(REQUEST_DATA* request_block, ACTIONS* actions_ser
 }
 
 
+//----------------------------------------------------------------------------------------------------------------------
+// Identify the Index Range satisfying a conditional operator on a monotonic dimension by binary search
+//
+// Compressed dimensions (method 0) are searched using their closed form values dim0 + k * diff without being
+// decompressed. Uncompressed dimensions must be ordered (ascending or descending) - this is checked with a single
+// read only pass. Returns false if the operation or dimension is not suitable, when the linear scan must be used.
+// An empty range is returned as end < start.
+
+namespace {
+
+template <typename T, typename Values>
+bool serverSubsetRangeForType(const char* operation, Values at, int n, bool ascending, double value,
+                              int* start, int* end)
+{
+    auto v = (T)value;
+
+    // First index in [0, n) where the predicate is false: the predicate must be true then false along the dimension
+
+    auto first = [&](auto pred) {
+        int lo = 0;
+        int hi = n;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (pred(at(mid))) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    };
+
+    auto before = [&](T x) { return ascending ? x < v : x > v; };       // Strictly before the value
+    auto not_after = [&](T x) { return ascending ? x <= v : x >= v; };
+
+    if (STR_IEQUALS(operation, "lt") || STR_EQUALS(operation, "<")) {
+        if (ascending) {
+            *start = 0;
+            *end = first([&](T x) { return x < v; }) - 1;
+        } else {
+            *start = first([&](T x) { return x >= v; });
+            *end = n - 1;
+        }
+    } else if (STR_IEQUALS(operation, "le") || STR_EQUALS(operation, "<=")) {
+        if (ascending) {
+            *start = 0;
+            *end = first([&](T x) { return x <= v; }) - 1;
+        } else {
+            *start = first([&](T x) { return x > v; });
+            *end = n - 1;
+        }
+    } else if (STR_IEQUALS(operation, "gt") || STR_EQUALS(operation, ">")) {
+        if (ascending) {
+            *start = first([&](T x) { return x <= v; });
+            *end = n - 1;
+        } else {
+            *start = 0;
+            *end = first([&](T x) { return x > v; }) - 1;
+        }
+    } else if (STR_IEQUALS(operation, "ge") || STR_EQUALS(operation, ">=")) {
+        if (ascending) {
+            *start = first([&](T x) { return x < v; });
+            *end = n - 1;
+        } else {
+            *start = 0;
+            *end = first([&](T x) { return x >= v; }) - 1;
+        }
+    } else if (STR_IEQUALS(operation, "eq") || operation[0] == '=' || STR_EQUALS(operation, "~=")) {
+        *start = first(before);
+        *end = first(not_after) - 1;
+
+        if (*end >= *start || !STR_EQUALS(operation, "~=") || !std::is_floating_point<T>::value) {
+            return true;
+        }
+
+        // Values within the type's epsilon of the requested value
+
+        const T epsilon = std::is_same<T, float>::value ? FLT_EPSILON : DBL_EPSILON;
+        auto close = [&](T x) { return fabs((double)x - (double)v) <= epsilon; };
+
+        *start = first([&](T x) { return before(x) && !close(x); });
+        *end = first([&](T x) { return before(x) || close(x); }) - 1;
+
+        if (*end >= *start) {
+            return true;
+        }
+
+        // The single nearest value: the first occurrence of the closer of the values either side of the requested
+        // value. As with the linear scan, the first element and end points further from the value than the last
+        // interval are not matched.
+
+        int index = *start;
+        auto delta = [&](int k) { return fabs((double)v - (double)at(k)); };
+
+        if (index == n || (index > 0 && delta(index - 1) <= delta(index))) {
+            T x = at(index - 1);
+            index = first([&](T y) { return ascending ? y < x : y > x; });
+        }
+
+        *start = 0;
+        *end = -1;
+
+        if (index == 0 || !(delta(index) < delta(0))) {
+            return true;
+        }
+        if (index == n - 1 && delta(index) > fabs((double)at(n - 1) - (double)at(n - 2))) {
+            return true;
+        }
+
+        *start = index;
+        *end = index;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+template <typename T>
+bool serverSubsetRangeForType(const char* operation, const DIMS* dim, double value, int* start, int* end)
+{
+    if (dim->dim_n <= 0) {
+        return false;
+    }
+
+    if (dim->compressed) {
+        if (dim->method != 0) {
+            return false;
+        }
+        double dim0 = dim->dim0;
+        double diff = dim->diff;
+        auto at = [dim0, diff](int k) { return (T)(dim0 + k * diff); };
+        return serverSubsetRangeForType<T>(operation, at, dim->dim_n, diff >= 0, value, start, end);
+    }
+
+    auto p = (const T*)dim->dim;
+    if (p == nullptr) {
+        return false;
+    }
+
+    bool ascending = std::is_sorted(p, p + dim->dim_n);
+    if (!ascending && !std::is_sorted(p, p + dim->dim_n, std::greater<T>())) {
+        return false;
+    }
+
+    auto at = [p](int k) { return p[k]; };
+    return serverSubsetRangeForType<T>(operation, at, dim->dim_n, ascending, value, start, end);
+}
+
+bool serverSubsetRange(const char* operation, const DIMS* dim, double value, int* start, int* end)
+{
+    switch (dim->data_type) {
+        case UDA_TYPE_DOUBLE:
+            return serverSubsetRangeForType<double>(operation, dim, value, start, end);
+        case UDA_TYPE_FLOAT:
+            return serverSubsetRangeForType<float>(operation, dim, value, start, end);
+        case UDA_TYPE_INT:
+            return serverSubsetRangeForType<int>(operation, dim, value, start, end);
+        default:
+            return false;
+    }
+}
+
+} // anon namespace
+
+
 //----------------------------------------------------------------------------------------------------------------------
 // Identify the Index Range satisfying a small set of conditional operators
 
@@ -1665,410 +1926,20 @@ int serverSubsetIndices(char* operation, DIMS* dim, double value, unsigned int*
 }
 
 
-int serverNewDataArray2(DIMS* dims, int rank, int dimid,
-                        char* data, int ndata, int data_type, int notoperation, int reverse,
-                        int start, int end, int start1, int end1, int* n, void** newdata)
-{
-
-    int ierr = 0, rows, columns, newrows, newcols, count = 0;
-
-    UDA_LOG(UDA_LOG_DEBUG, "Data Type: %d    Rank: %d\n", data_type, rank);
-
-    *n = 0;
-
-    switch (data_type) {
-
-        case UDA_TYPE_FLOAT: {
-
-            float* p, * dp;
-            float** pa, ** dpa;
-
-            // Allocate heap for the reshaped array
-
-            if ((p = (float*)malloc(ndata * sizeof(float))) == nullptr) {
-                UDA_THROW_ERROR(9999, "Unable to Allocate Heap memory");
-            }
-
-            dp = (float*)data;        // the Originating Data Array
-
-            // Reshape
-
-            switch (rank) {
-                case 1: {
-                    int k = 0;
-                    if (!reverse) {
-                        for (int i = start; i <= end; i++) p[k++] = dp[i];
-                        if (notoperation) for (int i = start1; i <= end1; i++) p[k++] = dp[i];
-                    } else {
-                        if (notoperation) for (int i = end1; i >= start1; i--) p[k++] = dp[i];
-                        for (int i = end; i >= start; i--) p[k++] = dp[i];
-                    }
-                    *n = k;
-                    *newdata = (void*)p;
-                    break;
-                }
-
-                case 2:
-
-                    // Original Data
-
-                    rows = dims[1].dim_n;
-                    columns = dims[0].dim_n;
-                    dpa = (float**)malloc(rows * sizeof(float*));
-                    for (int j = 0; j < rows; j++) dpa[j] = &dp[j * columns];
-
-                    // Array for Reshaped Data
-
-                    if (dimid == 0) {
-                        newrows = dims[1].dim_n;
-                        newcols = end - start + 1;
-                        if (notoperation) newcols = newcols + end1 - start1 + 1;
-                    } else {
-                        newcols = dims[0].dim_n;
-                        newrows = end - start + 1;
-                        if (notoperation) newrows = newrows + end1 - start1 + 1;
-                    }
-                    pa = (float**)malloc(newrows * sizeof(float*));
-                    for (int j = 0; j < newrows; j++) pa[j] = &p[j * newcols];
-
-                    // Reshape the Data
-
-                    if (dimid == 0) {
-                        for (int j = 0; j < rows; j++) {
-                            int k = 0;
-                            if (!reverse) {
-                                for (int i = start; i <= end; i++) {
-                                    pa[j][k++] = dpa[j][i];
-                                    count++;
-                                }
-                                if (notoperation) {
-                                    for (int i = start1; i <= end1; i++) {
-                                        pa[j][k++] = dpa[j][i];
-                                        count++;
-                                    }
-                                }
-                            } else {
-                                if (notoperation) {
-                                    for (int i = end1; i <= start1; i--) {
-                                        pa[j][k++] = dpa[j][i];
-                                        count++;
-                                    }
-                                }
-                                for (int i = end; i <= start; i--) {
-                                    pa[j][k++] = dpa[j][i];
-                                    count++;
-                                }
-                            }
-                        }
-                    } else {
-                        int k = 0;
-                        if (!reverse) {
-                            for (int j = start; j <= end; j++) {
-                                for (int i = 0; i < columns; i++) {
-                                    pa[k][i] = dpa[j][i];
-                                    count++;
-                                }
-                                k++;
-                            }
-                            if (notoperation) {
-                                for (int j = start1; j <= end1; j++) {
-                                    for (int i = 0; i < columns; i++) {
-                                        pa[k][i] = dpa[j][i];
-                                        count++;
-                                    }
-                                    k++;
-                                }
-                            }
-                        } else {
-                            if (notoperation) {
-                                for (int j = end1; j <= start1; j--) {
-                                    for (int i = 0; i < columns; i++) {
-                                        pa[k][i] = dpa[j][i];
-                                        count++;
-                                    }
-                                    k++;
-                                }
-                            }
-                            for (int j = end; j <= start; j--) {
-                                for (int i = 0; i < columns; i++) {
-                                    pa[k][i] = dpa[j][i];
-                                    count++;
-                                }
-                                k++;
-                            }
-                        }
-                    }
-
-                    *newdata = (void*)&pa[0][0];
-                    *n = count;
-                    break;
-            }
-            break;
-        }
-
-        case UDA_TYPE_DOUBLE: {
-
-            double* p, * dp;
-            double** pa, ** dpa;
-
-            // Allocate heap for the reshaped array
-
-            if ((p = (double*)malloc(ndata * sizeof(double))) == nullptr) {
-                UDA_THROW_ERROR(9999, "Unable to Allocate Heap memory");
-            }
-
-            dp = (double*)data;        // the Originating Data Array
-
-            // Reshape
-
-            switch (rank) {
-                case 1: {
-                    int k = 0;
-                    if (!reverse) {
-                        for (int i = start; i <= end; i++) p[k++] = dp[i];
-                        if (notoperation) for (int i = start1; i <= end1; i++) p[k++] = dp[i];
-                    } else {
-                        if (notoperation) for (int i = end1; i >= start1; i--) p[k++] = dp[i];
-                        for (int i = end; i >= start; i--) p[k++] = dp[i];
-                    }
-                    *n = k;
-                    *newdata = (void*)p;
-                    break;
-                }
-
-                case 2:
-
-                    // Original Data
-
-                    rows = dims[1].dim_n;
-                    columns = dims[0].dim_n;
-                    dpa = (double**)malloc(rows * sizeof(double*));
-                    for (int j = 0; j < rows; j++) dpa[j] = &dp[j * columns];
-
-                    // Array for Reshaped Data
-
-                    if (dimid == 0) {
-                        newrows = dims[1].dim_n;
-                        newcols = end - start + 1;
-                        if (notoperation) newcols = newcols + end1 - start1 + 1;
-                    } else {
-                        newcols = dims[0].dim_n;
-                        newrows = end - start + 1;
-                        if (notoperation) newrows = newrows + end1 - start1 + 1;
-                    }
-                    pa = (double**)malloc(newrows * sizeof(double*));
-                    for (int j = 0; j < newrows; j++) pa[j] = &p[j * newcols];
-
-                    // Reshape the Data
-
-                    if (dimid == 0) {
-                        for (int j = 0; j < rows; j++) {
-                            int k = 0;
-                            if (!reverse) {
-                                for (int i = start; i <= end; i++) {
-                                    pa[j][k++] = dpa[j][i];
-                                    count++;
-                                }
-                                if (notoperation) {
-                                    for (int i = start1; i <= end1; i++) {
-                                        pa[j][k++] = dpa[j][i];
-                                        count++;
-                                    }
-                                }
-                            } else {
-                                if (notoperation) {
-                                    for (int i = end1; i <= start1; i--) {
-                                        pa[j][k++] = dpa[j][i];
-                                        count++;
-                                    }
-                                }
-                                for (int i = end; i <= start; i--) {
-                                    pa[j][k++] = dpa[j][i];
-                                    count++;
-                                }
-                            }
-                        }
-                    } else {
-                        int k = 0;
-                        if (!reverse) {
-                            for (int j = start; j <= end; j++) {
-                                for (int i = 0; i < columns; i++) {
-                                    pa[k][i] = dpa[j][i];
-                                    count++;
-                                }
-                                k++;
-                            }
-                            if (notoperation) {
-                                for (int j = start1; j <= end1; j++) {
-                                    for (int i = 0; i < columns; i++) {
-                                        pa[k][i] = dpa[j][i];
-                                        count++;
-                                    }
-                                    k++;
-                                }
-                            }
-                        } else {
-                            if (notoperation) {
-                                for (int j = end1; j <= start1; j--) {
-                                    for (int i = 0; i < columns; i++) {
-                                        pa[k][i] = dpa[j][i];
-                                        count++;
-                                    }
-                                    k++;
-                                }
-                            }
-                            for (int j = end; j <= start; j--) {
-                                for (int i = 0; i < columns; i++) {
-                                    pa[k][i] = dpa[j][i];
-                                    count++;
-                                }
-                                k++;
-                            }
-                        }
-                    }
-
-                    *newdata = (void*)&pa[0][0];
-                    *n = count;
-                    break;
-            }
-            break;
-        }
-
-        case UDA_TYPE_INT: {
-
-            int* p, * dp;
-            int** pa, ** dpa;
-
-            // Allocate heap for the reshaped array
-
-            if ((p = (int*)malloc(ndata * sizeof(int))) == nullptr) {
-                UDA_THROW_ERROR(9999, "Unable to Allocate Heap memory");
-            }
-
-            dp = (int*)data;        // the Originating Data Array
-
-            // Reshape
-
-            switch (rank) {
-                case 1: {
-                    int k = 0;
-                    if (!reverse) {
-                        for (int i = start; i <= end; i++) p[k++] = dp[i];
-                        if (notoperation) for (int i = start1; i <= end1; i++) p[k++] = dp[i];
-                    } else {
-                        if (notoperation) for (int i = end1; i >= start1; i--) p[k++] = dp[i];
-                        for (int i = end; i >= start; i--) p[k++] = dp[i];
-                    }
-                    *n = k;
-                    *newdata = (void*)p;
-                    break;
-                }
-
-                case 2:
-
-                    // Original Data
-
-                    rows = dims[1].dim_n;
-                    columns = dims[0].dim_n;
-                    dpa = (int**)malloc(rows * sizeof(int*));
-                    for (int j = 0; j < rows; j++) dpa[j] = &dp[j * columns];
-
-                    // Array for Reshaped Data
-
-                    if (dimid == 0) {
-                        newrows = dims[1].dim_n;
-                        newcols = end - start + 1;
-                        if (notoperation) newcols = newcols + end1 - start1 + 1;
-                    } else {
-                        newcols = dims[0].dim_n;
-                        newrows = end - start + 1;
-                        if (notoperation) newrows = newrows + end1 - start1 + 1;
-                    }
-                    pa = (int**)malloc(newrows * sizeof(int*));
-                    for (int j = 0; j < newrows; j++) pa[j] = &p[j * newcols];
-
-                    // Reshape the Data
-
-                    if (dimid == 0) {
-                        for (int j = 0; j < rows; j++) {
-                            int k = 0;
-                            if (!reverse) {
-                                for (int i = start; i <= end; i++) {
-                                    pa[j][k++] = dpa[j][i];
-                                    count++;
-                                }
-                                if (notoperation) {
-                                    for (int i = start1; i <= end1; i++) {
-                                        pa[j][k++] = dpa[j][i];
-                                        count++;
-                                    }
-                                }
-                            } else {
-                                if (notoperation) {
-                                    for (int i = end1; i <= start1; i--) {
-                                        pa[j][k++] = dpa[j][i];
-                                        count++;
-                                    }
-                                }
-                                for (int i = end; i <= start; i--) {
-                                    pa[j][k++] = dpa[j][i];
-                                    count++;
-                                }
-                            }
-                        }
-                    } else {
-                        int k = 0;
-                        if (!reverse) {
-                            for (int j = start; j <= end; j++) {
-                                for (int i = 0; i < columns; i++) {
-                                    pa[k][i] = dpa[j][i];
-                                    count++;
-                                }
-                                k++;
-                            }
-                            if (notoperation) {
-                                for (int j = start1; j <= end1; j++) {
-                                    for (int i = 0; i < columns; i++) {
-                                        pa[k][i] = dpa[j][i];
-                                        count++;
-                                    }
-                                    k++;
-                                }
-                            }
-                        } else {
-                            if (notoperation) {
-                                for (int j = end1; j <= start1; j--) {
-                                    for (int i = 0; i < columns; i++) {
-                                        pa[k][i] = dpa[j][i];
-                                        count++;
-                                    }
-                                    k++;
-                                }
-                            }
-                            for (int j = end; j <= start; j--) {
-                                for (int i = 0; i < columns; i++) {
-                                    pa[k][i] = dpa[j][i];
-                                    count++;
-                                }
-                                k++;
-                            }
-                        }
-                    }
-
-                    *newdata = (void*)&pa[0][0];
-                    *n = count;
-                    break;
-            }
-            break;
-        }
+//----------------------------------------------------------------------------------------------------------------------
+// Gather the elements selected along each dimension into a new array. Any deferred calibrations are applied to the
+// gathered elements in chunks while they are still in cache, so the source array is never calibrated in full.
 
-        default:
-            UDA_LOG(UDA_LOG_ERROR, "Only Float, Double and 32 bit Signed Integer Numerical Types can be Subset at this time!\n");
-            UDA_LOG(UDA_LOG_ERROR, "Data Type: %d    Rank: %d\n", data_type, rank);
-            UDA_THROW_ERROR(9999, "Only Float, Double and 32 bit Signed Integer Numerical Types can be Subset at this time!");
+int serverSubsetArray(const std::vector<Selection>& selections, const char* data, int data_type, int64_t* n,
+                      char** newdata, const std::vector<uda::Calibration>* calibrations)
+{
+    if (calibrations == nullptr || calibrations->empty()) {
+        return uda::subsetArray(selections, data, data_type, n, newdata);
     }
 
-    return ierr;
+    return uda::subsetArray(selections, data, data_type, n, newdata, [&](char* begin, int count) {
+        uda::server_apply_calibrations(*calibrations, data_type, count, begin);
+    });
 }
 
 } // anon namespace
\ No newline at end of file
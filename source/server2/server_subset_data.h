@@ -8,9 +8,12 @@
 #include <structures/genStructs.h>
 #include <clientserver/export.h>
 
+#include "apply_XML.hpp"
+
 namespace uda {
 
-int serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST* logmalloclist);
+int serverSubsetData(DATA_BLOCK* data_block, ACTION action, LOGMALLOCLIST* logmalloclist,
+                     DeferredCalibrations* deferred = nullptr);
 
 int serverParseServerSide(REQUEST_DATA* request_block, ACTIONS* actions_serverside, Environment* environment);
 
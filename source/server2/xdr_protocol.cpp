@@ -10,8 +10,11 @@
 #  include "authentication/udaServerSSL.h"
 #endif
 
+#include <algorithm>
 #include <cerrno>
 #include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 
 #include <logging/logging.h>
 #include <clientserver/udaDefines.h>
@@ -27,6 +30,7 @@
 
 constexpr int MinBlockTime = 1000;
 constexpr int MaxBlockTime = 10000;
+constexpr size_t DataChunkBytes = 4 * 1024 * 1024;
 
 int serverSocket = 0;
 
@@ -121,12 +125,16 @@ int server_write(void* iohandle, char* buf, int count)
     // Write to socket, checking for EINTR, as happens if called from IDL
 
     while (BytesSent < count) {
-        while (((rc = (int)write(serverSocket, buf, count)) == -1) && (errno == EINTR)) {}
+        while (((rc = (int)write(serverSocket, buf, count - BytesSent)) == -1) && (errno == EINTR)) {}
+        if (rc <= 0) {
+            // Client has gone away - a persistent server must not spin on a dead socket
+            return -1;
+        }
         BytesSent += rc;
         buf += rc;
     }
 
-    return rc;
+    return BytesSent;
 }
 
 void uda::XdrProtocol::create()
@@ -134,6 +142,15 @@ void uda::XdrProtocol::create()
     create_streams();
 }
 
+void uda::XdrProtocol::set_socket(int socket)
+{
+    serverSocket = socket;
+    server_tot_block_time_ = 0;
+#ifdef SSLAUTHENTICATION
+    putUdaServerSSLSocket(socket);
+#endif
+}
+
 uda::XdrProtocol::XdrProtocol()
     : server_input_{}
     , server_output_{}
@@ -145,45 +162,26 @@ uda::XdrProtocol::XdrProtocol()
     io_data_.server_timeout = &server_timeout_;
 }
 
-void uda::XdrProtocol::create_streams()
+void uda::XdrProtocol::create_stream(XDR* xdrs, u_int send_size, u_int recv_size)
 {
-    server_output_.x_ops = nullptr;
-    server_input_.x_ops = nullptr;
-
 #if defined(SSLAUTHENTICATION)
     if (getUdaServerSSLDisabled()) {
 #if defined (__APPLE__) || defined(__TIRPC__)
-       xdrrec_create( &server_output_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, &io_data_,
-                      reinterpret_cast<int (*)(void *, void *, int)>(server_read),
-                      reinterpret_cast<int (*)(void *, void *, int)>(server_write));
-
-       xdrrec_create( &server_input_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, &io_data_,
+       xdrrec_create( xdrs, send_size, recv_size, &io_data_,
                       reinterpret_cast<int (*)(void *, void *, int)>(server_read),
                       reinterpret_cast<int (*)(void *, void *, int)>(server_write));
 #else
-       xdrrec_create( &server_output_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)&io_data_,
-                      reinterpret_cast<int (*)(char *, char *, int)>(server_read),
-                      reinterpret_cast<int (*)(char *, char *, int)>(server_write));
-
-       xdrrec_create( &server_input_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)&io_data_,
+       xdrrec_create( xdrs, send_size, recv_size, (char*)&io_data_,
                       reinterpret_cast<int (*)(char *, char *, int)>(server_read),
                       reinterpret_cast<int (*)(char *, char *, int)>(server_write));
 #endif
     } else {
 #if defined (__APPLE__) || defined(__TIRPC__)
-       xdrrec_create( &server_output_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, &io_data_,
-                      reinterpret_cast<int (*)(void *, void *, int)>(readUdaServerSSL),
-                      reinterpret_cast<int (*)(void *, void *, int)>(writeUdaServerSSL));
-
-       xdrrec_create( &server_input_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, &io_data_,
+       xdrrec_create( xdrs, send_size, recv_size, &io_data_,
                       reinterpret_cast<int (*)(void *, void *, int)>(readUdaServerSSL),
                       reinterpret_cast<int (*)(void *, void *, int)>(writeUdaServerSSL));
 #else
-       xdrrec_create( &server_output_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)&io_data_,
-                      reinterpret_cast<int (*)(char *, char *, int)>(readUdaServerSSL),
-                      reinterpret_cast<int (*)(char *, char *, int)>(writeUdaServerSSL));
-
-       xdrrec_create( &server_input_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)&io_data_,
+       xdrrec_create( xdrs, send_size, recv_size, (char*)&io_data_,
                       reinterpret_cast<int (*)(char *, char *, int)>(readUdaServerSSL),
                       reinterpret_cast<int (*)(char *, char *, int)>(writeUdaServerSSL));
 #endif
@@ -191,24 +189,37 @@ void uda::XdrProtocol::create_streams()
 #else // SSLAUTHENTICATION
 
 #if defined (__APPLE__) || defined(__TIRPC__)
-    xdrrec_create(&server_output_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, &io_data_,
-                  reinterpret_cast<int (*)(void*, void*, int)>(server_read),
-                  reinterpret_cast<int (*)(void*, void*, int)>(server_write));
-
-    xdrrec_create(&server_input_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, &io_data_,
+    xdrrec_create(xdrs, send_size, recv_size, &io_data_,
                   reinterpret_cast<int (*)(void*, void*, int)>(server_read),
                   reinterpret_cast<int (*)(void*, void*, int)>(server_write));
 #else
-    xdrrec_create(&server_output_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)&io_data_,
-                  reinterpret_cast<int (*)(char *, char *, int)>(server_read),
-                  reinterpret_cast<int (*)(char *, char *, int)>(server_write));
-
-    xdrrec_create(&server_input_, DB_READ_BLOCK_SIZE, DB_WRITE_BLOCK_SIZE, (char*)&io_data_,
+    xdrrec_create(xdrs, send_size, recv_size, (char*)&io_data_,
                   reinterpret_cast<int (*)(char *, char *, int)>(server_read),
                   reinterpret_cast<int (*)(char *, char *, int)>(server_write));
 #endif
 
 #endif // SSLAUTHENTICATION
+}
+
+void uda::XdrProtocol::create_streams()
+{
+    // Streams are re-created for each client session of a persistent server
+
+    if (server_output_.x_ops != nullptr) {
+        xdr_destroy(&server_output_);
+    }
+    if (server_input_.x_ops != nullptr) {
+        xdr_destroy(&server_input_);
+    }
+
+    server_output_.x_ops = nullptr;
+    server_input_.x_ops = nullptr;
+
+    // Only the output stream's send and the input stream's receive buffers are used
+
+    output_buffer_size_ = buffer_size_;
+    create_stream(&server_output_, output_buffer_size_, 0);
+    create_stream(&server_input_, 0, buffer_size_);
 
     server_input_.x_op = XDR_DECODE;
     server_output_.x_op = XDR_ENCODE;
@@ -216,6 +227,60 @@ void uda::XdrProtocol::create_streams()
     UDA_LOG(UDA_LOG_DEBUG, "XDR Streams Created\n");
 }
 
+void uda::XdrProtocol::set_buffer_sizes(int buffer_size, int max_buffer_size)
+{
+    buffer_size_ = buffer_size > 0 ? (u_int)buffer_size : DB_WRITE_BLOCK_SIZE;
+    max_buffer_size_ = std::max((u_int)std::max(max_buffer_size, 0), buffer_size_);
+}
+
+/**
+ * Grow the output stream's buffer after a bulk transfer of transfer_size bytes, up to the configured limit, so that
+ * later transfers of a similar size need fewer writes. Only called after a flush, when the stream holds no data.
+ */
+void uda::XdrProtocol::adapt_output_buffer(size_t transfer_size)
+{
+    u_int buffer_size = xdr_record_buffer_size(output_buffer_size_, transfer_size, max_buffer_size_);
+    if (buffer_size == output_buffer_size_) {
+        return;
+    }
+
+    UDA_LOG(UDA_LOG_DEBUG, "Resizing XDR Output Stream buffer to %u bytes\n", buffer_size);
+
+    xdr_destroy(&server_output_);
+    server_output_.x_ops = nullptr;
+
+    output_buffer_size_ = buffer_size;
+    create_stream(&server_output_, output_buffer_size_, 0);
+    server_output_.x_op = XDR_ENCODE;
+}
+
+/**
+ * Hold back partly filled TCP segments until the next flush, so that a response written in several buffers goes out
+ * as full segments, and only the end of the record as a short one. Has no effect where TCP_CORK is not available.
+ */
+void uda::XdrProtocol::cork()
+{
+#ifdef TCP_CORK
+    int on = 1;
+    corked_ = setsockopt(serverSocket, IPPROTO_TCP, TCP_CORK, &on, sizeof(on)) == 0;
+#endif
+}
+
+/**
+ * Release any segments held back by cork(). Called by flush(), and on abandoning a corked response part way through
+ * so that the socket is not left corked for the next one.
+ */
+void uda::XdrProtocol::uncork()
+{
+#ifdef TCP_CORK
+    if (corked_) {
+        int off = 0;
+        setsockopt(serverSocket, IPPROTO_TCP, TCP_CORK, &off, sizeof(off));
+        corked_ = false;
+    }
+#endif
+}
+
 int uda::XdrProtocol::read_client_block(ClientBlock* client_block, LogMallocList* log_malloc_list,
                                         UserDefinedTypeList* user_defined_type_list)
 {
@@ -272,7 +337,11 @@ int uda::XdrProtocol::send_server_block(SERVER_BLOCK server_block, LogMallocList
 
 int uda::XdrProtocol::flush()
 {
-    if (!xdrrec_endofrecord(&server_output_, 1)) {    // Send data now
+    bool sent = xdrrec_endofrecord(&server_output_, 1);    // Send data now
+
+    uncork();       // Release the segments held back, with the end of the record
+
+    if (!sent) {
         UDA_THROW_ERROR(UDA_PROTOCOL_ERROR_7, "Protocol 7 Error (Server Block)");
     }
 
@@ -359,6 +428,9 @@ int uda::XdrProtocol::send_data_blocks(const std::vector<DataBlock>& data_blocks
     DATA_BLOCK_LIST data_block_list = {};
     data_block_list.count = static_cast<int>(data_blocks.size());
     data_block_list.data = const_cast<DATA_BLOCK *>(data_blocks.data());
+    data_block_list.native_data = native_data_;
+    data_block_list.stream_data = stream_data_;
+    data_block_list.compress_data = compress_data_;
 
     int err = 0;
     if ((err = protocol2(&server_output_, UDA_PROTOCOL_DATA_BLOCK_LIST, XDR_SEND, nullptr, log_malloc_list,
@@ -374,11 +446,52 @@ int uda::XdrProtocol::send_data_blocks(const std::vector<DataBlock>& data_blocks
     return err;
 }
 
+/**
+ * Send the data array of a block selected for streaming (see streamedDataBlock) as records of at most DataChunkBytes,
+ * ended by an empty record. Each record is flushed to the client as it is written.
+ */
+int uda::XdrProtocol::send_data_stream(const DataBlock& data_block, LogMallocList* log_malloc_list,
+                                       UserDefinedTypeList* user_defined_type_list)
+{
+    if (!stream_data_ || protocol_version_ < 10 || !streamedDataBlock(&data_block)) {
+        return 0;
+    }
+
+    size_t size = getSizeOf((UDA_TYPE)data_block.data_type);
+    int64_t chunk_n = std::max<int64_t>(1, (int64_t)(DataChunkBytes / size));
+
+    DATA_CHUNK data_chunk = {};
+    data_chunk.data_type = data_block.data_type;
+    data_chunk.native_data = native_data_ && littleEndianHost();
+    data_chunk.compress_data = compress_data_ && protocol_version_ >= 11;
+
+    UDA_LOG(UDA_LOG_DEBUG, "Streaming %lld data elements to Client\n", (long long)data_block.data_n);
+
+    int64_t offset = 0;
+    do {
+        data_chunk.count = std::min(chunk_n, data_block.data_n - offset);
+        data_chunk.data = data_block.data + offset * size;
+
+        int err = 0;
+        if ((err = protocol2(&server_output_, UDA_PROTOCOL_DATA_CHUNK, XDR_SEND, nullptr, log_malloc_list,
+                             user_defined_type_list, (void*)&data_chunk, protocol_version_, &log_struct_list_, 0,
+                             malloc_source_)) != 0) {
+            addIdamError(UDA_CODE_ERROR_TYPE, __func__, err, "Server Side Protocol Error (Data Chunk)");
+            return err;
+        }
+
+        offset += data_chunk.count;
+    } while (data_chunk.count > 0);
+
+    return 0;
+}
+
 int uda::XdrProtocol::send_hierachical_data(const DataBlock& data_block, LogMallocList* log_malloc_list,
                                             UserDefinedTypeList* user_defined_type_list)
 {
-    if (protocol_version_ < 9 && data_block.data_type == UDA_TYPE_COMPOUND &&
-        data_block.opaque_type != UDA_OPAQUE_TYPE_UNKNOWN) {
+    // Clients of every protocol version read these after the data blocks
+
+    if (data_block.data_type == UDA_TYPE_COMPOUND && data_block.opaque_type != UDA_OPAQUE_TYPE_UNKNOWN) {
 
         int protocol_id;
 
@@ -448,6 +561,33 @@ void uda::XdrProtocol::set_version(int protocol_version)
     protocol_version_ = protocol_version;
 }
 
+/**
+ * Send data arrays as raw little-endian bytes rather than XDR, as requested by the client (CLIENTFLAG_NATIVEDATA).
+ * Only takes effect from protocol version 10; otherwise, or on a big-endian server, the arrays are sent as XDR.
+ */
+void uda::XdrProtocol::set_native_data(bool native_data)
+{
+    native_data_ = native_data;
+}
+
+/**
+ * Stream the data arrays of atomic data blocks to the client in bounded chunks, as requested by the client
+ * (CLIENTFLAG_STREAMDATA). Only takes effect from protocol version 10.
+ */
+void uda::XdrProtocol::set_stream_data(bool stream_data)
+{
+    stream_data_ = stream_data;
+}
+
+/**
+ * Compress the data and error arrays that are worth compressing, as requested by the client (CLIENTFLAG_COMPRESSDATA).
+ * Only takes effect from protocol version 11.
+ */
+void uda::XdrProtocol::set_compress_data(bool compress_data)
+{
+    compress_data_ = compress_data;
+}
+
 int uda::XdrProtocol::recv_request_block(REQUEST_BLOCK* request_block, LogMallocList* log_malloc_list,
                                          UserDefinedTypeList* user_defined_type_list)
 {
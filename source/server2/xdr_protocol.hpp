@@ -27,7 +27,12 @@ class XdrProtocol
 public:
     XdrProtocol();
     void create();
+    void set_socket(int socket);
     void set_version(int protocol_version);
+    void set_native_data(bool native_data);
+    void set_stream_data(bool stream_data);
+    void set_compress_data(bool compress_data);
+    void set_buffer_sizes(int buffer_size, int max_buffer_size);
 
     int read_client_block(ClientBlock* client_block, LogMallocList* log_malloc_list,
                           UserDefinedTypeList* user_defined_type_list);
@@ -38,8 +43,11 @@ public:
     int recv_putdata_block_list(PUTDATA_BLOCK_LIST* putdata_block_list, LogMallocList* log_malloc_list,
                                 UserDefinedTypeList* user_defined_type_list);
 
+    void cork();
+    void uncork();
     int flush();
     int eof();
+    void adapt_output_buffer(size_t transfer_size);
 
     DATA_BLOCK* read_from_cache(uda::cache::UdaCache* cache, RequestData* request, server::Environment& environment,
                                 LogMallocList* log_malloc_list, UserDefinedTypeList* user_defined_type_list);
@@ -51,6 +59,8 @@ public:
                        UserDefinedTypeList* user_defined_type_list);
     int send_data_blocks(const std::vector<DataBlock>& data_blocks, LogMallocList* log_malloc_list,
                          UserDefinedTypeList* user_defined_type_list);
+    int send_data_stream(const DataBlock& data_block, LogMallocList* log_malloc_list,
+                         UserDefinedTypeList* user_defined_type_list);
     int send_hierachical_data(const DataBlock& data_block, LogMallocList* log_malloc_list,
                               UserDefinedTypeList* user_defined_type_list);
     int recv_client_block(SERVER_BLOCK& server_block, CLIENT_BLOCK* client_block, bool* fatal,
@@ -59,6 +69,9 @@ public:
 
 private:
     int protocol_version_ = 8;
+    bool native_data_ = false;
+    bool stream_data_ = false;
+    bool compress_data_ = false;
     XDR server_input_;
     XDR server_output_;
     int server_tot_block_time_;
@@ -68,6 +81,12 @@ private:
     int malloc_source_;
     int private_flags_;
 
+    u_int buffer_size_ = DB_WRITE_BLOCK_SIZE;
+    u_int max_buffer_size_ = DB_MAX_BLOCK_SIZE;
+    u_int output_buffer_size_ = DB_WRITE_BLOCK_SIZE;
+    bool corked_ = false;
+
+    void create_stream(XDR* xdrs, u_int send_size, u_int recv_size);
     void create_streams();
 };
 
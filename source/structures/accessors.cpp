@@ -528,7 +528,7 @@ NTREE* idam_findNTreeStructureClass(NTREE* tree, int cls)
 */
 int idam_maxCountVlenStructureArray(NTREE* tree, const char* target, int reset)
 {
-    static unsigned int count = 0;
+    static thread_local unsigned int count = 0;
     if (reset) count = 0;
 
     if (tree == nullptr) {
@@ -64,9 +64,9 @@
 #  include <server/udaServer.h>
 #endif
 
-static unsigned int last_malloc_index = 0;                           // Malloc Log search index last value
-static unsigned int* last_malloc_index_value = &last_malloc_index;      // Preserve Malloc Log search index last value in GENERAL_STRUCT
-static NTREE* full_ntree = nullptr;
+static thread_local unsigned int last_malloc_index = 0;                             // Malloc Log search index last value
+static thread_local unsigned int* last_malloc_index_value = &last_malloc_index;     // Preserve Malloc Log search index last value in GENERAL_STRUCT
+static thread_local NTREE* full_ntree = nullptr;
 
 NTREE* udaGetFullNTree() {
     return full_ntree;
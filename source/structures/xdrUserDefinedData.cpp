@@ -11,7 +11,7 @@
 
 #include "struct.h"
 
-static int recursiveDepth = 0;    // Keep count of recursive calls
+static thread_local int recursiveDepth = 0;    // Keep count of recursive calls
 
 int xdrUserDefinedData(XDR* xdrs, LOGMALLOCLIST* logmalloclist, USERDEFINEDTYPELIST* userdefinedtypelist,
                        USERDEFINEDTYPE* userdefinedtype, void** data, int datacount, int structRank, int* structShape,
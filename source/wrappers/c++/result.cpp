@@ -71,7 +71,7 @@ uda::Result::Result(int handle)
         , type_(handle >= 0 ? idamTypeToTypeID(getIdamDataType(handle)) : &typeid(void))
         , uda_type_(handle >= 0 ? getIdamDataType(handle) : UDA_TYPE_UNKNOWN)
         , rank_(handle >= 0 ? static_cast<dim_type>(getIdamRank(handle)) : 0)
-        , size_(handle >= 0 ? static_cast<std::size_t>(getIdamDataNum(handle)) : 0)
+        , size_(handle >= 0 ? static_cast<std::size_t>(getIdamDataNum64(handle)) : 0)
 {
     if (handle >= 0 && (bool)getIdamProperties(handle)->get_meta) {
         SIGNAL_DESC* signal_desc = getIdamSignalDesc(handle);
@@ -101,7 +101,7 @@ const std::vector<size_t> uda::Result::shape() const
     std::vector<size_t> shape(rank);
 
     for (size_t i = 0; i < rank; ++i) {
-        shape[i] = static_cast<size_t>(getIdamDimNum(handle_, static_cast<int>(i)));
+        shape[i] = static_cast<size_t>(getIdamDimNum64(handle_, static_cast<int>(i)));
     }
 
     return shape;
@@ -113,14 +113,14 @@ static uda::Dim getDim(int handle, uda::dim_type num, uda::Result::DataType data
     if (data_type == uda::Result::DataType::DATA) {
         std::string label = getIdamDimLabel(handle, num);
         std::string units = getIdamDimUnits(handle, num);
-        auto size = static_cast<size_t>(getIdamDimNum(handle, num));
+        auto size = static_cast<size_t>(getIdamDimNum64(handle, num));
         auto data = reinterpret_cast<T*>(getIdamDimData(handle, num));
         return uda::Dim(num, data, size, label, units);
     }
 
     std::string label = getIdamDimLabel(handle, num);
     std::string units = getIdamDimUnits(handle, num);
-    auto size = static_cast<size_t>(getIdamDimNum(handle, num));
+    auto size = static_cast<size_t>(getIdamDimNum64(handle, num));
     auto data = reinterpret_cast<T*>(getIdamDimError(handle, num));
     return uda::Dim(num, data, size, label + " error", units);
 }
@@ -191,8 +191,8 @@ uda::Data* getDataAs(int handle, uda::Result::DataType data_type, const uda::Res
     }
 
     if (getIdamRank(handle) == 0) {
-        if (getIdamDataNum(handle) > 1) {
-            return new uda::Vector(data, (size_t)getIdamDataNum(handle));
+        if (getIdamDataNum64(handle) > 1) {
+            return new uda::Vector(data, (size_t)getIdamDataNum64(handle));
         }
         return new uda::Scalar(data[0]);
     } else {
@@ -211,8 +211,8 @@ uda::Data* getDataAsStringArray(int handle)
 {
     char* data = getIdamData(handle);
 
-    auto str_len = static_cast<size_t>(getIdamDimNum(handle, 0));
-    size_t arr_len = getIdamDataNum(handle) / str_len;
+    auto str_len = static_cast<size_t>(getIdamDimNum64(handle, 0));
+    size_t arr_len = getIdamDataNum64(handle) / str_len;
 
     auto strings = new std::vector<std::string>;
     std::vector<uda::Dim> dims;
@@ -220,7 +220,7 @@ uda::Data* getDataAsStringArray(int handle)
     auto rank = static_cast<uda::dim_type>(getIdamRank(handle));
     for (uda::dim_type dim_n = 1; dim_n < rank; ++dim_n) {
         auto dim_data = getIdamDimData(handle, dim_n);
-        auto dim_size = static_cast<size_t>(getIdamDimNum(handle, dim_n));
+        auto dim_size = static_cast<size_t>(getIdamDimNum64(handle, dim_n));
         auto label = getIdamDimLabel(handle, dim_n);
         auto units = getIdamDimUnits(handle, dim_n);
         dims.emplace_back(uda::Dim(dim_n, dim_data, dim_size,
@@ -0,0 +1,159 @@
+// Microbenchmark of the XDR array serialisers: compares per element xdr_vector against xdr_bulk_vector for the
+// atomic types, through a memory stream and a record stream, and checks both produce identical encodings.
+//
+// Usage: bench_xdr [count] [repeats]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <clientserver/xdrlib.h>
+
+namespace {
+
+using xdr_array_fn = bool_t (*)(XDR*, char*, uint64_t, u_int, xdrproc_t);
+
+bool_t element_vector(XDR* xdrs, char* data, uint64_t count, u_int size, xdrproc_t xdr_element)
+{
+    return xdr_vector(xdrs, data, (u_int)count, size, xdr_element);
+}
+
+int record_sink(void* handle, void* buffer, int count)
+{
+    auto out = static_cast<std::string*>(handle);
+    out->append(static_cast<char*>(buffer), (size_t)count);
+    return count;
+}
+
+struct RecordSource {
+    const std::string* in;
+    size_t offset;
+};
+
+int record_source(void* handle, void* buffer, int count)
+{
+    auto source = static_cast<RecordSource*>(handle);
+    size_t n = std::min((size_t)count, source->in->size() - source->offset);
+    memcpy(buffer, source->in->data() + source->offset, n);
+    source->offset += n;
+    return n > 0 ? (int)n : -1;
+}
+
+template <typename T>
+double encode_mem(xdr_array_fn fn, std::vector<T>& data, xdrproc_t proc, std::vector<char>& out, int repeats)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        XDR xdrs;
+        xdrmem_create(&xdrs, out.data(), (u_int)out.size(), XDR_ENCODE);
+        if (!fn(&xdrs, (char*)data.data(), (u_int)data.size(), sizeof(T), proc)) {
+            fprintf(stderr, "encode failed\n");
+            exit(1);
+        }
+        xdr_destroy(&xdrs);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+template <typename T>
+double decode_mem(xdr_array_fn fn, std::vector<T>& data, xdrproc_t proc, std::vector<char>& in, int repeats)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        XDR xdrs;
+        xdrmem_create(&xdrs, in.data(), (u_int)in.size(), XDR_DECODE);
+        if (!fn(&xdrs, (char*)data.data(), (u_int)data.size(), sizeof(T), proc)) {
+            fprintf(stderr, "decode failed\n");
+            exit(1);
+        }
+        xdr_destroy(&xdrs);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+template <typename T>
+std::string encode_rec(xdr_array_fn fn, std::vector<T>& data, xdrproc_t proc)
+{
+    std::string out;
+    XDR xdrs;
+    xdrrec_create(&xdrs, 0, 0, (char*)&out, nullptr, record_sink);
+    xdrs.x_op = XDR_ENCODE;
+    fn(&xdrs, (char*)data.data(), (u_int)data.size(), sizeof(T), proc);
+    xdrrec_endofrecord(&xdrs, 1);
+    xdr_destroy(&xdrs);
+    return out;
+}
+
+template <typename T>
+bool decode_rec(xdr_array_fn fn, std::vector<T>& data, xdrproc_t proc, const std::string& in)
+{
+    RecordSource source = { &in, 0 };
+    XDR xdrs;
+    xdrrec_create(&xdrs, 0, 0, (char*)&source, record_source, nullptr);
+    xdrs.x_op = XDR_DECODE;
+    xdrrec_skiprecord(&xdrs);
+    bool ok = fn(&xdrs, (char*)data.data(), (u_int)data.size(), sizeof(T), proc);
+    xdr_destroy(&xdrs);
+    return ok;
+}
+
+template <typename T>
+bool bench(const char* name, xdrproc_t proc, size_t unit_size, size_t count, int repeats)
+{
+    std::vector<T> data(count);
+    for (size_t i = 0; i < count; ++i) {
+        data[i] = (T)((i * 2654435761u) % 251) - (T)100;
+    }
+
+    std::vector<char> element_buffer(count * unit_size);
+    std::vector<char> bulk_buffer(count * unit_size);
+    std::vector<T> element_data(count);
+    std::vector<T> bulk_data(count);
+
+    double element_encode = encode_mem<T>(element_vector, data, proc, element_buffer, repeats);
+    double bulk_encode = encode_mem<T>(xdr_bulk_vector, data, proc, bulk_buffer, repeats);
+    double element_decode = decode_mem<T>(element_vector, element_data, proc, element_buffer, repeats);
+    double bulk_decode = decode_mem<T>(xdr_bulk_vector, bulk_data, proc, bulk_buffer, repeats);
+
+    std::string element_record = encode_rec<T>(element_vector, data, proc);
+    std::string bulk_record = encode_rec<T>(xdr_bulk_vector, data, proc);
+    std::vector<T> record_data(count);
+
+    bool ok = element_buffer == bulk_buffer && element_data == data && bulk_data == data
+              && element_record == bulk_record && decode_rec<T>(xdr_bulk_vector, record_data, proc, bulk_record)
+              && record_data == data;
+
+    double mbytes = (double)(count * sizeof(T)) / 1.0e6;
+    printf("%-16s encode %8.1f -> %8.1f MB/s   decode %8.1f -> %8.1f MB/s   %s\n", name,
+           mbytes / element_encode, mbytes / bulk_encode, mbytes / element_decode, mbytes / bulk_decode,
+           ok ? "identical" : "MISMATCH");
+
+    return ok;
+}
+
+} // anon namespace
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    int repeats = argc > 2 ? atoi(argv[2]) : 10;
+
+    printf("%zu elements, %d repeats: xdr_vector -> xdr_bulk_vector\n", count, repeats);
+
+    bool ok = bench<float>("float", (xdrproc_t)xdr_float, 4, count, repeats)
+              & bench<double>("double", (xdrproc_t)xdr_double, 8, count, repeats)
+              & bench<char>("char", (xdrproc_t)xdr_char, 4, count, repeats)
+              & bench<short>("short", (xdrproc_t)xdr_short, 4, count, repeats)
+              & bench<int>("int", (xdrproc_t)xdr_int, 4, count, repeats)
+              & bench<int64_t>("long64", (xdrproc_t)xdr_int64_t, 8, count, repeats)
+              & bench<unsigned char>("unsigned char", (xdrproc_t)xdr_u_char, 4, count, repeats)
+              & bench<unsigned short>("unsigned short", (xdrproc_t)xdr_u_short, 4, count, repeats)
+              & bench<unsigned int>("unsigned int", (xdrproc_t)xdr_u_int, 4, count, repeats)
+              & bench<uint64_t>("unsigned long64", (xdrproc_t)xdr_uint64_t, 8, count, repeats);
+
+    return ok ? 0 : 1;
+}
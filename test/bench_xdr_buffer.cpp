@@ -0,0 +1,202 @@
+// Microbenchmark of the XDR record stream buffer size: a data block array is passed over a loopback TCP connection
+// through record streams of each buffer size, as between server and client, in the XDR and the native encodings and
+// with the socket buffers left to the OS or fixed as the client used to set them. Reports the throughput and the
+// number of read and write system calls, and checks the decoded array against the original.
+//
+// Usage: bench_xdr_buffer [megabytes] [repeats]
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <clientserver/initStructs.h>
+#include <clientserver/udaTypes.h>
+#include <clientserver/xdrlib.h>
+
+namespace {
+
+struct Channel {
+    int socket;
+    long calls;
+};
+
+int channel_read(void* handle, void* buffer, int count)
+{
+    auto channel = static_cast<Channel*>(handle);
+    ++channel->calls;
+    ssize_t rc = recv(channel->socket, buffer, (size_t)count, 0);
+    return rc > 0 ? (int)rc : -1;
+}
+
+int channel_write(void* handle, void* buffer, int count)
+{
+    auto channel = static_cast<Channel*>(handle);
+    int sent = 0;
+    while (sent < count) {
+        ++channel->calls;
+        ssize_t rc = send(channel->socket, (char*)buffer + sent, (size_t)(count - sent), MSG_NOSIGNAL);
+        if (rc <= 0) {
+            return -1;
+        }
+        sent += (int)rc;
+    }
+    return sent;
+}
+
+void set_options(int socket, int socket_buffer)
+{
+    int on = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    if (socket_buffer > 0) {
+        setsockopt(socket, SOL_SOCKET, SO_SNDBUF, &socket_buffer, sizeof(socket_buffer));
+        setsockopt(socket, SOL_SOCKET, SO_RCVBUF, &socket_buffer, sizeof(socket_buffer));
+    }
+}
+
+bool connect_pair(int socket_buffer, int* writer, int* reader)
+{
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    set_options(listener, socket_buffer);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 1) != 0
+        || getsockname(listener, (sockaddr*)&address, &length) != 0) {
+        close(listener);
+        return false;
+    }
+
+    *reader = socket(AF_INET, SOCK_STREAM, 0);
+    set_options(*reader, socket_buffer);
+    if (connect(*reader, (sockaddr*)&address, sizeof(address)) != 0) {
+        close(listener);
+        close(*reader);
+        return false;
+    }
+
+    *writer = accept(listener, nullptr, nullptr);
+    close(listener);
+    return *writer >= 0;
+}
+
+struct Result {
+    double seconds;
+    long writes;
+    long reads;
+    bool ok;
+};
+
+Result run(std::vector<double>& data, bool native, u_int xdr_buffer, int socket_buffer, int repeats)
+{
+    Result result = { 0.0, 0, 0, true };
+    std::vector<double> decoded(data.size());
+
+    for (int i = 0; i < repeats; ++i) {
+        int writer_socket = -1;
+        int reader_socket = -1;
+        if (!connect_pair(socket_buffer, &writer_socket, &reader_socket)) {
+            fprintf(stderr, "loopback connection failed\n");
+            exit(1);
+        }
+
+        Channel writer = { writer_socket, 0 };
+        Channel reader = { reader_socket, 0 };
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::thread sender([&]() {
+            DATA_BLOCK data_block;
+            initDataBlock(&data_block);
+            data_block.data_type = UDA_TYPE_DOUBLE;
+            data_block.data_n = (int)data.size();
+            data_block.data = (char*)data.data();
+
+            XDR xdrs;
+            xdrrec_create(&xdrs, xdr_buffer, 0, (char*)&writer, nullptr, channel_write);
+            xdrs.x_op = XDR_ENCODE;
+            if (!xdr_data_block2(&xdrs, &data_block, native, false) || !xdrrec_endofrecord(&xdrs, 1)) {
+                fprintf(stderr, "encode failed\n");
+                exit(1);
+            }
+            xdr_destroy(&xdrs);
+        });
+
+        DATA_BLOCK data_block;
+        initDataBlock(&data_block);
+        data_block.data_type = UDA_TYPE_DOUBLE;
+        data_block.data_n = (int)data.size();
+        data_block.data = (char*)decoded.data();
+
+        XDR xdrs;
+        xdrrec_create(&xdrs, 0, xdr_buffer, (char*)&reader, channel_read, nullptr);
+        xdrs.x_op = XDR_DECODE;
+        if (!xdrrec_skiprecord(&xdrs) || !xdr_data_block2(&xdrs, &data_block, native, false)) {
+            fprintf(stderr, "decode failed\n");
+            exit(1);
+        }
+        xdr_destroy(&xdrs);
+        sender.join();
+
+        result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.writes += writer.calls;
+        result.reads += reader.calls;
+        result.ok = result.ok && decoded == data;
+
+        close(writer_socket);
+        close(reader_socket);
+    }
+
+    result.seconds /= repeats;
+    result.writes /= repeats;
+    result.reads /= repeats;
+    return result;
+}
+
+} // anon namespace
+
+int main(int argc, char** argv)
+{
+    size_t megabytes = argc > 1 ? strtoul(argv[1], nullptr, 10) : 256;
+    int repeats = argc > 2 ? atoi(argv[2]) : 3;
+
+    std::vector<double> data(megabytes * 1024 * 1024 / sizeof(double));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = 1.0e-6 * (double)i;
+    }
+
+    printf("%zu MB double array over loopback TCP, %d repeats\n", megabytes, repeats);
+    printf("%8s %12s %14s %10s %10s %10s\n", "encoding", "xdr buffer", "socket buffer", "MB/s", "writes", "reads");
+
+    const u_int xdr_buffers[] = { 4 * 1024, 32 * 1024, 128 * 1024, 512 * 1024, 1024 * 1024, 4 * 1024 * 1024 };
+    const int socket_buffers[] = { 0, 32 * 1024 };
+
+    bool ok = true;
+    for (bool native : { false, true }) {
+        for (int socket_buffer : socket_buffers) {
+            for (u_int xdr_buffer : xdr_buffers) {
+                Result result = run(data, native, xdr_buffer, socket_buffer, repeats);
+                char socket_name[32];
+                if (socket_buffer > 0) {
+                    snprintf(socket_name, sizeof(socket_name), "%d KB", socket_buffer / 1024);
+                } else {
+                    snprintf(socket_name, sizeof(socket_name), "os default");
+                }
+                printf("%8s %9u KB %14s %10.0f %10ld %10ld   %s\n", native ? "native" : "xdr", xdr_buffer / 1024,
+                       socket_name, (double)megabytes / result.seconds, result.writes, result.reads,
+                       result.ok ? "identical" : "MISMATCH");
+                ok = ok && result.ok;
+            }
+        }
+    }
+
+    return ok ? 0 : 1;
+}
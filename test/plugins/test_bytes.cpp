@@ -3,6 +3,9 @@
 
 #include <c++/UDA.hpp>
 
+#include <cstdio>
+#include <unistd.h>
+
 TEST_CASE( "Test BYTES::help() function", "[BYTES][plugins]" )
 {
 #include "setup.inc"
@@ -24,7 +27,10 @@ TEST_CASE( "Test BYTES::help() function", "[BYTES][plugins]" )
 
     REQUIRE( str != NULL );
 
-    std::string expected = "\nbytes: data reader to access files as a block of bytes without interpretation\n\n";
+    std::string expected = "\nbytes: data reader to access files as a block of bytes without interpretation\n\n"
+            "read(path=path [, offset=offset] [, length=length] [, checksum=md5|sha256|crc32c|xxh64])\n"
+            "\tRead length bytes (default to the end of the file) from offset (default 0). With a checksum\n"
+            "\tthe data label is the algorithm and the data description the checksum in hexadecimal\n\n";
 
     REQUIRE( str->str() == expected );
 }
@@ -52,7 +58,10 @@ TEST_CASE( "Test BYTES::read() function", "[BYTES][plugins]" )
 
     REQUIRE( arr != NULL );
 
-    std::string expected = "\nbytes: data reader to access files as a block of bytes without interpretation\n\n";
+    std::string expected = "\nbytes: data reader to access files as a block of bytes without interpretation\n\n"
+            "read(path=path [, offset=offset] [, length=length] [, checksum=md5|sha256|crc32c|xxh64])\n"
+            "\tRead length bytes (default to the end of the file) from offset (default 0). With a checksum\n"
+            "\tthe data label is the algorithm and the data description the checksum in hexadecimal\n\n";
 
     REQUIRE( arr->type().name() == typeid(char).name() );
     REQUIRE( arr->size() == 5 * sizeof(int) );
@@ -66,4 +75,128 @@ TEST_CASE( "Test BYTES::read() function", "[BYTES][plugins]" )
     REQUIRE( numbers[2] == 3 );
     REQUIRE( numbers[3] == 4 );
     REQUIRE( numbers[4] == 5 );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Test BYTES::read() function with a byte range", "[BYTES][plugins]" )
+{
+#include "setup.inc"
+
+    uda::Client client;
+
+    std::string request = std::string("BYTES::read(path=") + TEST_DATA_DIR + "/bytes.dat"
+            + ", offset=" + std::to_string(sizeof(int)) + ", length=" + std::to_string(3 * sizeof(int)) + ")";
+
+    const uda::Result& result = client.get(request, "");
+
+    REQUIRE( result.errorCode() == 0 );
+    REQUIRE( result.errorMessage().empty() );
+
+    uda::Data* data = result.data();
+
+    REQUIRE( data != NULL );
+    REQUIRE( !data->isNull() );
+
+    auto arr = dynamic_cast<uda::Array*>(data);
+
+    REQUIRE( arr != NULL );
+    REQUIRE( arr->type().name() == typeid(char).name() );
+    REQUIRE( arr->size() == 3 * sizeof(int) );
+
+    std::vector<char> bytes = arr->as<char>();
+
+    auto numbers = reinterpret_cast<int*>(bytes.data());
+
+    REQUIRE( numbers[0] == 2 );
+    REQUIRE( numbers[1] == 3 );
+    REQUIRE( numbers[2] == 4 );
+}
+
+TEST_CASE( "Test BYTES::read() function with an offset outside the file", "[BYTES][plugins]" )
+{
+#include "setup.inc"
+
+    uda::Client client;
+
+    std::string request = std::string("BYTES::read(path=") + TEST_DATA_DIR + "/bytes.dat" + ", offset=1000)";
+
+    REQUIRE_THROWS( client.get(request, "") );
+}
+
+TEST_CASE( "Test BYTES::read() function with a checksum", "[BYTES][plugins]" )
+{
+#include "setup.inc"
+
+    uda::Client client;
+
+    // Known answers for bytes.dat: the five 32 bit integers 1 to 5, little-endian
+    const std::vector<std::pair<std::string, std::string>> expected = {
+            { "crc32c", "be9aa9f8" },
+            { "md5", "fe054ad2e7b98bee673f9ff22d50f00c" },
+            { "sha256", "4f6addc9659d6fb90fe94b6688a79f2a1fa8d36ec43f8f3e1d9b6528c448a384" },
+            { "xxh64", "45d5f3899d87b3a9" },
+    };
+
+    for (const auto& checksum : expected) {
+        std::string request = std::string("BYTES::read(path=") + TEST_DATA_DIR + "/bytes.dat"
+                + ", checksum=" + checksum.first + ")";
+
+        const uda::Result& result = client.get(request, "");
+
+        REQUIRE( result.errorCode() == 0 );
+        REQUIRE( result.errorMessage().empty() );
+
+        REQUIRE( result.label() == checksum.first );
+        REQUIRE( result.description() == checksum.second );
+    }
+
+    REQUIRE_THROWS( client.get(std::string("BYTES::read(path=") + TEST_DATA_DIR + "/bytes.dat" + ", checksum=sum)", "") );
+}
+
+TEST_CASE( "Test BYTES::read() function with a checksum of a file read in several chunks", "[BYTES][plugins]" )
+{
+#include "setup.inc"
+
+    // Larger than the 8 MB chunk read and hashed at a time, and not a whole number of chunks
+    const size_t size = 9 * 1024 * 1024 + 1234;
+
+    char path[] = "/tmp/uda_test_bytes_XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE( fd >= 0 );
+
+    // Remove the file however the test case ends, including on a failed REQUIRE
+    struct RemoveFile {
+        const char* path;
+        ~RemoveFile() { remove(path); }
+    } remove_file{ path };
+
+    std::vector<unsigned char> bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = (unsigned char)((i * 131 + (i >> 8)) & 0xFF);
+    }
+    REQUIRE( write(fd, bytes.data(), size) == (ssize_t)size );
+    close(fd);
+
+    uda::Client client;
+
+    const std::vector<std::pair<std::string, std::string>> expected = {
+            { "crc32c", "af7cdbc7" },
+            { "md5", "5fa2fc7331489d151fcb5ca4beff582a" },
+            { "sha256", "7c162cef84f2831b08f3c77ff04765c1ef9f557f8978439805aa9af51a0a9bdc" },
+            { "xxh64", "05a2f95c39b89195" },
+    };
+
+    for (const auto& checksum : expected) {
+        std::string request = std::string("BYTES::read(path=") + path + ", checksum=" + checksum.first + ")";
+
+        const uda::Result& result = client.get(request, "");
+
+        REQUIRE( result.errorCode() == 0 );
+        REQUIRE( result.label() == checksum.first );
+        REQUIRE( result.description() == checksum.second );
+
+        auto arr = dynamic_cast<uda::Array*>(result.data());
+
+        REQUIRE( arr != NULL );
+        REQUIRE( arr->size() == size );
+    }
+}
@@ -0,0 +1,103 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include <client2/async_client.hpp>
+
+namespace {
+
+/**
+ * Point new clients at a local port with no server listening, failing each connection at the first attempt.
+ */
+void no_server()
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE( fd >= 0 );
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    REQUIRE( bind(fd, (sockaddr*)&address, sizeof(address)) == 0 );
+
+    socklen_t length = sizeof(address);
+    REQUIRE( getsockname(fd, (sockaddr*)&address, &length) == 0 );
+    close(fd);      // Nothing listens on the port from now on
+
+    setenv("UDA_HOST", "localhost", 1);
+    setenv("UDA_PORT", std::to_string(ntohs(address.sin_port)).c_str(), 1);
+    setenv("UDA_MAX_SOCKET_ATTEMPTS", "0", 1);
+    setenv("UDA_MAX_SOCKET_DELAY", "0", 1);
+}
+
+} // anon namespace
+
+TEST_CASE( "A request without a server completes with an exception", "[async]" )
+{
+    no_server();
+    uda::client::AsyncClient client(2);
+
+    auto future = client.get_async("BYTES::help()", "");
+
+    REQUIRE_THROWS_AS( future.get(), std::runtime_error );
+}
+
+TEST_CASE( "The callback of a request without a server is passed the error", "[async]" )
+{
+    no_server();
+    uda::client::AsyncClient client(1);
+
+    std::promise<bool> failed;
+    client.get_async("BYTES::help()", "", [&failed](std::exception_ptr error, uda::client::AsyncResult result) {
+        failed.set_value(error != nullptr);
+    });
+
+    REQUIRE( failed.get_future().get() );
+}
+
+TEST_CASE( "wait_any and wait_all return once requests complete", "[async]" )
+{
+    no_server();
+    uda::client::AsyncClient client(3);
+
+    const size_t count = 8;
+    std::vector<std::future<uda::client::AsyncResult>> futures;
+    for (size_t i = 0; i < count; ++i) {
+        futures.push_back(client.get_async("BYTES::help()", ""));
+    }
+
+    // Each call returns a ready future, until none is left to wait for
+    size_t completed = 0;
+    while (true) {
+        size_t index = client.wait_any(futures);
+        if (index == futures.size()) {
+            break;
+        }
+        REQUIRE( index < count );
+        REQUIRE( futures[index].wait_for(std::chrono::seconds(0)) == std::future_status::ready );
+        REQUIRE_THROWS_AS( futures[index].get(), std::runtime_error );        // Invalidates the future
+        ++completed;
+    }
+    REQUIRE( completed == count );
+
+    futures.clear();
+    for (size_t i = 0; i < count; ++i) {
+        futures.push_back(client.get_async("BYTES::help()", ""));
+    }
+
+    client.wait_all(futures);
+
+    for (auto& future : futures) {
+        REQUIRE( future.wait_for(std::chrono::seconds(0)) == std::future_status::ready );
+        REQUIRE_THROWS_AS( future.get(), std::runtime_error );
+    }
+}
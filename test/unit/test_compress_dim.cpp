@@ -0,0 +1,159 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <clientserver/compressDim.h>
+#include <clientserver/initStructs.h>
+#include <clientserver/udaTypes.h>
+
+namespace {
+
+template <typename T>
+DIMS make_dim(const std::vector<T>& values, int data_type)
+{
+    DIMS dim;
+    initDimBlock(&dim);
+    dim.data_type = data_type;
+    dim.dim_n = (int)values.size();
+    dim.dim = (char*)malloc(values.size() * sizeof(T));
+    memcpy(dim.dim, values.data(), values.size() * sizeof(T));
+    return dim;
+}
+
+void free_dim(DIMS* dim)
+{
+    free(dim->dim);
+    free(dim->sams);
+    free(dim->offs);
+    free(dim->ints);
+}
+
+/**
+ * Compress the dimension, drop the original values as a transfer does and decompress: returns the values rebuilt.
+ */
+template <typename T>
+std::vector<T> round_trip(DIMS* dim, int expected_method)
+{
+    REQUIRE( compressDim(dim) == 0 );
+    REQUIRE( dim->compressed == 1 );
+    REQUIRE( dim->method == expected_method );
+
+    free(dim->dim);
+    dim->dim = nullptr;
+
+    REQUIRE( uncompressDim(dim) == 0 );
+    REQUIRE( dim->dim != nullptr );
+
+    auto values = (T*)dim->dim;
+    return std::vector<T>(values, values + dim->dim_n);
+}
+
+} // anon namespace
+
+TEST_CASE( "A timebase with a gap is compressed into two domains", "[compress]" )
+{
+    std::vector<double> values;
+    for (int i = 0; i < 20; ++i) {
+        values.push_back(0.125 * i);
+    }
+    for (int i = 0; i < 20; ++i) {
+        values.push_back(10.0 + 0.125 * i);
+    }
+
+    DIMS dim = make_dim(values, UDA_TYPE_DOUBLE);
+    auto result = round_trip<double>(&dim, 1);
+
+    REQUIRE( dim.udoms == 2 );
+    REQUIRE( dim.sams[0] == 20 );
+    REQUIRE( dim.sams[1] == 20 );
+
+    REQUIRE( result.size() == values.size() );
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE( result[i] == Approx(values[i]) );
+    }
+
+    free_dim(&dim);
+}
+
+TEST_CASE( "A change of sampling rate starts a new domain", "[compress]" )
+{
+    std::vector<float> values;
+    for (int i = 0; i < 30; ++i) {
+        values.push_back(1.0f * (float)i);
+    }
+    for (int i = 1; i <= 30; ++i) {
+        values.push_back(29.0f + 0.25f * (float)i);
+    }
+
+    DIMS dim = make_dim(values, UDA_TYPE_FLOAT);
+    auto result = round_trip<float>(&dim, 1);
+
+    REQUIRE( dim.udoms == 2 );
+    REQUIRE( dim.sams[0] == 30 );
+    REQUIRE( dim.sams[1] == 30 );
+
+    REQUIRE( result.size() == values.size() );
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE( result[i] == Approx(values[i]) );
+    }
+
+    free_dim(&dim);
+}
+
+TEST_CASE( "Integer domains that wrap around are rebuilt exactly", "[compress]" )
+{
+    // The second domain steps through UINT_MAX back to 0: its increment must be the exact difference, not an average
+    std::vector<unsigned int> values;
+    for (unsigned int i = 0; i < 20; ++i) {
+        values.push_back(i);
+    }
+    for (unsigned int i = 0; i < 20; ++i) {
+        values.push_back(UINT_MAX - 29 + 3 * i);
+    }
+
+    DIMS dim = make_dim(values, UDA_TYPE_UNSIGNED_INT);
+    auto result = round_trip<unsigned int>(&dim, 1);
+
+    REQUIRE( dim.udoms == 2 );
+    REQUIRE( result == values );
+
+    free_dim(&dim);
+
+    // A single wrapping domain uses the naive method with the same exact increment
+    std::vector<unsigned char> bytes;
+    for (int i = 0; i < 40; ++i) {
+        bytes.push_back((unsigned char)(200 + 7 * i));
+    }
+
+    dim = make_dim(bytes, UDA_TYPE_UNSIGNED_CHAR);
+    REQUIRE( round_trip<unsigned char>(&dim, 0) == bytes );
+
+    free_dim(&dim);
+}
+
+TEST_CASE( "Irregular data is left uncompressed when domains are not worthwhile", "[compress]" )
+{
+    std::vector<double> values;
+    double value = 0.0;
+    for (int i = 0; i < 40; ++i) {
+        value += 1.0 + (i % 3) + 0.5 * (i % 7);
+        values.push_back(value);
+    }
+
+    DIMS dim = make_dim(values, UDA_TYPE_DOUBLE);
+
+    REQUIRE( compressDim(&dim) == 1 );
+    REQUIRE( dim.compressed == 0 );
+    REQUIRE( dim.sams == nullptr );
+    REQUIRE( memcmp(dim.dim, values.data(), values.size() * sizeof(double)) == 0 );
+
+    // Nothing to do when uncompressing
+    REQUIRE( uncompressDim(&dim) == 0 );
+    REQUIRE( memcmp(dim.dim, values.data(), values.size() * sizeof(double)) == 0 );
+
+    free_dim(&dim);
+}
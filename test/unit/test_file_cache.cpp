@@ -0,0 +1,236 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <cache/fileCache.h>
+#include <clientserver/initStructs.h>
+#include <clientserver/udaTypes.h>
+
+namespace {
+
+constexpr int ProtocolVersion = 8;
+
+/**
+ * A fresh cache directory and index for each test, removed on exit.
+ */
+class CacheDirectory
+{
+public:
+    explicit CacheDirectory(const char* max_records)
+    {
+        char name[] = "/tmp/uda_test_cache_XXXXXX";
+        REQUIRE( mkdtemp(name) != nullptr );
+        path_ = name;
+        setenv("UDA_CACHE_DIR", path_.c_str(), 1);
+        setenv("UDA_CACHE_TABLE", "index", 1);
+        setenv("UDA_CACHE_MAXRECORDS", max_records, 1);
+    }
+
+    ~CacheDirectory()
+    {
+        for (const auto& file : files()) {
+            remove((path_ + "/" + file).c_str());
+        }
+        rmdir(path_.c_str());
+    }
+
+    // All files in the cache directory, including the index
+    std::vector<std::string> files() const
+    {
+        std::vector<std::string> names;
+        DIR* dir = opendir(path_.c_str());
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                names.push_back(name);
+            }
+        }
+        closedir(dir);
+        return names;
+    }
+
+    size_t data_files() const
+    {
+        size_t count = 0;
+        for (const auto& name : files()) {
+            count += name.size() > 6 && name.compare(name.size() - 6, 6, ".cache") == 0;
+        }
+        return count;
+    }
+
+private:
+    std::string path_;
+};
+
+REQUEST_BLOCK make_request(const std::string& signal, const std::string& source)
+{
+    REQUEST_BLOCK request_block;
+    initRequestBlock(&request_block);
+    request_block.num_requests = 1;
+    request_block.requests = (REQUEST_DATA*)malloc(sizeof(REQUEST_DATA));
+    initRequestData(request_block.requests);
+    strcpy(request_block.requests[0].signal, signal.c_str());
+    strcpy(request_block.requests[0].source, source.c_str());
+    return request_block;
+}
+
+bool write_entry(const std::string& signal, std::vector<double>& values)
+{
+    REQUEST_BLOCK request_block = make_request(signal, "12345");
+
+    DATA_BLOCK data_block;
+    initDataBlock(&data_block);
+    data_block.data_type = UDA_TYPE_DOUBLE;
+    data_block.data_n = (int)values.size();
+    data_block.data = (char*)values.data();
+
+    LOGSTRUCTLIST log_struct_list = {};
+    int rc = udaFileCacheWrite(&data_block, &request_block, nullptr, nullptr, ProtocolVersion, &log_struct_list, 0,
+                               UDA_MALLOC_SOURCE_NONE);
+    free(request_block.requests);
+    return rc == 0;
+}
+
+/**
+ * Read an entry: returns the number of values, or -1 if it is not in the cache. Values read are compared against
+ * the expected pattern and -2 returned on a mismatch.
+ */
+long read_entry(const std::string& signal, double first)
+{
+    REQUEST_BLOCK request_block = make_request(signal, "12345");
+
+    LOGSTRUCTLIST log_struct_list = {};
+    DATA_BLOCK* data_block = udaFileCacheRead(&request_block.requests[0], nullptr, nullptr, ProtocolVersion,
+                                              &log_struct_list, 0, UDA_MALLOC_SOURCE_NONE);
+    free(request_block.requests);
+    if (data_block == nullptr) {
+        return -1;
+    }
+
+    long count = (long)data_block->data_n;
+    auto values = (double*)data_block->data;
+    for (long i = 0; i < count; ++i) {
+        if (values[i] != first + (double)i) {
+            count = -2;
+            break;
+        }
+    }
+
+    free(data_block->data);
+    free(data_block);
+    return count;
+}
+
+std::vector<double> pattern(double first, size_t count)
+{
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = first + (double)i;
+    }
+    return values;
+}
+
+} // anon namespace
+
+TEST_CASE( "Entries written to the file cache are read back", "[cache]" )
+{
+    CacheDirectory cache("64");
+
+    auto values = pattern(1.0, 100);
+    REQUIRE( write_entry("signal_a", values) );
+
+    REQUIRE( read_entry("signal_a", 1.0) == 100 );
+    REQUIRE( read_entry("signal_b", 1.0) == -1 );
+
+    // Writing an entry already cached keeps the one cached file
+    REQUIRE( write_entry("signal_a", values) );
+    REQUIRE( cache.data_files() == 1 );
+}
+
+TEST_CASE( "The file cache evicts the oldest entry when the probe window is full", "[cache]" )
+{
+    // The smallest index is a single probe window of 32 slots, so every key competes for the same slots
+    CacheDirectory cache("1");
+
+    const int count = 40;
+    for (int i = 0; i < count; ++i) {
+        auto values = pattern((double)i, 10);
+        REQUIRE( write_entry("signal_" + std::to_string(i), values) );
+    }
+
+    int found = 0;
+    for (int i = 0; i < count; ++i) {
+        long n = read_entry("signal_" + std::to_string(i), (double)i);
+        REQUIRE( n != -2 );
+        found += n == 10;
+    }
+
+    REQUIRE( found == 32 );
+    REQUIRE( cache.data_files() == 32 );
+
+    // The most recent entry is never the one evicted
+    REQUIRE( read_entry("signal_" + std::to_string(count - 1), (double)(count - 1)) == 10 );
+}
+
+TEST_CASE( "Readers racing writers of the file cache only see complete entries", "[cache]" )
+{
+    CacheDirectory cache("256");
+
+    const int entries = 50;
+    const size_t size = 20000;
+
+    const int num_writers = 4;
+
+    std::atomic<int> finished{ 0 };
+    std::atomic<int> bad_reads{ 0 };
+    std::atomic<int> failed_writes{ 0 };
+
+    // Writers add the same new entries at the same time, each through its own temporary file
+    std::vector<std::thread> writers;
+    for (int t = 0; t < num_writers; ++t) {
+        writers.emplace_back([&]() {
+            for (int i = 0; i < entries; ++i) {
+                auto values = pattern((double)i, size);
+                if (!write_entry("entry_" + std::to_string(i), values)) {
+                    ++failed_writes;
+                }
+            }
+            ++finished;
+        });
+    }
+
+    std::thread reader([&]() {
+        while (finished < num_writers) {
+            for (int i = 0; i < entries; ++i) {
+                long n = read_entry("entry_" + std::to_string(i), (double)i);
+                if (n != -1 && n != (long)size) {
+                    ++bad_reads;
+                }
+            }
+        }
+    });
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    reader.join();
+
+    REQUIRE( failed_writes == 0 );
+    REQUIRE( bad_reads == 0 );
+
+    for (int i = 0; i < entries; ++i) {
+        REQUIRE( read_entry("entry_" + std::to_string(i), (double)i) == (long)size );
+    }
+
+    // Each entry is cached once and no temporary files are left behind
+    REQUIRE( cache.data_files() == (size_t)entries );
+    REQUIRE( cache.files().size() == (size_t)entries + 1 );
+}
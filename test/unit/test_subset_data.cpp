@@ -0,0 +1,186 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <clientserver/initStructs.h>
+#include <clientserver/parseXML.h>
+#include <clientserver/udaTypes.h>
+#include <server2/server_subset_data.h>
+
+namespace {
+
+struct Operation {
+    int dimid;
+    const char* operation;
+    double value;           // Bound of a comparison
+    long lower;             // Index range of a ':' operation
+    long upper;
+    long stride;
+};
+
+/**
+ * A row-major array (dimension 0 varies fastest) whose elements hold their own index, with dimensions holding their
+ * element indices.
+ */
+DATA_BLOCK make_data_block(const std::vector<int64_t>& shape)
+{
+    DATA_BLOCK data_block;
+    initDataBlock(&data_block);
+
+    data_block.rank = (unsigned int)shape.size();
+    data_block.order = -1;
+    data_block.data_type = UDA_TYPE_INT;
+    data_block.data_n = 1;
+    for (auto length : shape) {
+        data_block.data_n *= length;
+    }
+
+    auto data = (int*)malloc(data_block.data_n * sizeof(int));
+    for (int64_t i = 0; i < data_block.data_n; ++i) {
+        data[i] = (int)i;
+    }
+    data_block.data = (char*)data;
+
+    data_block.dims = (DIMS*)malloc(shape.size() * sizeof(DIMS));
+    for (size_t k = 0; k < shape.size(); ++k) {
+        DIMS* dim = &data_block.dims[k];
+        initDimBlock(dim);
+        dim->data_type = UDA_TYPE_DOUBLE;
+        dim->dim_n = shape[k];
+        auto values = (double*)malloc(shape[k] * sizeof(double));
+        for (int64_t i = 0; i < shape[k]; ++i) {
+            values[i] = (double)i;
+        }
+        dim->dim = (char*)values;
+    }
+
+    return data_block;
+}
+
+void free_data_block(DATA_BLOCK* data_block)
+{
+    for (unsigned int k = 0; k < data_block->rank; ++k) {
+        free(data_block->dims[k].dim);
+    }
+    free(data_block->dims);
+    free(data_block->data);
+}
+
+int subset(DATA_BLOCK* data_block, const std::vector<Operation>& operations)
+{
+    ACTION action;
+    initAction(&action);
+    action.actionType = UDA_SUBSET_TYPE;
+    initSubset(&action.subset);
+
+    action.subset.nbound = (int)operations.size();
+    for (size_t j = 0; j < operations.size(); ++j) {
+        const auto& operation = operations[j];
+        action.subset.dimid[j] = operation.dimid;
+        strcpy(action.subset.operation[j], operation.operation);
+        action.subset.bound[j] = operation.value;
+        if (operation.operation[0] == ':') {
+            action.subset.lbindex[j] = { true, operation.lower };
+            action.subset.ubindex[j] = { true, operation.upper };
+            action.subset.stride[j] = { true, operation.stride };
+        }
+    }
+
+    return uda::serverSubsetData(data_block, action, nullptr);
+}
+
+/**
+ * Check the subset against a naive gather of the original array: selected[k] holds the indices of the original
+ * dimension k expected in the result.
+ */
+void check_subset(const DATA_BLOCK& data_block, const std::vector<int64_t>& shape,
+                  const std::vector<std::vector<int64_t>>& selected)
+{
+    REQUIRE( data_block.rank == shape.size() );
+
+    int64_t count = 1;
+    for (size_t k = 0; k < shape.size(); ++k) {
+        REQUIRE( data_block.dims[k].dim_n == (int64_t)selected[k].size() );
+        auto values = (double*)data_block.dims[k].dim;
+        for (size_t i = 0; i < selected[k].size(); ++i) {
+            REQUIRE( values[i] == (double)selected[k][i] );
+        }
+        count *= (int64_t)selected[k].size();
+    }
+
+    REQUIRE( data_block.data_n == count );
+
+    auto data = (int*)data_block.data;
+    std::vector<size_t> position(shape.size(), 0);
+    for (int64_t i = 0; i < count; ++i) {
+        int64_t expected = 0;
+        int64_t stride = 1;
+        for (size_t k = 0; k < shape.size(); ++k) {
+            expected += selected[k][position[k]] * stride;
+            stride *= shape[k];
+        }
+        REQUIRE( data[i] == expected );
+
+        for (size_t k = 0; k < shape.size() && ++position[k] == selected[k].size(); ++k) {
+            position[k] = 0;
+        }
+    }
+}
+
+} // anon namespace
+
+TEST_CASE( "A 2-D array is subset along both dimensions in one pass", "[subset]" )
+{
+    std::vector<int64_t> shape = { 7, 5 };
+    DATA_BLOCK data_block = make_data_block(shape);
+
+    std::vector<Operation> operations = {
+            { 0, ":", 0.0, 1, 5, 2 },       // Index range with a stride: 1, 3, 5
+            { 1, "ge", 2.0, 0, 0, 0 },      // Range located on the monotonic dimension: 2, 3, 4
+            { 1, ":", 0.0, 1, 2, 1 },       // Composed with the previous selection: 3, 4
+    };
+
+    REQUIRE( subset(&data_block, operations) == 0 );
+
+    check_subset(data_block, shape, { { 1, 3, 5 }, { 3, 4 } });
+
+    free_data_block(&data_block);
+}
+
+TEST_CASE( "A 3-D array is subset with reversed, strided and composed selections", "[subset]" )
+{
+    std::vector<int64_t> shape = { 4, 6, 5 };
+    DATA_BLOCK data_block = make_data_block(shape);
+
+    std::vector<Operation> operations = {
+            { 0, "*", 0.0, 0, 0, 0 },       // Dimension 0 is not subset
+            { 2, ":", 0.0, 4, 0, 2 },       // Reversed with a stride: 4, 2, 0
+            { 1, "lt", 3.0, 0, 0, 0 },      // 0, 1, 2
+            { 1, ":", 0.0, 0, 2, 2 },       // Composed: 0, 2
+    };
+
+    REQUIRE( subset(&data_block, operations) == 0 );
+
+    check_subset(data_block, shape, { { 0, 1, 2, 3 }, { 0, 2 }, { 4, 2, 0 } });
+
+    free_data_block(&data_block);
+}
+
+TEST_CASE( "A 3-D array is subset along an inner dimension only", "[subset]" )
+{
+    std::vector<int64_t> shape = { 3, 4, 2 };
+    DATA_BLOCK data_block = make_data_block(shape);
+
+    std::vector<Operation> operations = {
+            { 1, ":", 0.0, 1, 2, 1 },
+    };
+
+    REQUIRE( subset(&data_block, operations) == 0 );
+
+    check_subset(data_block, shape, { { 0, 1, 2 }, { 1, 2 }, { 0, 1 } });
+
+    free_data_block(&data_block);
+}